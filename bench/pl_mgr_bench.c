@@ -0,0 +1,496 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Host-native benchmark of the PL_MGR detector data path
+**
+**  Notes:
+**    1. The PAYLOAD object and its data path objects are built against the
+**       stand-ins in bench/stubs. PAYLOAD_ManageData() is called with a
+**       one row execution cycle limit followed by one science writer child
+**       task pass, so each iteration processes exactly one detector row
+**       from readout to storage.
+**    2. Each storage configuration is run for the same number of rows.
+**       Throughput is reported in rows and raw detector megabytes per
+**       second, and per-row latency percentiles in microseconds.
+**    3. Science files are written to a temporary directory that is removed
+**       when the benchmark completes.
+**    4. Usage: pl_mgr_bench [row count] [parent directory]
+**    5. Besides the storage backends there are configurations for the
+**       IMG_POOL worker pool, SCI_RETAIN quota evictions and DETECTOR_REPLAY.
+**       The stand-ins don't run child tasks so each worker's task function
+**       is called once per iteration before the writer pass. The pool
+**       configuration measures the image gather, dispatch and commit path
+**       rather than concurrency. The replay capture file is recorded from
+**       the pl_sim_lib stand-in and replayed in a loop.
+**    6. Before the backends are run each SCI_CODEC codec encodes and decodes
+**       BENCH_CODEC_IMG_CNT images from the pl_sim_lib stand-in with the
+**       same previous row dictionary that SCI_FILE uses. The benchmark
+**       fails if a decoded row doesn't match the detector row.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <dirent.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "app_cfg.h"
+#include "payload.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define BENCH_DEF_ROW_CNT     20000
+#define BENCH_ROW_LEN         sizeof(((PL_SIM_LIB_DetectorRow_t *)0)->Data)
+#define BENCH_REPLAY_IMG_CNT  8    /* Images recorded in the replay capture file */
+#define BENCH_RETAIN_FILES    8    /* File quota of the retention configuration  */
+#define BENCH_CODEC_IMG_CNT   8    /* Images encoded by the codec round trip check */
+
+/* Backend fields for the storage configurations: no workers, no evictions and the simulator */
+#define BENCH_SIM  0, SCI_RETAIN_FILE_MAX, PAYLOAD_DETECTOR_SIM
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   const char *Name;
+   uint32      Sink;
+   uint16      FileFormat;
+   uint16      Codec;
+   uint16      SyncPolicy;
+   uint16      WorkerCnt;        /* IMG_POOL workers, 0 processes rows on the acquisition task */
+   uint16      RetainFileQuota;
+   uint16      DetectorSource;
+
+} BENCH_Backend_t;
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static const BENCH_Backend_t Backend[] =
+{
+   { "osal-text",      SCI_FILE_SINK_OSAL, PL_MGR_SciFileFormat_TEXT,   PL_MGR_SciFileCodec_NONE, PL_MGR_SciFileSync_NONE,  BENCH_SIM },
+   { "osal-bin",       SCI_FILE_SINK_OSAL, PL_MGR_SciFileFormat_BINARY, PL_MGR_SciFileCodec_NONE, PL_MGR_SciFileSync_NONE,  BENCH_SIM },
+   { "osal-bin-lz",    SCI_FILE_SINK_OSAL, PL_MGR_SciFileFormat_BINARY, PL_MGR_SciFileCodec_LZ,   PL_MGR_SciFileSync_NONE,  BENCH_SIM },
+   { "osal-bin-rice",  SCI_FILE_SINK_OSAL, PL_MGR_SciFileFormat_BINARY, PL_MGR_SciFileCodec_RICE, PL_MGR_SciFileSync_NONE,  BENCH_SIM },
+#if (PL_MGR_SCI_FILE_FSYNC == 1)
+   { "osal-bin-sync",  SCI_FILE_SINK_OSAL, PL_MGR_SciFileFormat_BINARY, PL_MGR_SciFileCodec_NONE, PL_MGR_SciFileSync_IMAGE, BENCH_SIM },
+#endif
+#if (PL_MGR_SCI_FILE_MMAP == 1)
+   { "mmap-text",      SCI_FILE_SINK_MMAP, PL_MGR_SciFileFormat_TEXT,   PL_MGR_SciFileCodec_NONE, PL_MGR_SciFileSync_NONE,  BENCH_SIM },
+   { "mmap-bin",       SCI_FILE_SINK_MMAP, PL_MGR_SciFileFormat_BINARY, PL_MGR_SciFileCodec_NONE, PL_MGR_SciFileSync_NONE,  BENCH_SIM },
+   { "mmap-bin-lz",    SCI_FILE_SINK_MMAP, PL_MGR_SciFileFormat_BINARY, PL_MGR_SciFileCodec_LZ,   PL_MGR_SciFileSync_NONE,  BENCH_SIM },
+   { "mmap-bin-rice",  SCI_FILE_SINK_MMAP, PL_MGR_SciFileFormat_BINARY, PL_MGR_SciFileCodec_RICE, PL_MGR_SciFileSync_NONE,  BENCH_SIM },
+#endif
+   { "pool-bin-lz",    SCI_FILE_SINK_OSAL, PL_MGR_SciFileFormat_BINARY, PL_MGR_SciFileCodec_LZ,   PL_MGR_SciFileSync_NONE,
+                       1, SCI_RETAIN_FILE_MAX, PAYLOAD_DETECTOR_SIM },
+   { "retain-bin",     SCI_FILE_SINK_OSAL, PL_MGR_SciFileFormat_BINARY, PL_MGR_SciFileCodec_NONE, PL_MGR_SciFileSync_NONE,
+                       0, BENCH_RETAIN_FILES, PAYLOAD_DETECTOR_SIM },
+   { "replay-bin",     SCI_FILE_SINK_OSAL, PL_MGR_SciFileFormat_BINARY, PL_MGR_SciFileCodec_NONE, PL_MGR_SciFileSync_NONE,
+                       0, SCI_RETAIN_FILE_MAX, PAYLOAD_DETECTOR_REPLAY },
+};
+
+static PAYLOAD_Class_t Payload;
+static INITBL_Class_t  IniTbl;
+static char            PathBase[OS_MAX_PATH_LEN];
+static char            CatalogFile[OS_MAX_PATH_LEN];
+static char            CatalogDumpFile[OS_MAX_PATH_LEN];
+static char            RetainFile[OS_MAX_PATH_LEN];
+static char            ReplayFile[OS_MAX_PATH_LEN];
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool   CheckCodec(uint16 Codec, const char *Name);
+static void   ConfigIniTbl(const BENCH_Backend_t *Config);
+static int    CompareUint64(const void *A, const void *B);
+static bool   CreatePath(char *Path, const char *Dir, const char *Filename);
+static bool   CreateReplayFile(void);
+static uint64 GetNsec(void);
+static void   RemoveDir(const char *Dir);
+static void   RunBackend(const BENCH_Backend_t *Config, uint32 RowCnt, uint64 *RowNsec);
+
+
+/******************************************************************************
+** Function: main
+**
+*/
+int main(int argc, char *argv[])
+{
+
+   uint32  RowCnt = BENCH_DEF_ROW_CNT;
+   char    Dir[OS_MAX_PATH_LEN];
+   uint64 *RowNsec;
+   uint32  i;
+   int     DirLen;
+   
+   if (argc > 1)
+   {
+      RowCnt = (uint32)strtoul(argv[1], NULL, 0);
+   }
+   DirLen = snprintf(Dir, sizeof(Dir), "%s/pl_mgr_bench_XXXXXX", (argc > 2) ? argv[2] : "/tmp");
+   
+   RowNsec = malloc(RowCnt * sizeof(uint64));
+   if (RowCnt == 0 || RowNsec == NULL || DirLen < 0 || DirLen >= (int)sizeof(Dir) || mkdtemp(Dir) == NULL)
+   {
+      fprintf(stderr, "Usage: %s [row count] [parent directory]\n", argv[0]);
+      return EXIT_FAILURE;
+   }
+   
+   if (!(CreatePath(PathBase, Dir, "sci_") &&
+         CreatePath(CatalogFile, Dir, "catalog.dat") &&
+         CreatePath(CatalogDumpFile, Dir, "catalog.txt") &&
+         CreatePath(RetainFile, Dir, "retain.dat") &&
+         CreatePath(ReplayFile, Dir, "replay.txt") &&
+         CreateReplayFile()))
+   {
+      fprintf(stderr, "Error creating the benchmark files in %s\n", Dir);
+      RemoveDir(Dir);
+      return EXIT_FAILURE;
+   }
+   
+   printf("PL_MGR data path: %d rows/image x %d bytes/row, %u rows per backend\n",
+          PL_SIM_LIB_DETECTOR_ROWS_PER_IMAGE, (int)BENCH_ROW_LEN, RowCnt);
+   
+   if (!(CheckCodec(PL_MGR_SciFileCodec_LZ, "lz") &&
+         CheckCodec(PL_MGR_SciFileCodec_RICE, "rice")))
+   {
+      RemoveDir(Dir);
+      free(RowNsec);
+      return EXIT_FAILURE;
+   }
+   
+   printf("%-14s %12s %10s %10s %10s %10s %10s %10s\n", "backend", "rows/s", "MB/s",
+          "p50 us", "p90 us", "p99 us", "p99.9 us", "max us");
+   
+   for (i = 0; i < (sizeof(Backend)/sizeof(Backend[0])); i++)
+   {
+      RunBackend(&Backend[i], RowCnt, RowNsec);
+   }
+   
+   RemoveDir(Dir);
+   free(RowNsec);
+   
+   return (BENCH_GetEventCnt(CFE_EVS_EventType_ERROR) == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+} /* End main() */
+
+
+/******************************************************************************
+** Function: CheckCodec
+**
+** Encode and decode detector rows and report the codec's compression ratio
+**
+** Notes:
+**   1. The encoded length isn't limited to the row length so every row is
+**      decoded, including rows that SCI_FILE would store unencoded.
+**
+*/
+static bool CheckCodec(uint16 Codec, const char *Name)
+{
+
+   static uint8 RowBuf[2*SCI_FILE_ROW_LEN];
+   static uint8 DecodeBuf[2*SCI_FILE_ROW_LEN];
+   static uint8 EncodeBuf[2*SCI_FILE_ROW_LEN];
+   PL_SIM_LIB_Detector_t Detector;
+   uint32 RowCnt     = 0;
+   uint32 EncodedCnt = 0;
+   uint32 DictLen;
+   uint32 EncodedLen;
+   uint16 PrevImageId = 0;
+   uint16 PrevRowIdx  = 0;
+   uint32 i;
+   bool   RetStatus  = true;
+   
+   PL_SIM_LIB_DetectorReset();
+   for (i = 0; i < (BENCH_CODEC_IMG_CNT * PL_SIM_LIB_DETECTOR_ROWS_PER_IMAGE) && RetStatus; i++)
+   {
+      
+      if (PL_SIM_LIB_ReadDetector(&Detector))
+      {
+         
+         /* The previous row is the dictionary within an image, like SCI_FILE's EncodeRow() */
+         DictLen = (RowCnt > 0 && Detector.ImageCnt == PrevImageId && Detector.ReadoutRow == (PrevRowIdx + 1)) ?
+                   SCI_FILE_ROW_LEN : 0;
+         memcpy(&RowBuf[SCI_FILE_ROW_LEN], Detector.Row.Data, SCI_FILE_ROW_LEN);
+         
+         EncodedLen = SCI_CODEC_Encode(Codec, &RowBuf[SCI_FILE_ROW_LEN - DictLen], DictLen,
+                                       SCI_FILE_ROW_LEN, EncodeBuf, sizeof(EncodeBuf));
+         memcpy(DecodeBuf, &RowBuf[SCI_FILE_ROW_LEN - DictLen], DictLen);
+         
+         RetStatus = (EncodedLen > 0 &&
+                      SCI_CODEC_Decode(Codec, EncodeBuf, EncodedLen, DecodeBuf, DictLen,
+                                       SCI_FILE_ROW_LEN) == SCI_FILE_ROW_LEN &&
+                      memcmp(&DecodeBuf[DictLen], Detector.Row.Data, SCI_FILE_ROW_LEN) == 0);
+         
+         memcpy(RowBuf, &RowBuf[SCI_FILE_ROW_LEN], SCI_FILE_ROW_LEN);
+         PrevImageId = Detector.ImageCnt;
+         PrevRowIdx  = Detector.ReadoutRow;
+         RowCnt++;
+         EncodedCnt += EncodedLen;
+         
+      }
+   }
+   
+   if (RetStatus)
+   {
+      printf("%-14s %u rows round trip, %.3f encoded/raw\n", Name, RowCnt,
+             (double)EncodedCnt / ((double)RowCnt * SCI_FILE_ROW_LEN));
+   }
+   else
+   {
+      fprintf(stderr, "%s codec round trip failed for image %u row %u\n", Name,
+              Detector.ImageCnt, Detector.ReadoutRow);
+   }
+   
+   return RetStatus;
+
+} /* End CheckCodec() */
+
+
+/******************************************************************************
+** Function: ConfigIniTbl
+**
+** Load the init file parameters used by the data path objects
+**
+*/
+static void ConfigIniTbl(const BENCH_Backend_t *Config)
+{
+
+   BENCH_SetIntConfig(CFG_ACQ_PERIOD_MS, 0);
+   BENCH_SetIntConfig(CFG_ACQ_IDLE_MS, 1);
+   BENCH_SetIntConfig(CFG_PAYLOAD_CHANNEL_CNT, 1);
+   BENCH_SetIntConfig(CFG_PAYLOAD_CYCLE_ROW_LIM, 1);
+   BENCH_SetIntConfig(CFG_PAYLOAD_CYCLE_USEC_LIM, 1000000);
+   BENCH_SetIntConfig(CFG_PAYLOAD_DETECTOR_SOURCE, Config->DetectorSource);
+   BENCH_SetIntConfig(CFG_IMG_STATS_SAT_LEVEL, 9);
+   BENCH_SetIntConfig(CFG_IMG_POOL_WORKER_CNT, Config->WorkerCnt);
+   
+   BENCH_SetStrConfig(CFG_DETECTOR_REPLAY_FILE, ReplayFile);
+   BENCH_SetIntConfig(CFG_DETECTOR_REPLAY_ROW_RATE, 0);
+   BENCH_SetIntConfig(CFG_DETECTOR_REPLAY_LOOP, 1);
+   
+   BENCH_SetStrConfig(CFG_SCI_FILE_PATH_BASE, PathBase);
+   BENCH_SetStrConfig(CFG_SCI_FILE_EXTENSION, ".dat");
+   BENCH_SetIntConfig(CFG_SCI_FILE_IMAGE_CNT, 3);
+   BENCH_SetIntConfig(CFG_SCI_FILE_FLUSH_BYTES, 4096);
+   BENCH_SetIntConfig(CFG_SCI_FILE_FORMAT, Config->FileFormat);
+   BENCH_SetIntConfig(CFG_SCI_FILE_CODEC, Config->Codec);
+   BENCH_SetIntConfig(CFG_SCI_FILE_SINK, Config->Sink);
+   BENCH_SetIntConfig(CFG_SCI_FILE_SYNC, Config->SyncPolicy);
+   BENCH_SetIntConfig(CFG_SCI_FILE_SYNC_INTERVAL, 1);
+   
+   BENCH_SetStrConfig(CFG_SCI_CATALOG_FILE, CatalogFile);
+   BENCH_SetStrConfig(CFG_SCI_CATALOG_DUMP_FILE, CatalogDumpFile);
+   BENCH_SetIntConfig(CFG_PL_MGR_CATALOG_TLM_TOPICID, 0);
+   BENCH_SetStrConfig(CFG_SCI_RETAIN_FILE, RetainFile);
+   BENCH_SetIntConfig(CFG_SCI_RETAIN_BYTE_QUOTA, 0);
+   BENCH_SetIntConfig(CFG_SCI_RETAIN_FILE_QUOTA, Config->RetainFileQuota);
+   BENCH_SetIntConfig(CFG_SCI_RETAIN_POLICY, PL_MGR_RetainPolicy_OLDEST);
+   
+   BENCH_SetIntConfig(CFG_SCI_STREAM_ENABLE, 0);
+   BENCH_SetIntConfig(CFG_SCI_STREAM_CHANNEL, 0);
+   BENCH_SetIntConfig(CFG_SCI_STREAM_ROWS_PER_PKT, 1);
+   BENCH_SetIntConfig(CFG_SCI_STREAM_DECIMATION, 1);
+   BENCH_SetIntConfig(CFG_SCI_STREAM_CYCLE_BYTE_LIM, 2048);
+
+} /* End ConfigIniTbl() */
+
+
+/******************************************************************************
+** Function: CompareUint64
+**
+*/
+static int CompareUint64(const void *A, const void *B)
+{
+
+   uint64 ValA = *(const uint64 *)A;
+   uint64 ValB = *(const uint64 *)B;
+   
+   return (ValA > ValB) - (ValA < ValB);
+
+} /* End CompareUint64() */
+
+
+/******************************************************************************
+** Function: CreatePath
+**
+** Create a path to a file in the benchmark's directory
+**
+** Notes:
+**   1. Returns false if the path doesn't fit in OS_MAX_PATH_LEN.
+**
+*/
+static bool CreatePath(char *Path, const char *Dir, const char *Filename)
+{
+
+   int PathLen = snprintf(Path, OS_MAX_PATH_LEN, "%s/%s", Dir, Filename);
+   
+   return (PathLen >= 0 && PathLen < OS_MAX_PATH_LEN);
+
+} /* End CreatePath() */
+
+
+/******************************************************************************
+** Function: CreateReplayFile
+**
+** Record BENCH_REPLAY_IMG_CNT images from the pl_sim_lib stand-in in a
+** DETECTOR_REPLAY capture file
+**
+*/
+static bool CreateReplayFile(void)
+{
+
+   FILE *File = fopen(ReplayFile, "w");
+   PL_SIM_LIB_Detector_t Detector;
+   uint32 i;
+   bool   RetStatus = false;
+   
+   if (File != NULL)
+   {
+      
+      PL_SIM_LIB_DetectorReset();
+      fprintf(File, "# PL_MGR benchmark capture\nPOWER READY\n");
+      for (i = 0; i < (BENCH_REPLAY_IMG_CNT * PL_SIM_LIB_DETECTOR_ROWS_PER_IMAGE); i++)
+      {
+         if (PL_SIM_LIB_ReadDetector(&Detector))
+         {
+            fprintf(File, "ROW %u %u %s\n", Detector.ImageCnt, Detector.ReadoutRow, Detector.Row.Data);
+         }
+      }
+      RetStatus = (fclose(File) == 0);
+   
+   }
+   
+   return RetStatus;
+
+} /* End CreateReplayFile() */
+
+
+/******************************************************************************
+** Function: GetNsec
+**
+*/
+static uint64 GetNsec(void)
+{
+
+   struct timespec Now;
+   
+   clock_gettime(CLOCK_MONOTONIC, &Now);
+   
+   return (uint64)Now.tv_sec * 1000000000ULL + (uint64)Now.tv_nsec;
+
+} /* End GetNsec() */
+
+
+/******************************************************************************
+** Function: RemoveDir
+**
+** Remove the science files and the benchmark's temporary directory
+**
+*/
+static void RemoveDir(const char *Dir)
+{
+
+   DIR *DirPtr = opendir(Dir);
+   struct dirent *Entry;
+   char  Filename[OS_MAX_PATH_LEN + sizeof(Entry->d_name) + 1];
+   
+   if (DirPtr != NULL)
+   {
+      while ((Entry = readdir(DirPtr)) != NULL)
+      {
+         if (Entry->d_name[0] != '.')
+         {
+            if (snprintf(Filename, sizeof(Filename), "%s/%s", Dir, Entry->d_name) < (int)sizeof(Filename))
+            {
+               unlink(Filename);
+            }
+         }
+      }
+      closedir(DirPtr);
+   }
+   rmdir(Dir);
+
+} /* End RemoveDir() */
+
+
+/******************************************************************************
+** Function: RunBackend
+**
+** Run one storage configuration and report its results
+**
+*/
+static void RunBackend(const BENCH_Backend_t *Config, uint32 RowCnt, uint64 *RowNsec)
+{
+
+   char   EventStr[132];
+   uint64 StartNsec;
+   uint64 RowStartNsec;
+   uint64 TotalNsec;
+   uint32 i;
+   uint16 Worker;
+   double Sec;
+   
+   ConfigIniTbl(Config);
+   PAYLOAD_Constructor(&Payload, &IniTbl);
+   PL_SIM_LIB_DetectorReset();
+   SCI_FILE_Start(&Payload.Channel[0].SciFile);
+   
+   StartNsec = GetNsec();
+   for (i = 0; i < RowCnt; i++)
+   {
+      RowStartNsec = GetNsec();
+      PAYLOAD_ManageData();
+      for (Worker = 0; Worker < Payload.ImgPool.WorkerCnt; Worker++)
+      {
+         IMG_POOL_WorkerTask(&Payload.ImgPool.Worker[Worker].ChildMgr);
+      }
+      SCI_WRITER_ChildTask(&Payload.Channel[0].SciWriter.ChildMgr);
+      RowNsec[i] = GetNsec() - RowStartNsec;
+   }
+   TotalNsec = GetNsec() - StartNsec;
+   
+   SCI_FILE_Stop(&Payload.Channel[0].SciFile, EventStr, sizeof(EventStr));
+   
+   qsort(RowNsec, RowCnt, sizeof(uint64), CompareUint64);
+   Sec = (double)TotalNsec / 1e9;
+   
+   printf("%-14s %12.0f %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f\n", Config->Name,
+          RowCnt / Sec, (RowCnt * (double)BENCH_ROW_LEN) / Sec / 1e6,
+          RowNsec[(RowCnt * 50ULL)  / 100]  / 1e3,
+          RowNsec[(RowCnt * 90ULL)  / 100]  / 1e3,
+          RowNsec[(RowCnt * 99ULL)  / 100]  / 1e3,
+          RowNsec[(RowCnt * 999ULL) / 1000] / 1e3,
+          RowNsec[RowCnt - 1] / 1e3);
+
+} /* End RunBackend() */
@@ -0,0 +1,163 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Minimal OSAL, cFE and app_c_fw stand-ins for the host benchmark
+**
+**  Notes:
+**    1. Only the declarations used by the PL_MGR data path objects are
+**       provided. The definitions are in cfs_stubs.c.
+**    2. Semaphores are no-ops because the benchmark is single threaded and
+**       CHILDMGR_Constructor() doesn't create a task.
+**
+*/
+#ifndef _app_c_fw_
+#define _app_c_fw_
+#include "common_types.h"
+#include <stdio.h>
+#include <string.h>
+/* OSAL */
+typedef uint32 osal_id_t;
+#define OS_OBJECT_ID_UNDEFINED ((osal_id_t)0)
+#define OS_MAX_PATH_LEN 64
+#define OS_MAX_API_NAME 20
+#define OS_MAX_LOCAL_PATH_LEN 128
+#define OS_SUCCESS 0
+#define OS_ERROR (-1)
+#define OS_SEM_TIMEOUT (-6)
+#define OS_FILE_FLAG_NONE 0
+#define OS_FILE_FLAG_CREATE 1
+#define OS_FILE_FLAG_TRUNCATE 2
+#define OS_READ_ONLY 0
+#define OS_WRITE_ONLY 1
+#define OS_READ_WRITE 2
+#define OS_SEEK_SET 0
+#define OS_SEEK_CUR 1
+#define OS_SEEK_END 2
+#define OS_SEM_EMPTY 0
+typedef char os_err_name_t[35];
+typedef struct { int64 ticks; } OS_time_t;
+typedef struct { uint32 FileModeBits; OS_time_t FileTime; size_t FileSize; } os_fstat_t;
+#define OS_FILESTAT_SIZE(x) ((x).FileSize)
+int32 OS_OpenCreate(osal_id_t *filedes, const char *path, int32 flags, int32 access_mode);
+int32 OS_write(osal_id_t filedes, const void *buffer, size_t nbytes);
+int32 OS_read(osal_id_t filedes, void *buffer, size_t nbytes);
+int32 OS_close(osal_id_t filedes);
+int32 OS_lseek(osal_id_t filedes, int32 offset, uint32 whence);
+int32 OS_rename(const char *old_filename, const char *new_filename);
+int32 OS_remove(const char *path);
+int32 OS_stat(const char *path, os_fstat_t *filestats);
+int32 OS_TranslatePath(const char *VirtualPath, char *LocalPath);
+int32 OS_GetErrorName(int32 error_num, os_err_name_t *err_name);
+int32 OS_MutSemCreate(osal_id_t *sem_id, const char *sem_name, uint32 options);
+int32 OS_MutSemTake(osal_id_t sem_id);
+int32 OS_MutSemGive(osal_id_t sem_id);
+int32 OS_CountSemCreate(osal_id_t *sem_id, const char *sem_name, uint32 sem_initial_value, uint32 options);
+int32 OS_CountSemGive(osal_id_t sem_id);
+int32 OS_CountSemTake(osal_id_t sem_id);
+int32 OS_CountSemTimedWait(osal_id_t sem_id, uint32 msecs);
+int32 OS_BinSemCreate(osal_id_t *sem_id, const char *sem_name, uint32 sem_initial_value, uint32 options);
+int32 OS_BinSemGive(osal_id_t sem_id);
+int32 OS_BinSemTake(osal_id_t sem_id);
+int32 OS_BinSemTimedWait(osal_id_t sem_id, uint32 msecs);
+int32 OS_TaskDelay(uint32 millisecond);
+OS_time_t OS_TimeSubtract(OS_time_t time1, OS_time_t time2);
+OS_time_t OS_TimeAdd(OS_time_t time1, OS_time_t time2);
+int64 OS_TimeGetTotalMicroseconds(OS_time_t tm);
+int64 OS_TimeGetTotalMilliseconds(OS_time_t tm);
+OS_time_t OS_TimeAssembleFromMilliseconds(int64 seconds, uint32 milliseconds);
+void CFE_PSP_GetTime(OS_time_t *LocalTime);
+void CFE_PSP_MemSet(void *p, uint8 v, uint32 n);
+void CFE_PSP_MemCpy(void *d, const void *s, uint32 n);
+/* CFE */
+#define CFE_SUCCESS 0
+typedef uint32 CFE_SB_MsgId_t;
+typedef osal_id_t CFE_SB_PipeId_t;
+typedef struct { uint8 Bytes[8]; } CFE_MSG_Message_t;
+typedef struct { CFE_MSG_Message_t Msg; uint8 Sec[8]; } CFE_MSG_CommandHeader_t;
+typedef struct { CFE_MSG_Message_t Msg; uint8 Sec[8]; } CFE_MSG_TelemetryHeader_t;
+typedef union { CFE_MSG_Message_t Msg; uint64 Align; } CFE_SB_Buffer_t;
+#define CFE_MSG_PTR(shdr) (&((shdr).Msg))
+#define CFE_SB_INVALID_MSG_ID ((CFE_SB_MsgId_t)0)
+#define CFE_SB_PEND_FOREVER (-1)
+#define CFE_SB_POLL 0
+#define CFE_SB_NO_MESSAGE ((int32)0xca00000e)
+#define CFE_SB_TIME_OUT ((int32)0xca000001)
+CFE_SB_MsgId_t CFE_SB_ValueToMsgId(uint32 v);
+uint32 CFE_SB_MsgIdToValue(CFE_SB_MsgId_t m);
+bool CFE_SB_MsgId_Equal(CFE_SB_MsgId_t a, CFE_SB_MsgId_t b);
+int32 CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16 Depth, const char *PipeName);
+int32 CFE_SB_Subscribe(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId);
+int32 CFE_SB_ReceiveBuffer(CFE_SB_Buffer_t **BufPtr, CFE_SB_PipeId_t PipeId, int32 TimeOut);
+int32 CFE_SB_TransmitMsg(const CFE_MSG_Message_t *MsgPtr, bool IncrementSequenceCount);
+void  CFE_SB_TimeStampMsg(CFE_MSG_Message_t *MsgPtr);
+CFE_SB_Buffer_t *CFE_SB_AllocateMessageBuffer(size_t MsgSize);
+int32 CFE_SB_ReleaseMessageBuffer(CFE_SB_Buffer_t *BufPtr);
+int32 CFE_SB_TransmitBuffer(CFE_SB_Buffer_t *BufPtr, bool IncrementSequenceCount);
+int32 CFE_MSG_Init(CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t MsgId, size_t Size);
+typedef size_t CFE_MSG_Size_t;
+int32 CFE_MSG_SetSize(CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t Size);
+int32 CFE_MSG_GetMsgId(const CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t *MsgId);
+typedef enum { CFE_EVS_EventType_DEBUG=1, CFE_EVS_EventType_INFORMATION=2, CFE_EVS_EventType_ERROR=3, CFE_EVS_EventType_CRITICAL=4 } CFE_EVS_EventType_Enum_t;
+#define CFE_EVS_DEBUG CFE_EVS_EventType_DEBUG
+#define CFE_EVS_NO_FILTER 0
+int32 CFE_EVS_SendEvent(uint16 EventID, uint16 EventType, const char *Spec, ...) __attribute__((format(printf,3,4)));
+int32 CFE_EVS_Register(const void *Filters, uint16 NumFilteredEvents, uint16 FilterScheme);
+#define CFE_ES_RunStatus_APP_RUN 1
+#define CFE_ES_RunStatus_APP_EXIT 2
+#define CFE_ES_RunStatus_APP_ERROR 3
+bool CFE_ES_RunLoop(uint32 *RunStatus);
+void CFE_ES_PerfLogEntry(uint32 id);
+void CFE_ES_PerfLogExit(uint32 id);
+void CFE_ES_ExitApp(uint32 ExitStatus);
+int32 CFE_ES_WriteToSysLog(const char *SpecStringPtr, ...);
+typedef uint32 CFE_ES_CDSHandle_t;
+#define CFE_ES_CDS_ALREADY_EXISTS ((int32)0x4400000d)
+int32 CFE_ES_RegisterCDS(CFE_ES_CDSHandle_t *CDSHandlePtr, size_t BlockSize, const char *Name);
+int32 CFE_ES_CopyToCDS(CFE_ES_CDSHandle_t Handle, const void *DataToCopy);
+int32 CFE_ES_RestoreFromCDS(void *RestoreToMemory, CFE_ES_CDSHandle_t Handle);
+typedef struct { uint32 Seconds; uint32 Subseconds; } CFE_TIME_SysTime_t;
+CFE_TIME_SysTime_t CFE_TIME_GetTime(void);
+/* app_c_fw */
+#define APP_C_FW_CFS_ERROR (-1)
+#define APP_C_FW_APP_BASE_EID 100
+typedef struct { const char **Str; uint16 Cnt; } INITBL_CfgEnum_t;
+typedef struct { int Dummy; } INITBL_Class_t;
+#define ENUM_VALUE(name,type) name,
+#define ENUM_STR(name,type) #name,
+#define DECLARE_ENUM(EnumType,ENUM_DEF) enum EnumType { start_of_##EnumType = 0, ENUM_DEF(ENUM_VALUE) EnumType##_count };
+#define DEFINE_ENUM(EnumType,ENUM_DEF) static const char *EnumType##Str[] = { "start", ENUM_DEF(ENUM_STR) }; static INITBL_CfgEnum_t IniCfgEnum = { EnumType##Str, EnumType##_count };
+bool INITBL_Constructor(INITBL_Class_t *IniTbl, const char *IniFile, INITBL_CfgEnum_t *CfgEnum);
+uint32 INITBL_GetIntConfig(INITBL_Class_t *IniTbl, uint16 Param);
+const char *INITBL_GetStrConfig(INITBL_Class_t *IniTbl, uint16 Param);
+typedef bool (*CMDMGR_CmdFuncPtr_t)(void *ObjDataPtr, const CFE_MSG_Message_t *MsgPtr);
+typedef struct { uint16 ValidCmdCnt; uint16 InvalidCmdCnt; } CMDMGR_Class_t;
+#define CMDMGR_PAYLOAD_PTR(MsgPtr, Type) (&((const Type *)(MsgPtr))->Payload)
+void CMDMGR_Constructor(CMDMGR_Class_t *CmdMgr);
+int32 CMDMGR_RegisterFunc(CMDMGR_Class_t *CmdMgr, uint16 FuncCode, void *ObjDataPtr, CMDMGR_CmdFuncPtr_t ObjFuncPtr, uint16 UserDataLen);
+bool CMDMGR_DispatchFunc(CMDMGR_Class_t *CmdMgr, const CFE_MSG_Message_t *MsgPtr);
+void CMDMGR_ResetStatus(CMDMGR_Class_t *CmdMgr);
+typedef struct { osal_id_t TaskId; uint16 ValidCmdCnt; uint16 InvalidCmdCnt; } CHILDMGR_Class_t;
+typedef bool (*CHILDMGR_TaskMainFuncPtr_t)(CHILDMGR_Class_t *ChildMgr);
+typedef bool (*CHILDMGR_TaskCallbackFuncPtr_t)(CHILDMGR_Class_t *ChildMgr);
+typedef struct { const char *TaskName; uint32 StackSize; uint32 Priority; uint32 PerfId; } CHILDMGR_TaskInit_t;
+int32 CHILDMGR_Constructor(CHILDMGR_Class_t *ChildMgr, CHILDMGR_TaskMainFuncPtr_t ChildTaskMainFunc, CHILDMGR_TaskCallbackFuncPtr_t AppMainCallback, CHILDMGR_TaskInit_t *TaskInit);
+bool ChildMgr_TaskMainCallback(CHILDMGR_Class_t *ChildMgr);
+
+/* Benchmark configuration, see cfs_stubs.c */
+void BENCH_SetIntConfig(uint16 Param, uint32 Value);
+void BENCH_SetStrConfig(uint16 Param, const char *Value);
+uint32 BENCH_GetEventCnt(uint16 EventType);
+
+#endif /* _app_c_fw_ */
@@ -0,0 +1,467 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the OSAL, cFE and app_c_fw stand-ins for the host benchmark
+**
+**  Notes:
+**    1. OSAL file functions map directly to POSIX calls. A file's OSAL ID
+**       is its descriptor plus one so zero remains undefined.
+**    2. OS_time_t ticks are 100 nanoseconds like OSAL. CFE_PSP_GetTime()
+**       uses the monotonic clock.
+**    3. Software bus messages are discarded after being counted. Events are
+**       counted and only errors are printed.
+**    4. INITBL parameters are set by the benchmark with BENCH_SetIntConfig()
+**       and BENCH_SetStrConfig().
+**    5. Critical Data Store blocks are kept in memory so a block registered
+**       again in the same process is restored like a cFE restart.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "app_c_fw.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define BENCH_CFG_MAX    128
+#define BENCH_CDS_MAX    8
+#define BENCH_CDS_NAME   32
+#define TICKS_PER_SEC    10000000LL
+#define TICKS_PER_USEC   10LL
+#define TICKS_PER_MSEC   10000LL
+
+#define FD_TO_ID(Fd)     ((osal_id_t)((Fd) + 1))
+#define ID_TO_FD(Id)     ((int)(Id) - 1)
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static uint32      IntCfg[BENCH_CFG_MAX];
+static const char *StrCfg[BENCH_CFG_MAX];
+static uint32      EventCnt[CFE_EVS_EventType_CRITICAL + 1];
+static osal_id_t   NextSemId = 1;
+
+static struct
+{
+   char    Name[BENCH_CDS_NAME];
+   size_t  Size;
+   void   *Data;
+} Cds[BENCH_CDS_MAX];
+static uint32 CdsCnt = 0;
+
+
+/******************************************************************************
+** Benchmark configuration
+*/
+
+void BENCH_SetIntConfig(uint16 Param, uint32 Value)
+{
+   if (Param < BENCH_CFG_MAX)
+   {
+      IntCfg[Param] = Value;
+   }
+}
+
+void BENCH_SetStrConfig(uint16 Param, const char *Value)
+{
+   if (Param < BENCH_CFG_MAX)
+   {
+      StrCfg[Param] = Value;
+   }
+}
+
+uint32 BENCH_GetEventCnt(uint16 EventType)
+{
+   return (EventType <= CFE_EVS_EventType_CRITICAL) ? EventCnt[EventType] : 0;
+}
+
+
+/******************************************************************************
+** OSAL files
+*/
+
+int32 OS_OpenCreate(osal_id_t *filedes, const char *path, int32 flags, int32 access_mode)
+{
+
+   int32 RetStatus = OS_ERROR;
+   int   OpenFlags = (access_mode == OS_READ_ONLY)  ? O_RDONLY :
+                     (access_mode == OS_WRITE_ONLY) ? O_WRONLY : O_RDWR;
+   int   Fd;
+   
+   if (flags & OS_FILE_FLAG_CREATE)   OpenFlags |= O_CREAT;
+   if (flags & OS_FILE_FLAG_TRUNCATE) OpenFlags |= O_TRUNC;
+   
+   Fd = open(path, OpenFlags, 0644);
+   if (Fd >= 0)
+   {
+      *filedes  = FD_TO_ID(Fd);
+      RetStatus = OS_SUCCESS;
+   }
+   
+   return RetStatus;
+   
+}
+
+int32 OS_write(osal_id_t filedes, const void *buffer, size_t nbytes)
+{
+   ssize_t Len = write(ID_TO_FD(filedes), buffer, nbytes);
+   return (Len < 0) ? OS_ERROR : (int32)Len;
+}
+
+int32 OS_read(osal_id_t filedes, void *buffer, size_t nbytes)
+{
+   ssize_t Len = read(ID_TO_FD(filedes), buffer, nbytes);
+   return (Len < 0) ? OS_ERROR : (int32)Len;
+}
+
+int32 OS_close(osal_id_t filedes)
+{
+   return (close(ID_TO_FD(filedes)) == 0) ? OS_SUCCESS : OS_ERROR;
+}
+
+int32 OS_lseek(osal_id_t filedes, int32 offset, uint32 whence)
+{
+   off_t Pos = lseek(ID_TO_FD(filedes), offset, (whence == OS_SEEK_SET) ? SEEK_SET :
+                                                (whence == OS_SEEK_CUR) ? SEEK_CUR : SEEK_END);
+   return (Pos < 0) ? OS_ERROR : (int32)Pos;
+}
+
+int32 OS_rename(const char *old_filename, const char *new_filename)
+{
+   return (rename(old_filename, new_filename) == 0) ? OS_SUCCESS : OS_ERROR;
+}
+
+int32 OS_remove(const char *path)
+{
+   return (unlink(path) == 0) ? OS_SUCCESS : OS_ERROR;
+}
+
+int32 OS_stat(const char *path, os_fstat_t *filestats)
+{
+
+   int32 RetStatus = OS_ERROR;
+   struct stat Stat;
+   
+   if (stat(path, &Stat) == 0)
+   {
+      memset(filestats, 0, sizeof(os_fstat_t));
+      filestats->FileModeBits = Stat.st_mode;
+      filestats->FileSize     = Stat.st_size;
+      RetStatus = OS_SUCCESS;
+   }
+   
+   return RetStatus;
+   
+}
+
+int32 OS_TranslatePath(const char *VirtualPath, char *LocalPath)
+{
+   strncpy(LocalPath, VirtualPath, OS_MAX_LOCAL_PATH_LEN);
+   LocalPath[OS_MAX_LOCAL_PATH_LEN-1] = '\0';
+   return OS_SUCCESS;
+}
+
+int32 OS_GetErrorName(int32 error_num, os_err_name_t *err_name)
+{
+   snprintf(*err_name, sizeof(os_err_name_t), "OS_ERROR(%d)", (int)error_num);
+   return OS_SUCCESS;
+}
+
+
+/******************************************************************************
+** OSAL semaphores and tasks
+*/
+
+int32 OS_MutSemCreate(osal_id_t *sem_id, const char *sem_name, uint32 options)
+{
+   *sem_id = NextSemId++;
+   return OS_SUCCESS;
+}
+
+int32 OS_MutSemTake(osal_id_t sem_id) { return OS_SUCCESS; }
+int32 OS_MutSemGive(osal_id_t sem_id) { return OS_SUCCESS; }
+
+int32 OS_CountSemCreate(osal_id_t *sem_id, const char *sem_name, uint32 sem_initial_value, uint32 options)
+{
+   *sem_id = NextSemId++;
+   return OS_SUCCESS;
+}
+
+int32 OS_CountSemGive(osal_id_t sem_id) { return OS_SUCCESS; }
+int32 OS_CountSemTake(osal_id_t sem_id) { return OS_SUCCESS; }
+int32 OS_CountSemTimedWait(osal_id_t sem_id, uint32 msecs) { return OS_SEM_TIMEOUT; }
+
+int32 OS_BinSemCreate(osal_id_t *sem_id, const char *sem_name, uint32 sem_initial_value, uint32 options)
+{
+   *sem_id = NextSemId++;
+   return OS_SUCCESS;
+}
+
+int32 OS_BinSemGive(osal_id_t sem_id) { return OS_SUCCESS; }
+int32 OS_BinSemTake(osal_id_t sem_id) { return OS_SUCCESS; }
+int32 OS_BinSemTimedWait(osal_id_t sem_id, uint32 msecs) { return OS_SEM_TIMEOUT; }
+
+int32 OS_TaskDelay(uint32 millisecond)
+{
+   usleep(millisecond * 1000);
+   return OS_SUCCESS;
+}
+
+
+/******************************************************************************
+** OSAL and PSP time
+*/
+
+OS_time_t OS_TimeSubtract(OS_time_t time1, OS_time_t time2)
+{
+   OS_time_t Result = { time1.ticks - time2.ticks };
+   return Result;
+}
+
+OS_time_t OS_TimeAdd(OS_time_t time1, OS_time_t time2)
+{
+   OS_time_t Result = { time1.ticks + time2.ticks };
+   return Result;
+}
+
+int64 OS_TimeGetTotalMicroseconds(OS_time_t tm)
+{
+   return tm.ticks / TICKS_PER_USEC;
+}
+
+int64 OS_TimeGetTotalMilliseconds(OS_time_t tm)
+{
+   return tm.ticks / TICKS_PER_MSEC;
+}
+
+OS_time_t OS_TimeAssembleFromMilliseconds(int64 seconds, uint32 milliseconds)
+{
+   OS_time_t Result = { seconds * TICKS_PER_SEC + (int64)milliseconds * TICKS_PER_MSEC };
+   return Result;
+}
+
+void CFE_PSP_GetTime(OS_time_t *LocalTime)
+{
+   struct timespec Now;
+   clock_gettime(CLOCK_MONOTONIC, &Now);
+   LocalTime->ticks = (int64)Now.tv_sec * TICKS_PER_SEC + Now.tv_nsec / 100;
+}
+
+void CFE_PSP_MemSet(void *p, uint8 v, uint32 n)           { memset(p, v, n); }
+void CFE_PSP_MemCpy(void *d, const void *s, uint32 n)     { memcpy(d, s, n); }
+
+CFE_TIME_SysTime_t CFE_TIME_GetTime(void)
+{
+   CFE_TIME_SysTime_t SysTime;
+   struct timespec Now;
+   clock_gettime(CLOCK_REALTIME, &Now);
+   SysTime.Seconds    = (uint32)Now.tv_sec;
+   SysTime.Subseconds = (uint32)(((uint64)Now.tv_nsec << 32) / 1000000000ULL);
+   return SysTime;
+}
+
+
+/******************************************************************************
+** cFE software bus and messages
+*/
+
+CFE_SB_MsgId_t CFE_SB_ValueToMsgId(uint32 v)   { return v; }
+uint32 CFE_SB_MsgIdToValue(CFE_SB_MsgId_t m)    { return m; }
+bool CFE_SB_MsgId_Equal(CFE_SB_MsgId_t a, CFE_SB_MsgId_t b) { return a == b; }
+
+int32 CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16 Depth, const char *PipeName) { return CFE_SUCCESS; }
+int32 CFE_SB_Subscribe(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId) { return CFE_SUCCESS; }
+int32 CFE_SB_ReceiveBuffer(CFE_SB_Buffer_t **BufPtr, CFE_SB_PipeId_t PipeId, int32 TimeOut) { return CFE_SB_NO_MESSAGE; }
+int32 CFE_SB_TransmitMsg(const CFE_MSG_Message_t *MsgPtr, bool IncrementSequenceCount) { return CFE_SUCCESS; }
+void  CFE_SB_TimeStampMsg(CFE_MSG_Message_t *MsgPtr) { }
+
+CFE_SB_Buffer_t *CFE_SB_AllocateMessageBuffer(size_t MsgSize)
+{
+   return (CFE_SB_Buffer_t *)malloc(MsgSize);
+}
+
+int32 CFE_SB_ReleaseMessageBuffer(CFE_SB_Buffer_t *BufPtr)
+{
+   free(BufPtr);
+   return CFE_SUCCESS;
+}
+
+int32 CFE_SB_TransmitBuffer(CFE_SB_Buffer_t *BufPtr, bool IncrementSequenceCount)
+{
+   free(BufPtr);
+   return CFE_SUCCESS;
+}
+
+int32 CFE_MSG_Init(CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t MsgId, size_t Size)
+{
+   memset(MsgPtr, 0, Size);
+   return CFE_SUCCESS;
+}
+
+int32 CFE_MSG_SetSize(CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t Size) { return CFE_SUCCESS; }
+
+int32 CFE_MSG_GetMsgId(const CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t *MsgId)
+{
+   *MsgId = CFE_SB_INVALID_MSG_ID;
+   return CFE_SUCCESS;
+}
+
+
+/******************************************************************************
+** cFE events and executive services
+*/
+
+int32 CFE_EVS_SendEvent(uint16 EventID, uint16 EventType, const char *Spec, ...)
+{
+
+   va_list Args;
+   
+   if (EventType <= CFE_EVS_EventType_CRITICAL)
+   {
+      EventCnt[EventType]++;
+   }
+   
+   if (EventType >= CFE_EVS_EventType_ERROR)
+   {
+      va_start(Args, Spec);
+      fprintf(stderr, "Event %d: ", EventID);
+      vfprintf(stderr, Spec, Args);
+      fprintf(stderr, "\n");
+      va_end(Args);
+   }
+   
+   return CFE_SUCCESS;
+   
+}
+
+int32 CFE_EVS_Register(const void *Filters, uint16 NumFilteredEvents, uint16 FilterScheme) { return CFE_SUCCESS; }
+
+bool CFE_ES_RunLoop(uint32 *RunStatus) { return (*RunStatus == CFE_ES_RunStatus_APP_RUN); }
+void CFE_ES_PerfLogEntry(uint32 id) { }
+void CFE_ES_PerfLogExit(uint32 id)  { }
+void CFE_ES_ExitApp(uint32 ExitStatus) { exit((int)ExitStatus); }
+
+int32 CFE_ES_WriteToSysLog(const char *SpecStringPtr, ...)
+{
+
+   va_list Args;
+   
+   va_start(Args, SpecStringPtr);
+   vfprintf(stderr, SpecStringPtr, Args);
+   va_end(Args);
+   
+   return CFE_SUCCESS;
+   
+}
+
+int32 CFE_ES_RegisterCDS(CFE_ES_CDSHandle_t *CDSHandlePtr, size_t BlockSize, const char *Name)
+{
+   
+   uint32 i;
+   
+   for (i=0; i < CdsCnt; i++)
+   {
+      if (strcmp(Cds[i].Name, Name) == 0 && Cds[i].Size == BlockSize)
+      {
+         *CDSHandlePtr = i;
+         return CFE_ES_CDS_ALREADY_EXISTS;
+      }
+   }
+   
+   if (CdsCnt >= BENCH_CDS_MAX || strlen(Name) >= BENCH_CDS_NAME)
+   {
+      return OS_ERROR;
+   }
+   
+   strcpy(Cds[CdsCnt].Name, Name);
+   Cds[CdsCnt].Size = BlockSize;
+   Cds[CdsCnt].Data = calloc(1, BlockSize);
+   *CDSHandlePtr = CdsCnt++;
+   
+   return CFE_SUCCESS;
+
+}
+
+int32 CFE_ES_CopyToCDS(CFE_ES_CDSHandle_t Handle, const void *DataToCopy)
+{
+   
+   if (Handle >= CdsCnt)
+   {
+      return OS_ERROR;
+   }
+   memcpy(Cds[Handle].Data, DataToCopy, Cds[Handle].Size);
+   
+   return CFE_SUCCESS;
+
+}
+
+int32 CFE_ES_RestoreFromCDS(void *RestoreToMemory, CFE_ES_CDSHandle_t Handle)
+{
+   
+   if (Handle >= CdsCnt)
+   {
+      return OS_ERROR;
+   }
+   memcpy(RestoreToMemory, Cds[Handle].Data, Cds[Handle].Size);
+   
+   return CFE_SUCCESS;
+
+}
+
+
+/******************************************************************************
+** app_c_fw
+*/
+
+bool INITBL_Constructor(INITBL_Class_t *IniTbl, const char *IniFile, INITBL_CfgEnum_t *CfgEnum) { return true; }
+
+uint32 INITBL_GetIntConfig(INITBL_Class_t *IniTbl, uint16 Param)
+{
+   return (Param < BENCH_CFG_MAX) ? IntCfg[Param] : 0;
+}
+
+const char *INITBL_GetStrConfig(INITBL_Class_t *IniTbl, uint16 Param)
+{
+   return ((Param < BENCH_CFG_MAX) && (StrCfg[Param] != NULL)) ? StrCfg[Param] : "";
+}
+
+void CMDMGR_Constructor(CMDMGR_Class_t *CmdMgr) { memset(CmdMgr, 0, sizeof(CMDMGR_Class_t)); }
+int32 CMDMGR_RegisterFunc(CMDMGR_Class_t *CmdMgr, uint16 FuncCode, void *ObjDataPtr, CMDMGR_CmdFuncPtr_t ObjFuncPtr, uint16 UserDataLen) { return CFE_SUCCESS; }
+bool CMDMGR_DispatchFunc(CMDMGR_Class_t *CmdMgr, const CFE_MSG_Message_t *MsgPtr) { return false; }
+void CMDMGR_ResetStatus(CMDMGR_Class_t *CmdMgr) { CmdMgr->ValidCmdCnt = 0; CmdMgr->InvalidCmdCnt = 0; }
+
+int32 CHILDMGR_Constructor(CHILDMGR_Class_t *ChildMgr, CHILDMGR_TaskMainFuncPtr_t ChildTaskMainFunc,
+                           CHILDMGR_TaskCallbackFuncPtr_t AppMainCallback, CHILDMGR_TaskInit_t *TaskInit)
+{
+   memset(ChildMgr, 0, sizeof(CHILDMGR_Class_t));
+   return CFE_SUCCESS;
+}
+
+bool ChildMgr_TaskMainCallback(CHILDMGR_Class_t *ChildMgr) { return true; }
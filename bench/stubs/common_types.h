@@ -0,0 +1,12 @@
+/*
+**  Purpose:
+**    Host stand-in for the OSAL common types used by the benchmark
+*/
+#ifndef _common_types_
+#define _common_types_
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+typedef uint8_t uint8; typedef uint16_t uint16; typedef uint32_t uint32; typedef uint64_t uint64;
+typedef int8_t int8; typedef int16_t int16; typedef int32_t int32; typedef int64_t int64;
+#endif
@@ -0,0 +1,93 @@
+/*
+**  Purpose:
+**    Hand-written stand-in for the EDS generated PL_MGR types
+**
+**  Notes:
+**    1. This must be kept consistent with eds/pl_mgr.xml. Only the layout
+**       matters to the benchmark, not the exact EDS field types.
+*/
+#ifndef _pl_mgr_eds_typedefs_
+#define _pl_mgr_eds_typedefs_
+#include "app_c_fw.h"
+typedef uint8 APP_C_FW_BooleanUint8_Enum_t;
+enum { APP_C_FW_BooleanUint8_FALSE = 0, APP_C_FW_BooleanUint8_TRUE = 1 };
+typedef uint16 PL_MGR_SciFileFormat_Enum_t;
+enum { PL_MGR_SciFileFormat_TEXT = 1, PL_MGR_SciFileFormat_BINARY = 2 };
+typedef uint16 PL_MGR_SciFileCodec_Enum_t;
+enum { PL_MGR_SciFileCodec_NONE = 1, PL_MGR_SciFileCodec_LZ = 2, PL_MGR_SciFileCodec_RICE = 3 };
+typedef uint16 PL_MGR_SciFileSync_Enum_t;
+enum { PL_MGR_SciFileSync_NONE = 1, PL_MGR_SciFileSync_IMAGE = 2, PL_MGR_SciFileSync_IMAGES = 3, PL_MGR_SciFileSync_SECONDS = 4 };
+typedef struct {
+   uint16 FirstRow; uint16 RowCnt; uint16 RowStep;
+   uint16 FirstCol; uint16 ColCnt; uint16 ColStep; uint8 ColBin; uint8 Spare;
+} PL_MGR_SciRoi_t;
+typedef struct {
+   uint16 ImagesPerFile;
+   char   BasePathFilename[OS_MAX_PATH_LEN];
+   char   FileExtension[8];
+   uint16 FileFormat;
+   uint16 Codec;
+   uint16 SyncPolicy;
+   uint16 SyncInterval;
+   PL_MGR_SciRoi_t Roi;
+} PL_MGR_ConfigSciFile_Payload_t;
+typedef struct { uint16 Channel; PL_MGR_ConfigSciFile_Payload_t Config; } PL_MGR_ConfigSciFileCmd_Payload_t;
+typedef struct { CFE_MSG_CommandHeader_t CommandHeader; PL_MGR_ConfigSciFileCmd_Payload_t Payload; } PL_MGR_ConfigSciFile_t;
+typedef struct { uint16 Channel; } PL_MGR_Channel_Payload_t;
+typedef struct { CFE_MSG_CommandHeader_t CommandHeader; PL_MGR_Channel_Payload_t Payload; } PL_MGR_StartSci_t;
+typedef struct { CFE_MSG_CommandHeader_t CommandHeader; PL_MGR_Channel_Payload_t Payload; } PL_MGR_StopSci_t;
+typedef struct { CFE_MSG_CommandHeader_t CommandHeader; PL_MGR_Channel_Payload_t Payload; } PL_MGR_ResetDetector_t;
+typedef struct { CFE_MSG_CommandHeader_t CommandHeader; PL_MGR_Channel_Payload_t Payload; } PL_MGR_SendFileInfo_t;
+typedef struct {
+   uint8 PowerState; uint8 DetectorFault;
+   uint16 DetectorReadoutRow; uint16 DetectorImageCnt;
+   uint16 DetectorBadRowCnt; uint16 DetectorBadPixelCnt; uint16 DetectorBadPixelIdx;
+   uint16 CycleRowCnt; uint16 CycleRowCntMax; uint16 CycleLimitCnt; uint8 SciFileConfigPending; uint8 Spare; uint32 RowCnt;
+   uint8 SciFileOpen; uint8 SciFileImageCnt;
+   uint16 SciFileCompRatio; uint32 SciFileCodecUsec; uint32 SciFileImageCrc;
+   uint16 SciWriterQueueCnt; uint16 SciWriterQueueHwm; uint16 SciWriterOverflowCnt; uint16 SciFileSyncCnt;
+   uint32 SciFileRoiSavedBytes;
+} PL_MGR_ChannelStatus_t;
+typedef PL_MGR_ChannelStatus_t PL_MGR_ChannelStatusArray_t[4];
+typedef struct {
+   uint16 ValidCmdCnt; uint16 InvalidCmdCnt;
+   uint16 CmdPipeHwm; uint16 ExePipeHwm; uint32 ExeMissedTickCnt;
+   uint8 SciStreamEnabled; uint8 SciStreamSpare; uint16 SciStreamChannel;
+   uint16 SciStreamPktCnt; uint16 SciStreamBudgetDropCnt; uint16 SciStreamTransmitErrCnt;
+   uint16 ImgPoolWorkerCnt; uint16 ImgPoolInUseHwm; uint16 ImgPoolImageCnt; uint16 ImgPoolDropCnt;
+   uint16 RetainPolicy; uint16 RetainFileCnt; uint16 RetainFileQuota; uint16 RetainEvictCnt; uint16 RetainEvictErrCnt;
+   uint32 RetainByteCnt; uint32 RetainByteQuota; uint16 RetainSpare;
+   uint16 ChannelCnt; PL_MGR_ChannelStatusArray_t Channel;
+} PL_MGR_StatusTlm_Payload_t;
+typedef struct { CFE_MSG_TelemetryHeader_t TelemetryHeader; PL_MGR_StatusTlm_Payload_t Payload; } PL_MGR_StatusTlm_t;
+
+typedef struct { uint32 PeriodMs; uint32 CycleCnt; uint16 OverrunCnt; uint16 CycleRate; uint16 RowRate; uint16 Spare; uint32 CycleUsec; uint32 CycleUsecMax; } PL_MGR_AcqTlm_Payload_t;
+typedef struct { CFE_MSG_TelemetryHeader_t TelemetryHeader; PL_MGR_AcqTlm_Payload_t Payload; } PL_MGR_AcqTlm_t;
+typedef uint16 PL_MGR_ImageHistogram_t[10];
+typedef struct { uint16 ImageId; uint16 RowCnt; uint32 PixelCnt; uint8 Min; uint8 Max; uint16 Channel; float Mean; float Variance; uint32 SatCnt; PL_MGR_ImageHistogram_t Hist; } PL_MGR_ImageSummaryTlm_Payload_t;
+typedef struct { CFE_MSG_TelemetryHeader_t TelemetryHeader; PL_MGR_ImageSummaryTlm_Payload_t Payload; } PL_MGR_ImageSummaryTlm_t;
+typedef struct { uint16 ImageId; uint16 Flags; uint32 Offset; } PL_MGR_CatalogImage_t;
+typedef PL_MGR_CatalogImage_t PL_MGR_CatalogImageArray_t[16];
+typedef struct { uint32 Seq; uint16 Channel; uint16 FileFormat; uint16 Codec; uint16 ImageCnt; uint16 Flags; uint16 Priority; uint32 FileLen; uint32 FileCrc; char Filename[OS_MAX_PATH_LEN]; PL_MGR_CatalogImageArray_t Image; } PL_MGR_CatalogEntry_t;
+typedef struct { uint16 Channel; uint16 ImageId; } PL_MGR_QueryCatalog_Payload_t;
+typedef struct { CFE_MSG_CommandHeader_t CommandHeader; PL_MGR_QueryCatalog_Payload_t Payload; } PL_MGR_QueryCatalog_t;
+typedef struct { char Filename[OS_MAX_PATH_LEN]; } PL_MGR_DumpCatalog_Payload_t;
+typedef struct { CFE_MSG_CommandHeader_t CommandHeader; PL_MGR_DumpCatalog_Payload_t Payload; } PL_MGR_DumpCatalog_t;
+typedef uint16 PL_MGR_RetainPolicy_Enum_t;
+enum { PL_MGR_RetainPolicy_OLDEST = 1, PL_MGR_RetainPolicy_DOWNLINKED = 2, PL_MGR_RetainPolicy_PRIORITY = 3 };
+typedef struct { uint32 ByteQuota; uint16 FileQuota; uint16 Policy; } PL_MGR_ConfigRetain_Payload_t;
+typedef struct { CFE_MSG_CommandHeader_t CommandHeader; PL_MGR_ConfigRetain_Payload_t Payload; } PL_MGR_ConfigRetain_t;
+typedef struct { char Filename[OS_MAX_PATH_LEN]; uint16 Priority; uint8 Downlinked; uint8 Spare; } PL_MGR_SetFileRetain_Payload_t;
+typedef struct { CFE_MSG_CommandHeader_t CommandHeader; PL_MGR_SetFileRetain_Payload_t Payload; } PL_MGR_SetFileRetain_t;
+typedef struct { uint16 ImageIdx; uint16 Spare; PL_MGR_CatalogEntry_t Entry; } PL_MGR_CatalogTlm_Payload_t;
+typedef struct { CFE_MSG_TelemetryHeader_t TelemetryHeader; PL_MGR_CatalogTlm_Payload_t Payload; } PL_MGR_CatalogTlm_t;
+typedef struct { uint8 Enabled; uint8 Spare; uint16 RowsPerPkt; uint16 Decimation; uint16 Channel; uint32 CycleByteLim; } PL_MGR_ConfigSciStream_Payload_t;
+typedef struct { CFE_MSG_CommandHeader_t CommandHeader; PL_MGR_ConfigSciStream_Payload_t Payload; } PL_MGR_ConfigSciStream_t;
+typedef struct { uint16 ImageId; uint16 FirstRowIdx; uint16 RowStride; uint16 RowCnt; uint16 RowLen; uint16 Channel; uint8 Data[1024]; } PL_MGR_SciDataPkt_Payload_t;
+typedef struct { CFE_MSG_TelemetryHeader_t TelemetryHeader; PL_MGR_SciDataPkt_Payload_t Payload; } PL_MGR_SciDataPkt_t;
+typedef struct { uint16 Channel; uint8 FileOpen; uint8 ConfigPending; uint16 ChangeCnt; uint16 FileFormat; uint16 Codec; uint16 ImagesPerFile; char Filename[OS_MAX_PATH_LEN]; PL_MGR_ConfigSciFile_Payload_t Config; PL_MGR_ConfigSciFile_Payload_t PendingConfig; } PL_MGR_FileInfoTlm_Payload_t;
+typedef struct { CFE_MSG_TelemetryHeader_t TelemetryHeader; PL_MGR_FileInfoTlm_Payload_t Payload; } PL_MGR_FileInfoTlm_t;
+typedef struct { uint32 Cnt; uint32 MaxUsec; uint32 Hist[20]; } PL_MGR_PerfStage_t;
+typedef struct { PL_MGR_PerfStage_t ReadDetector, CheckData, WriteData, CreateFile, CloseFile, SyncFile; } PL_MGR_PerfTlm_Payload_t;
+typedef struct { CFE_MSG_TelemetryHeader_t TelemetryHeader; PL_MGR_PerfTlm_Payload_t Payload; } PL_MGR_PerfTlm_t;
+#endif /* _pl_mgr_eds_typedefs_ */
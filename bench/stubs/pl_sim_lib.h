@@ -0,0 +1,54 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Payload simulator library stand-in for the host benchmark
+**
+**  Notes:
+**    1. The image geometry is defined at build time by PL_MGR_BENCH_ROWS
+**       and PL_MGR_BENCH_ROW_LEN so one benchmark executable is built per
+**       geometry. The defaults match pl_sim_lib.
+**    2. The detector always has a row available so the benchmark measures
+**       PL_MGR and not the simulator's readout timing.
+**
+*/
+#ifndef _pl_sim_lib_
+#define _pl_sim_lib_
+
+#include "app_c_fw.h"
+
+#ifndef PL_MGR_BENCH_ROWS
+   #define PL_MGR_BENCH_ROWS     10
+#endif
+#ifndef PL_MGR_BENCH_ROW_LEN
+   #define PL_MGR_BENCH_ROW_LEN  32
+#endif
+
+#define PL_SIM_LIB_DETECTOR_ROWS_PER_IMAGE PL_MGR_BENCH_ROWS
+#define PL_SIM_LIB_DETECTOR_ROW_LEN        PL_MGR_BENCH_ROW_LEN
+
+typedef uint8 PL_SIM_LIB_Power_Enum_t;
+enum { PL_SIM_LIB_Power_OFF = 1, PL_SIM_LIB_Power_INIT = 2, PL_SIM_LIB_Power_RESET = 3, PL_SIM_LIB_Power_READY = 4 };
+
+typedef struct { char Data[PL_SIM_LIB_DETECTOR_ROW_LEN]; } PL_SIM_LIB_DetectorRow_t;
+typedef struct { uint16 ReadoutRow; uint16 ImageCnt; PL_SIM_LIB_DetectorRow_t Row; } PL_SIM_LIB_Detector_t;
+
+bool PL_SIM_LIB_ReadDetector(PL_SIM_LIB_Detector_t *Detector);
+PL_SIM_LIB_Power_Enum_t PL_SIM_LIB_ReadPowerState(void);
+const char *PL_SIM_LIB_GetPowerStateStr(PL_SIM_LIB_Power_Enum_t PowerState);
+void PL_SIM_LIB_DetectorOn(void);
+void PL_SIM_LIB_DetectorOff(void);
+void PL_SIM_LIB_DetectorReset(void);
+
+#endif /* _pl_sim_lib_ */
@@ -0,0 +1,94 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the payload simulator library stand-in
+**
+**  Notes:
+**    1. Rows are strings of decimal digits terminated in the last byte,
+**       the same character set as the simulator, so DETECTOR_MON doesn't
+**       report faults. Each pixel is a slowly varying gradient plus a
+**       little pseudo-random noise so the codecs see realistic data.
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include "pl_sim_lib.h"
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static uint16 ReadoutRow = 0;
+static uint16 ImageCnt   = 0;
+static uint32 Noise      = 0x12345678;
+
+
+/******************************************************************************
+** Function: PL_SIM_LIB_ReadDetector
+**
+*/
+bool PL_SIM_LIB_ReadDetector(PL_SIM_LIB_Detector_t *Detector)
+{
+
+   uint32 i;
+   
+   for (i = 0; i < (PL_SIM_LIB_DETECTOR_ROW_LEN - 1); i++)
+   {
+      Noise = Noise * 1664525 + 1013904223;
+      Detector->Row.Data[i] = '0' + (char)(((i / 8) + ReadoutRow + (ImageCnt & 1) + ((Noise >> 30) & 1)) % 10);
+   }
+   Detector->Row.Data[PL_SIM_LIB_DETECTOR_ROW_LEN - 1] = '\0';
+   
+   Detector->ReadoutRow = ReadoutRow;
+   Detector->ImageCnt   = ImageCnt;
+   
+   ReadoutRow++;
+   if (ReadoutRow >= PL_SIM_LIB_DETECTOR_ROWS_PER_IMAGE)
+   {
+      ReadoutRow = 0;
+      ImageCnt++;
+   }
+   
+   return true;
+
+} /* End PL_SIM_LIB_ReadDetector() */
+
+
+PL_SIM_LIB_Power_Enum_t PL_SIM_LIB_ReadPowerState(void)
+{
+   return PL_SIM_LIB_Power_READY;
+}
+
+const char *PL_SIM_LIB_GetPowerStateStr(PL_SIM_LIB_Power_Enum_t PowerState)
+{
+   return (PowerState == PL_SIM_LIB_Power_READY) ? "READY" : "NOT-READY";
+}
+
+void PL_SIM_LIB_DetectorOn(void)
+{
+   ReadoutRow = 0;
+}
+
+void PL_SIM_LIB_DetectorOff(void) { }
+
+void PL_SIM_LIB_DetectorReset(void)
+{
+   ReadoutRow = 0;
+   ImageCnt   = 0;
+}
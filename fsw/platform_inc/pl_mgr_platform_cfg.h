@@ -40,5 +40,45 @@
 #define PL_MGR_PLATFORM_REV   0
 #define PL_MGR_INI_FILENAME   "/cf/pl_mgr_ini.json"
 
+/*
+** The memory mapped science file sink uses POSIX file and memory mapping
+** services that are not abstracted by OSAL. Define as 0 for platforms that
+** don't provide them and the SCI_FILE_SINK init file selection is rejected.
+*/
+
+#ifdef __linux__
+   #define PL_MGR_SCI_FILE_MMAP  1
+#else
+   #define PL_MGR_SCI_FILE_MMAP  0
+#endif
+
+/*
+** Science file durability syncs and the truncation of resumed files use the
+** POSIX fsync() and truncate() services which are not abstracted by OSAL.
+** Define as 0 for platforms that don't provide them. SCI_FILE_SYNC policies
+** other than none are rejected and files aren't resumed after a restart.
+*/
+
+#ifdef __linux__
+   #define PL_MGR_SCI_FILE_FSYNC  1
+#else
+   #define PL_MGR_SCI_FILE_FSYNC  0
+#endif
+
+/*
+** DETECTOR_MON validates detector rows using SSE2 or AVX2 instructions when
+** the compiler targets them. Define as 0 to always use the portable
+** validator.
+*/
+
+#define PL_MGR_DETECTOR_MON_SIMD  1
+
+/*
+** Science file CRCs use the SSE4.2 crc32 instruction when the compiler
+** targets it. Define as 0 to always use the portable table implementation.
+*/
+
+#define PL_MGR_SCI_CRC_HW  1
+
 
 #endif /* _pl_mgr_platform_cfg_ */
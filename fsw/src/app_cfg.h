@@ -66,14 +66,71 @@
 #define CFG_PL_MGR_CMD_TOPICID         PL_MGR_CMD_TOPICID
 #define CFG_BC_SCH_1_HZ_TOPICID        BC_SCH_1_HZ_TOPICID
 #define CFG_PL_MGR_STATUS_TLM_TOPICID  PL_MGR_STATUS_TLM_TOPICID
+#define CFG_PL_MGR_ACQ_TLM_TOPICID     PL_MGR_ACQ_TLM_TOPICID
+#define CFG_PL_MGR_FILE_INFO_TLM_TOPICID  PL_MGR_FILE_INFO_TLM_TOPICID
+#define CFG_PL_MGR_IMAGE_SUMMARY_TLM_TOPICID  PL_MGR_IMAGE_SUMMARY_TLM_TOPICID
+#define CFG_PL_MGR_SCI_DATA_PKT_TOPICID       PL_MGR_SCI_DATA_PKT_TOPICID
+#define CFG_PL_MGR_PERF_TLM_TOPICID           PL_MGR_PERF_TLM_TOPICID
+#define CFG_PL_MGR_CATALOG_TLM_TOPICID        PL_MGR_CATALOG_TLM_TOPICID
 #define CFG_TLM_SLOW_RATE              TLM_SLOW_RATE
       
 #define CFG_CMD_PIPE_DEPTH      CMD_PIPE_DEPTH
 #define CFG_CMD_PIPE_NAME       CMD_PIPE_NAME
+#define CFG_EXE_PIPE_DEPTH      EXE_PIPE_DEPTH
+#define CFG_EXE_PIPE_NAME       EXE_PIPE_NAME
+
+#define CFG_ACQ_CHILD_NAME          ACQ_CHILD_NAME
+#define CFG_ACQ_CHILD_PERF_ID       ACQ_CHILD_PERF_ID
+#define CFG_ACQ_CHILD_STACK_SIZE    ACQ_CHILD_STACK_SIZE
+#define CFG_ACQ_CHILD_PRIORITY      ACQ_CHILD_PRIORITY
+#define CFG_ACQ_PERIOD_MS           ACQ_PERIOD_MS
+#define CFG_ACQ_IDLE_MS             ACQ_IDLE_MS
+
+#define CFG_PAYLOAD_CHANNEL_CNT     PAYLOAD_CHANNEL_CNT
+#define CFG_PAYLOAD_CYCLE_ROW_LIM   PAYLOAD_CYCLE_ROW_LIM
+#define CFG_PAYLOAD_DETECTOR_SOURCE PAYLOAD_DETECTOR_SOURCE
+
+#define CFG_DETECTOR_REPLAY_FILE      DETECTOR_REPLAY_FILE
+#define CFG_DETECTOR_REPLAY_ROW_RATE  DETECTOR_REPLAY_ROW_RATE
+#define CFG_DETECTOR_REPLAY_LOOP      DETECTOR_REPLAY_LOOP
+#define CFG_PAYLOAD_CYCLE_USEC_LIM  PAYLOAD_CYCLE_USEC_LIM
+
+#define CFG_IMG_STATS_SAT_LEVEL     IMG_STATS_SAT_LEVEL
+
+#define CFG_IMG_POOL_WORKER_CNT       IMG_POOL_WORKER_CNT
+#define CFG_IMG_POOL_CHILD_NAME       IMG_POOL_CHILD_NAME
+#define CFG_IMG_POOL_CHILD_PERF_ID    IMG_POOL_CHILD_PERF_ID
+#define CFG_IMG_POOL_CHILD_STACK_SIZE IMG_POOL_CHILD_STACK_SIZE
+#define CFG_IMG_POOL_CHILD_PRIORITY   IMG_POOL_CHILD_PRIORITY
 
 #define CFG_SCI_FILE_PATH_BASE  SCI_FILE_PATH_BASE
 #define CFG_SCI_FILE_EXTENSION  SCI_FILE_EXTENSION
 #define CFG_SCI_FILE_IMAGE_CNT  SCI_FILE_IMAGE_CNT
+#define CFG_SCI_FILE_FLUSH_BYTES SCI_FILE_FLUSH_BYTES
+#define CFG_SCI_FILE_FORMAT      SCI_FILE_FORMAT
+#define CFG_SCI_FILE_SINK        SCI_FILE_SINK
+#define CFG_SCI_FILE_CODEC       SCI_FILE_CODEC
+#define CFG_SCI_FILE_SYNC          SCI_FILE_SYNC
+#define CFG_SCI_FILE_SYNC_INTERVAL SCI_FILE_SYNC_INTERVAL
+
+#define CFG_SCI_CATALOG_FILE       SCI_CATALOG_FILE
+#define CFG_SCI_CATALOG_DUMP_FILE  SCI_CATALOG_DUMP_FILE
+
+#define CFG_SCI_RETAIN_BYTE_QUOTA  SCI_RETAIN_BYTE_QUOTA
+#define CFG_SCI_RETAIN_FILE_QUOTA  SCI_RETAIN_FILE_QUOTA
+#define CFG_SCI_RETAIN_POLICY      SCI_RETAIN_POLICY
+#define CFG_SCI_RETAIN_FILE        SCI_RETAIN_FILE
+
+#define CFG_SCI_STREAM_ENABLE         SCI_STREAM_ENABLE
+#define CFG_SCI_STREAM_CHANNEL        SCI_STREAM_CHANNEL
+#define CFG_SCI_STREAM_ROWS_PER_PKT   SCI_STREAM_ROWS_PER_PKT
+#define CFG_SCI_STREAM_DECIMATION     SCI_STREAM_DECIMATION
+#define CFG_SCI_STREAM_CYCLE_BYTE_LIM SCI_STREAM_CYCLE_BYTE_LIM
+
+#define CFG_SCI_WRITER_CHILD_NAME       SCI_WRITER_CHILD_NAME
+#define CFG_SCI_WRITER_CHILD_PERF_ID    SCI_WRITER_CHILD_PERF_ID
+#define CFG_SCI_WRITER_CHILD_STACK_SIZE SCI_WRITER_CHILD_STACK_SIZE
+#define CFG_SCI_WRITER_CHILD_PRIORITY   SCI_WRITER_CHILD_PRIORITY
 
 #define APP_CONFIG(XX) \
    XX(APP_CFE_NAME,char*) \
@@ -81,12 +138,60 @@
    XX(PL_MGR_CMD_TOPICID,uint32) \
    XX(BC_SCH_1_HZ_TOPICID,uint32) \
    XX(PL_MGR_STATUS_TLM_TOPICID,uint32) \
+   XX(PL_MGR_ACQ_TLM_TOPICID,uint32) \
+   XX(PL_MGR_FILE_INFO_TLM_TOPICID,uint32) \
+   XX(PL_MGR_IMAGE_SUMMARY_TLM_TOPICID,uint32) \
+   XX(PL_MGR_SCI_DATA_PKT_TOPICID,uint32) \
+   XX(PL_MGR_PERF_TLM_TOPICID,uint32) \
+   XX(PL_MGR_CATALOG_TLM_TOPICID,uint32) \
    XX(TLM_SLOW_RATE,uint32) \
    XX(CMD_PIPE_DEPTH,uint32) \
    XX(CMD_PIPE_NAME,char*) \
+   XX(EXE_PIPE_DEPTH,uint32) \
+   XX(EXE_PIPE_NAME,char*) \
+   XX(ACQ_CHILD_NAME,char*) \
+   XX(ACQ_CHILD_PERF_ID,uint32) \
+   XX(ACQ_CHILD_STACK_SIZE,uint32) \
+   XX(ACQ_CHILD_PRIORITY,uint32) \
+   XX(ACQ_PERIOD_MS,uint32) \
+   XX(ACQ_IDLE_MS,uint32) \
+   XX(PAYLOAD_CHANNEL_CNT,uint32) \
+   XX(PAYLOAD_CYCLE_ROW_LIM,uint32) \
+   XX(PAYLOAD_CYCLE_USEC_LIM,uint32) \
+   XX(PAYLOAD_DETECTOR_SOURCE,uint32) \
+   XX(DETECTOR_REPLAY_FILE,char*) \
+   XX(DETECTOR_REPLAY_ROW_RATE,uint32) \
+   XX(DETECTOR_REPLAY_LOOP,uint32) \
+   XX(IMG_STATS_SAT_LEVEL,uint32) \
+   XX(IMG_POOL_WORKER_CNT,uint32) \
+   XX(IMG_POOL_CHILD_NAME,char*) \
+   XX(IMG_POOL_CHILD_PERF_ID,uint32) \
+   XX(IMG_POOL_CHILD_STACK_SIZE,uint32) \
+   XX(IMG_POOL_CHILD_PRIORITY,uint32) \
    XX(SCI_FILE_PATH_BASE,char*) \
    XX(SCI_FILE_EXTENSION,char*) \
    XX(SCI_FILE_IMAGE_CNT,uint32) \
+   XX(SCI_FILE_FLUSH_BYTES,uint32) \
+   XX(SCI_FILE_FORMAT,uint32) \
+   XX(SCI_FILE_SINK,uint32) \
+   XX(SCI_FILE_CODEC,uint32) \
+   XX(SCI_FILE_SYNC,uint32) \
+   XX(SCI_FILE_SYNC_INTERVAL,uint32) \
+   XX(SCI_CATALOG_FILE,char*) \
+   XX(SCI_CATALOG_DUMP_FILE,char*) \
+   XX(SCI_RETAIN_BYTE_QUOTA,uint32) \
+   XX(SCI_RETAIN_FILE_QUOTA,uint32) \
+   XX(SCI_RETAIN_POLICY,uint32) \
+   XX(SCI_RETAIN_FILE,char*) \
+   XX(SCI_STREAM_ENABLE,uint32) \
+   XX(SCI_STREAM_CHANNEL,uint32) \
+   XX(SCI_STREAM_ROWS_PER_PKT,uint32) \
+   XX(SCI_STREAM_DECIMATION,uint32) \
+   XX(SCI_STREAM_CYCLE_BYTE_LIM,uint32) \
+   XX(SCI_WRITER_CHILD_NAME,char*) \
+   XX(SCI_WRITER_CHILD_PERF_ID,uint32) \
+   XX(SCI_WRITER_CHILD_STACK_SIZE,uint32) \
+   XX(SCI_WRITER_CHILD_PRIORITY,uint32) \
 
 DECLARE_ENUM(Config,APP_CONFIG)
 
@@ -103,6 +208,15 @@ DECLARE_ENUM(Config,APP_CONFIG)
 #define PAYLOAD_BASE_EID       (APP_C_FW_APP_BASE_EID + 20)
 #define SCI_FILE_BASE_EID      (APP_C_FW_APP_BASE_EID + 40)
 #define DETECTOR_MON_BASE_EID  (APP_C_FW_APP_BASE_EID + 50)
+#define SCI_WRITER_BASE_EID    (APP_C_FW_APP_BASE_EID + 60)
+#define SCI_MMAP_BASE_EID      (APP_C_FW_APP_BASE_EID + 70)
+#define IMG_STATS_BASE_EID     (APP_C_FW_APP_BASE_EID + 80)
+#define SCI_STREAM_BASE_EID    (APP_C_FW_APP_BASE_EID + 90)
+#define DETECTOR_REPLAY_BASE_EID (APP_C_FW_APP_BASE_EID + 100)
+#define IMG_POOL_BASE_EID      (APP_C_FW_APP_BASE_EID + 110)
+#define SCI_CATALOG_BASE_EID   (APP_C_FW_APP_BASE_EID + 120)
+#define SCI_RETAIN_BASE_EID    (APP_C_FW_APP_BASE_EID + 130)
+#define SCI_SYNC_BASE_EID      (APP_C_FW_APP_BASE_EID + 140)
 
 /*
 ** One event ID is used for all initialization debug messages. Uncomment one of
@@ -115,13 +229,119 @@ DECLARE_ENUM(Config,APP_CONFIG)
 #define PL_MGR_INIT_EVS_TYPE CFE_EVS_DEBUG
 //#define PL_MGR_INIT_EVS_TYPE CFE_EVS_INFORMATION
 
+/******************************************************************************
+** PAYLOAD Configurations
+**
+** PAYLOAD_CHANNEL_MAX is the maximum number of detector channels and must
+** match the DETECTOR_CHANNEL_MAX EDS definition. The JSON init file's
+** PAYLOAD_CHANNEL_CNT defines the number of channels that are used.
+** PAYLOAD_CYCLE_ROW_LIM_MAX is the largest PAYLOAD_CYCLE_ROW_LIM init file
+** value because cycle row counts are 16 bits.
+*/
+
+#define PAYLOAD_CHANNEL_MAX        4
+#define PAYLOAD_CYCLE_ROW_LIM_MAX  0xFFFF
+
+
+/******************************************************************************
+** Detector Pixel Configurations
+**
+** Each byte of a detector row up to its string terminator is a pixel that
+** the simulator encodes as a decimal digit character. A pixel's value is
+** its character minus DETECTOR_PIXEL_ZERO and DETECTOR_PIXEL_MAX is the
+** detector's largest value. Bytes outside of the digits are faults.
+*/
+
+#define DETECTOR_PIXEL_ZERO  '0'
+#define DETECTOR_PIXEL_MAX   9
+
+
+/******************************************************************************
+** IMG_POOL Configurations
+**
+** IMG_POOL_WORKER_MAX is the maximum number of image processing worker
+** tasks. IMG_POOL_IMAGE_CNT is the number of whole image buffers shared by
+** all of the detector channels. Each channel fills one buffer while the
+** other buffers are being processed or waiting to be written.
+*/
+
+#define IMG_POOL_WORKER_MAX     4
+#define IMG_POOL_IMAGE_CNT      8
+
+
 /******************************************************************************
 ** SCI_FILE Configurations
 **
+** SCI_FILE_WRITE_BUF_LEN defines the size of the statically allocated buffer
+** used to stage detector rows before they're written to the science file.
+** The JSON init file's SCI_FILE_FLUSH_BYTES threshold must be less than or
+** equal to this length. SCI_FILE_TMP_EXT is appended to a science file's
+** name while the file is being written. SCI_FILE_NEXT_NAME is appended to
+** the base path/filename to name the pre-opened next file. When a closed
+** file's name is already used a "_N" suffix, N from 1 to
+** SCI_FILE_NAME_SUFFIX_MAX, is inserted before its extension.
 */
 
 #define SCI_FILE_EXT_MAX_CHAR   8
 #define SCI_FILE_UNDEF_FILE     "Undefined"
+#define SCI_FILE_TMP_EXT        ".tmp"
+#define SCI_FILE_NEXT_NAME      "next"
+#define SCI_FILE_NAME_SUFFIX_MAX 99
+#define SCI_FILE_WRITE_BUF_LEN  8192
+
+
+/******************************************************************************
+** SCI_CATALOG Configurations
+**
+** SCI_CATALOG_ENTRY_CNT is the number of closed science files that are kept
+** in the catalog file and its in-memory index. Images in older files can't
+** be looked up. SCI_CATALOG_FILE_IMAGE_MAX
+** is the number of images per file that are indexed and must match the
+** CATALOG_FILE_IMAGE_MAX EDS definition. SCI_CATALOG_HASH_LEN is the number
+** of image index hash buckets and must be a power of 2.
+*/
+
+#define SCI_CATALOG_ENTRY_CNT       64
+#define SCI_CATALOG_FILE_IMAGE_MAX  16
+#define SCI_CATALOG_HASH_LEN        1024
+
+
+/******************************************************************************
+** SCI_RETAIN Configurations
+**
+** SCI_RETAIN_FILE_MAX is the number of closed science files that can be
+** tracked and it's the largest file quota. SCI_RETAIN_EVICT_LIM is the
+** maximum number of files deleted each time the science file writers are
+** idle. SCI_RETAIN_DEF_PRIORITY is a new file's retention priority.
+*/
+
+#define SCI_RETAIN_FILE_MAX       256
+#define SCI_RETAIN_EVICT_LIM      4
+#define SCI_RETAIN_DEF_PRIORITY   100
+
+
+/******************************************************************************
+** SCI_WRITER Configurations
+**
+** SCI_WRITER_QUEUE_LEN is the number of detector rows, or whole images when
+** the IMG_POOL is used, that can be queued for the science file writer child
+** task. It must be a power of 2. SCI_WRITER_REQUEST_QUEUE_LEN is the number
+** of collection commands that can be waiting for the child task and it must
+** also be a power of 2.
+*/
+
+#define SCI_WRITER_QUEUE_LEN          64
+#define SCI_WRITER_REQUEST_QUEUE_LEN  4
+
+
+/******************************************************************************
+** SCI_STREAM Configurations
+**
+** SCI_STREAM_MAX_DATA_LEN must match the SCI_STREAM_MAX_DATA_LEN EDS
+** definition. It limits the number of detector rows in a SciDataPkt.
+*/
+
+#define SCI_STREAM_MAX_DATA_LEN  1024
 
 
 #endif /* _app_cfg_ */
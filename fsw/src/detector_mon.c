@@ -18,6 +18,12 @@
 **  Notes:
 **    1. Information events are used in order to trace execution for
 **       demonstrations.
+**    2. Pixels are checked against the detector's digit alphabet with one
+**       unsigned range check of the pixel minus DETECTOR_PIXEL_ZERO. The
+**       SIMD validators perform the unsigned range check using a signed
+**       compare by biasing the values by 128. Each vector produces a bit
+**       mask of bad pixels and a bit mask of string terminators so the bad
+**       pixels at or following a terminator can be ignored.
 **
 **  References:
 **    1. OpenSatKit Object-based Application Developer's Guide
@@ -29,29 +35,32 @@
 ** Include Files:
 */
 
-#include <ctype.h>
-
 #include "app_cfg.h"
 #include "detector_mon.h"
 
+#if (PL_MGR_DETECTOR_MON_SIMD != 0) && (defined(__AVX2__) || defined(__SSE2__))
+   #include <immintrin.h>
+#endif
+
 /***********************/
 /** Macro Definitions **/
 /***********************/
 
 #define HYSTERESIS_LIM  3
 
+#define ROW_LEN  (sizeof(((PL_SIM_LIB_DetectorRow_t *)0)->Data))
 
-/**********************/
-/** Global File Data **/
-/**********************/
-
-static DETCTOR_MON_Class_t *DetectorMon = NULL;
+#define IS_BAD_PIXEL(p)  ((uint8)((p) - DETECTOR_PIXEL_ZERO) > DETECTOR_PIXEL_MAX)
 
 
 /*******************************/
 /** Local Function Prototypes **/
 /*******************************/
 
+static bool   AccumulateMask(uint32 BadMask, uint32 EndMask, uint16 PixelIdx,
+                             uint16 *BadCnt, uint16 *FirstBadIdx);
+static uint16 ValidateRow(const uint8 *Data, uint16 *FirstBadIdx);
+
 
 /******************************************************************************
 ** Function: DETECTOR_MON_Constructor
@@ -62,14 +71,15 @@ static DETCTOR_MON_Class_t *DetectorMon = NULL;
 **   1. This must be called prior to any other function.
 **
 */
-void DETECTOR_MON_Constructor(DETCTOR_MON_Class_t *DetectorMonPtr)
+void DETECTOR_MON_Constructor(DETCTOR_MON_Class_t *DetectorMon)
 {
 
-   DetectorMon = DetectorMonPtr;
+   CFE_PSP_MemSet((void*)DetectorMon, 0, sizeof(DETCTOR_MON_Class_t));
    
    DetectorMon->FaultPresent   = false;
    DetectorMon->ValidDataCnt   = 0;
    DetectorMon->InvalidDataCnt = 0;
+   DetectorMon->BadPixelIdx    = DETECTOR_MON_NO_BAD_PIXEL;
 
 } /* End DETECTOR_MON_Constructor() */
 
@@ -85,16 +95,54 @@ void DETECTOR_MON_Constructor(DETCTOR_MON_Class_t *DetectorMonPtr)
 **      PL_MGR project exercise 1.
 **
 */
-bool DETECTOR_MON_CheckData(PL_SIM_LIB_DetectorRow_t *DetectorRow)
+bool DETECTOR_MON_CheckData(DETCTOR_MON_Class_t *DetectorMon, const PL_SIM_LIB_DetectorRow_t *DetectorRow)
 {
-   // Simulation puts a character in first byte when a fault is present
-   DetectorMon->FaultPresent = isalpha(DetectorRow->Data[0]); 
+   
+   uint16 BadPixelIdx;
+   uint16 BadPixelCnt;
+   
+   // Simulation puts a character in the row when a fault is present
+   BadPixelCnt = ValidateRow((const uint8 *)DetectorRow->Data, &BadPixelIdx);
+   
+   DetectorMon->FaultPresent = (BadPixelCnt > 0);
+   if (DetectorMon->FaultPresent)
+   {
+      DetectorMon->BadRowCnt++;
+      DetectorMon->BadPixelCnt = BadPixelCnt;
+      DetectorMon->BadPixelIdx = BadPixelIdx;
+   }
 
    return !DetectorMon->FaultPresent;
    
 } /* End DETECTOR_MON_CheckData() */
 
 
+/******************************************************************************
+** Function: DETECTOR_MON_Merge
+**
+** Merge an image's row validation results into a monitor
+**
+** Notes:
+**   1. The fault status is set if any of the image's rows has a bad pixel
+**      and the bad pixel results are from the image's last row with a bad
+**      pixel.
+**
+*/
+void DETECTOR_MON_Merge(DETCTOR_MON_Class_t *DetectorMon, const DETCTOR_MON_Class_t *ImageMon)
+{
+
+   DetectorMon->FaultPresent = (ImageMon->BadRowCnt > 0);
+   
+   if (ImageMon->BadRowCnt > 0)
+   {
+      DetectorMon->BadRowCnt  += ImageMon->BadRowCnt;
+      DetectorMon->BadPixelCnt = ImageMon->BadPixelCnt;
+      DetectorMon->BadPixelIdx = ImageMon->BadPixelIdx;
+   }
+
+} /* End DETECTOR_MON_Merge() */
+
+
 /******************************************************************************
 ** Function: DETECTOR_MON_ResetStatus
 **
@@ -105,10 +153,13 @@ bool DETECTOR_MON_CheckData(PL_SIM_LIB_DetectorRow_t *DetectorRow)
 **      change the functional behavior should be reset.
 **
 */
-void DETECTOR_MON_ResetStatus(void)
+void DETECTOR_MON_ResetStatus(DETCTOR_MON_Class_t *DetectorMon)
 {
 
    DetectorMon->DetectorResetCnt = 0;
+   DetectorMon->BadRowCnt   = 0;
+   DetectorMon->BadPixelCnt = 0;
+   DetectorMon->BadPixelIdx = DETECTOR_MON_NO_BAD_PIXEL;
 
 } /* End DETECTOR_MON_ResetStatus() */
 
@@ -129,13 +180,14 @@ void DETECTOR_MON_ResetStatus(void)
 **      state of other system components.
 **
 */
-bool DETECTOR_MON_Exercise1(PL_SIM_LIB_DetectorRow_t *DetectorRow)
+bool DETECTOR_MON_Exercise1(DETCTOR_MON_Class_t *DetectorMon, const PL_SIM_LIB_DetectorRow_t *DetectorRow)
 {
    
-   bool ValidData;
+   bool   ValidData;
+   uint16 BadPixelIdx;
    
-   // Simulation puts a character in first byte when a fault is present
-   ValidData = !isalpha(DetectorRow->Data[0]); 
+   // Simulation puts a character in the row when a fault is present
+   ValidData = (ValidateRow((const uint8 *)DetectorRow->Data, &BadPixelIdx) == 0); 
 
 
    if (ValidData)
@@ -169,3 +221,114 @@ bool DETECTOR_MON_Exercise1(PL_SIM_LIB_DetectorRow_t *DetectorRow)
    
 } /* End DETECTOR_MON_Exercise1() */
 
+
+/******************************************************************************
+** Function: AccumulateMask
+**
+** Add a vector's bad pixels to the row totals
+**
+** Notes:
+**   1. Bit n of each mask is pixel PixelIdx+n. Bad pixels at or after the
+**      first terminator are ignored.
+**   2. Returns true if the vector contains a terminator.
+**
+*/
+static bool AccumulateMask(uint32 BadMask, uint32 EndMask, uint16 PixelIdx,
+                           uint16 *BadCnt, uint16 *FirstBadIdx)
+{
+   
+   if (EndMask != 0)
+   {
+      BadMask &= (1u << __builtin_ctz(EndMask)) - 1;
+   }
+   
+   if (BadMask != 0)
+   {
+      if (*BadCnt == 0)
+      {
+         *FirstBadIdx = PixelIdx + __builtin_ctz(BadMask);
+      }
+      *BadCnt += __builtin_popcount(BadMask);
+   }
+   
+   return (EndMask != 0);
+   
+} /* End AccumulateMask() */
+
+
+/******************************************************************************
+** Function: ValidateRow
+**
+** Return the number of bad pixels in a row and the index of the first one
+**
+** Notes:
+**   1. FirstBadIdx is DETECTOR_MON_NO_BAD_PIXEL if there are no bad pixels.
+**   2. See prologue notes. The vector loops stop at the first vector with a
+**      terminator and the remaining pixels are checked by the portable loop.
+**
+*/
+static uint16 ValidateRow(const uint8 *Data, uint16 *FirstBadIdx)
+{
+   
+   uint16 BadCnt = 0;
+   uint16 i = 0;
+   bool   RowEnd = false;
+   
+#if (PL_MGR_DETECTOR_MON_SIMD != 0) && defined(__AVX2__)
+   const __m256i Bias256     = _mm256_set1_epi8((char)(128 - DETECTOR_PIXEL_ZERO));
+   const __m256i Limit256    = _mm256_set1_epi8((char)(DETECTOR_PIXEL_MAX - 128));
+   const __m256i Zero256     = _mm256_setzero_si256();
+   __m256i Pixels256;
+   __m256i Biased256;
+#endif
+#if (PL_MGR_DETECTOR_MON_SIMD != 0) && defined(__SSE2__)
+   const __m128i Bias128     = _mm_set1_epi8((char)(128 - DETECTOR_PIXEL_ZERO));
+   const __m128i Limit128    = _mm_set1_epi8((char)(DETECTOR_PIXEL_MAX - 128));
+   const __m128i Zero128     = _mm_setzero_si128();
+   __m128i Pixels128;
+   __m128i Biased128;
+#endif
+
+   *FirstBadIdx = DETECTOR_MON_NO_BAD_PIXEL;
+   
+#if (PL_MGR_DETECTOR_MON_SIMD != 0) && defined(__AVX2__)
+   for (; !RowEnd && (i + 32u) <= ROW_LEN; i += 32)
+   {
+      Pixels256 = _mm256_loadu_si256((const __m256i *)&Data[i]);
+      Biased256 = _mm256_add_epi8(Pixels256, Bias256);
+      RowEnd = AccumulateMask((uint32)_mm256_movemask_epi8(_mm256_cmpgt_epi8(Biased256, Limit256)),
+                              (uint32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(Pixels256, Zero256)),
+                              i, &BadCnt, FirstBadIdx);
+   }
+#endif
+
+#if (PL_MGR_DETECTOR_MON_SIMD != 0) && defined(__SSE2__)
+   for (; !RowEnd && (i + 16u) <= ROW_LEN; i += 16)
+   {
+      Pixels128 = _mm_loadu_si128((const __m128i *)&Data[i]);
+      Biased128 = _mm_add_epi8(Pixels128, Bias128);
+      RowEnd = AccumulateMask((uint32)_mm_movemask_epi8(_mm_cmpgt_epi8(Biased128, Limit128)),
+                              (uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(Pixels128, Zero128)),
+                              i, &BadCnt, FirstBadIdx);
+   }
+#endif
+
+   for (; !RowEnd && i < ROW_LEN; i++)
+   {
+      if (Data[i] == '\0')
+      {
+         RowEnd = true;
+      }
+      else if (IS_BAD_PIXEL(Data[i]))
+      {
+         if (BadCnt == 0)
+         {
+            *FirstBadIdx = i;
+         }
+         BadCnt++;
+      }
+   }
+   
+   return BadCnt;
+   
+} /* End ValidateRow() */
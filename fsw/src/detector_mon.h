@@ -18,6 +18,19 @@
 **  Notes:
 **    1. This serves as a solution to the payload manager project coding
 **       exercise
+**    2. The simulator puts an alphabetic character in a row when a fault is
+**       present. Every pixel of a row is validated up to the row's string
+**       terminator. A pixel is invalid unless it's one of the detector's
+**       digit characters, see app_cfg.h.
+**    3. Rows are validated 16 or 32 pixels at a time using SSE2 or AVX2
+**       instructions when they are available and enabled by
+**       PL_MGR_DETECTOR_MON_SIMD in the platform configuration file.
+**       Otherwise a portable validator is used.
+**    4. There is one monitor per detector channel so the functions operate
+**       on the instance passed by the caller.
+**    5. An IMG_POOL worker checks an image's rows with its own monitor
+**       instance and the image's results are merged into the channel's
+**       monitor in image order by DETECTOR_MON_Merge().
 **
 **  References:
 **    1. OpenSatKit Object-based Application Developer's Guide
@@ -44,6 +57,8 @@
 
 #define DETECTOR_MON_DETECTED_FAULT_EID  (DETECTOR_MON_BASE_EID + 0)
 
+#define DETECTOR_MON_NO_BAD_PIXEL  0xFFFF
+
 /**********************/
 /** Type Definitions **/
 /**********************/
@@ -61,6 +76,15 @@ typedef struct
    uint16  InvalidDataCnt;
    uint16  DetectorResetCnt;
    
+   /*
+   ** Row validation results. BadPixelCnt and BadPixelIdx are from the most
+   ** recent row with a bad pixel. BadPixelIdx is the first bad pixel.
+   */
+   
+   uint16  BadRowCnt;
+   uint16  BadPixelCnt;
+   uint16  BadPixelIdx;
+   
 } DETCTOR_MON_Class_t;
 
 
@@ -79,16 +103,34 @@ typedef struct
 **      registered with the table manager.
 **
 */
-void DETECTOR_MON_Constructor(DETCTOR_MON_Class_t *DetectorMonPtr);
+void DETECTOR_MON_Constructor(DETCTOR_MON_Class_t *DetectorMon);
 
 
 /******************************************************************************
-** Function: DETECTOR_MON_ValidData
+** Function: DETECTOR_MON_CheckData
 **
 ** Check validity of a row of detector data
 **
+** Notes:
+**   1. See prologue notes for the pixel validation.
+**
+*/
+bool DETECTOR_MON_CheckData(DETCTOR_MON_Class_t *DetectorMon, const PL_SIM_LIB_DetectorRow_t *DetectorRow);
+
+
+/******************************************************************************
+** Function: DETECTOR_MON_Merge
+**
+** Merge an image's row validation results into a monitor
+**
+** Notes:
+**   1. ImageMon must only have been used to check the image's rows. See
+**      prologue notes.
+**   2. The monitor's fault status is set if any of the image's rows has a
+**      fault so a fault in a row other than the last row isn't lost.
+**
 */
-bool DETECTOR_MON_CheckData(PL_SIM_LIB_DetectorRow_t *DetectorRow);
+void DETECTOR_MON_Merge(DETCTOR_MON_Class_t *DetectorMon, const DETCTOR_MON_Class_t *ImageMon);
 
 
 /******************************************************************************
@@ -101,7 +143,7 @@ bool DETECTOR_MON_CheckData(PL_SIM_LIB_DetectorRow_t *DetectorRow);
 **      change the functional behavior should be reset.
 **
 */
-void DETECTOR_MON_ResetStatus(void);
+void DETECTOR_MON_ResetStatus(DETCTOR_MON_Class_t *DetectorMon);
 
 
 #endif /* _detector_mon_ */
@@ -0,0 +1,495 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the detector replay object
+**
+**  Notes:
+**    1. The capture file is read through a block buffer so each row costs
+**       one line parse rather than a file system call.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "app_cfg.h"
+#include "detector_replay.h"
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   const char              *Name;
+   PL_SIM_LIB_Power_Enum_t  State;
+
+} PowerStateName_t;
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static const PowerStateName_t PowerStateName[] =
+{
+   { "OFF",   PL_SIM_LIB_Power_OFF   },
+   { "INIT",  PL_SIM_LIB_Power_INIT  },
+   { "RESET", PL_SIM_LIB_Power_RESET },
+   { "READY", PL_SIM_LIB_Power_READY }
+};
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void CreateChannelFilename(char *Filename, const char *BaseFilename, uint16 Channel);
+static bool ParseLine(DETECTOR_REPLAY_Class_t *DetectorReplay);
+static void ParseRecord(DETECTOR_REPLAY_Class_t *DetectorReplay);
+static bool RowRateAvailable(DETECTOR_REPLAY_Class_t *DetectorReplay);
+static bool ReadLine(DETECTOR_REPLAY_Class_t *DetectorReplay);
+static void RestartRowRate(DETECTOR_REPLAY_Class_t *DetectorReplay);
+static bool RewindFile(DETECTOR_REPLAY_Class_t *DetectorReplay);
+
+
+/******************************************************************************
+** Function: DETECTOR_REPLAY_Constructor
+**
+*/
+void DETECTOR_REPLAY_Constructor(DETECTOR_REPLAY_Class_t *DetectorReplay, INITBL_Class_t *IniTbl, uint16 Channel)
+{
+
+   int32 SysStatus;
+   
+   CFE_PSP_MemSet((void*)DetectorReplay, 0, sizeof(DETECTOR_REPLAY_Class_t));
+
+   CreateChannelFilename(DetectorReplay->Filename, INITBL_GetStrConfig(IniTbl, CFG_DETECTOR_REPLAY_FILE), Channel);
+   DetectorReplay->RowRate = INITBL_GetIntConfig(IniTbl, CFG_DETECTOR_REPLAY_ROW_RATE);
+   DetectorReplay->Loop    = (INITBL_GetIntConfig(IniTbl, CFG_DETECTOR_REPLAY_LOOP) != 0);
+   
+   DetectorReplay->PowerState = PL_SIM_LIB_Power_OFF;
+   DetectorReplay->RecType    = DETECTOR_REPLAY_REC_NONE;
+   RestartRowRate(DetectorReplay);
+   
+   SysStatus = OS_OpenCreate(&DetectorReplay->FileHandle, DetectorReplay->Filename, 
+                             OS_FILE_FLAG_NONE, OS_READ_ONLY);
+   
+   if (SysStatus == OS_SUCCESS)
+   {
+   
+      DetectorReplay->FileOpen = true;
+      ParseRecord(DetectorReplay);
+      
+      CFE_EVS_SendEvent (DETECTOR_REPLAY_OPEN_EID, CFE_EVS_EventType_INFORMATION, 
+                         "Replaying detector capture %s at %d rows per second (0=unthrottled), loop %d",
+                         DetectorReplay->Filename, DetectorReplay->RowRate, DetectorReplay->Loop);
+   }
+   else
+   {
+      
+      CFE_EVS_SendEvent (DETECTOR_REPLAY_OPEN_EID, CFE_EVS_EventType_ERROR, 
+                         "Error opening detector capture %s. Status = %d",
+                         DetectorReplay->Filename, SysStatus);
+   }
+
+} /* End DETECTOR_REPLAY_Constructor() */
+
+
+/******************************************************************************
+** Function: DETECTOR_REPLAY_ReadDetector
+**
+*/
+bool DETECTOR_REPLAY_ReadDetector(DETECTOR_REPLAY_Class_t *DetectorReplay, PL_SIM_LIB_Detector_t *Detector)
+{
+
+   bool RetStatus = false;
+   
+   if (DetectorReplay->RecType == DETECTOR_REPLAY_REC_ROW && 
+       DetectorReplay->PowerState == PL_SIM_LIB_Power_READY)
+   {
+      
+      if (RowRateAvailable(DetectorReplay))
+      {
+         
+         *Detector = DetectorReplay->RecDetector;
+         DetectorReplay->RowCnt++;
+         DetectorReplay->RateRowCnt++;
+         ParseRecord(DetectorReplay);
+         RetStatus = true;
+      
+      }
+   }
+   
+   return RetStatus;
+
+} /* End DETECTOR_REPLAY_ReadDetector() */
+
+
+/******************************************************************************
+** Function: DETECTOR_REPLAY_ReadPowerState
+**
+** Notes:
+**   1. The row rate is restarted while the payload isn't READY so rows
+**      aren't bursted to catch up after a power state change.
+**
+*/
+PL_SIM_LIB_Power_Enum_t DETECTOR_REPLAY_ReadPowerState(DETECTOR_REPLAY_Class_t *DetectorReplay)
+{
+
+   if (DetectorReplay->HoldCnt > 0)
+   {
+      DetectorReplay->HoldCnt--;
+   }
+   else
+   {
+      if (DetectorReplay->RecType == DETECTOR_REPLAY_REC_POWER)
+      {
+         
+         DetectorReplay->PowerState = DetectorReplay->RecPowerState;
+         DetectorReplay->HoldCnt    = DetectorReplay->RecCycles - 1;
+         ParseRecord(DetectorReplay);
+      
+      }
+      else if (DetectorReplay->RecType == DETECTOR_REPLAY_REC_ROW)
+      {
+         DetectorReplay->PowerState = PL_SIM_LIB_Power_READY;
+      }
+   }
+   
+   if (DetectorReplay->PowerState != PL_SIM_LIB_Power_READY)
+   {
+      RestartRowRate(DetectorReplay);
+   }
+   
+   return DetectorReplay->PowerState;
+
+} /* End DETECTOR_REPLAY_ReadPowerState() */
+
+
+/******************************************************************************
+** Function: CreateChannelFilename
+**
+** Create a channel's capture filename from the init file's filename
+**
+** Notes:
+**   1. Channel 0 uses the init file's filename. Other channels insert
+**      "_ch<channel>" before the filename's extension.
+**
+*/
+static void CreateChannelFilename(char *Filename, const char *BaseFilename, uint16 Channel)
+{
+
+   const char *Extension = strrchr(BaseFilename, '.');
+   const char *Directory = strrchr(BaseFilename, '/');
+   int BaseLen;
+   
+   if (Channel == 0)
+   {
+      snprintf(Filename, OS_MAX_PATH_LEN, "%s", BaseFilename);
+   }
+   else
+   {
+      if (Extension == NULL || (Directory != NULL && Extension < Directory))
+      {
+         Extension = &BaseFilename[strlen(BaseFilename)];
+      }
+      BaseLen = (int)(Extension - BaseFilename);
+      snprintf(Filename, OS_MAX_PATH_LEN, "%.*s_ch%d%s", BaseLen, BaseFilename, Channel, Extension);
+   }
+
+} /* End CreateChannelFilename() */
+
+
+/******************************************************************************
+** Function: ParseLine
+**
+** Parse the current line into the pending record
+**
+** Notes:
+**   1. Returns false if the line doesn't contain a record.
+**
+*/
+static bool ParseLine(DETECTOR_REPLAY_Class_t *DetectorReplay)
+{
+
+   bool   RetStatus = false;
+   bool   ValidLine = true;
+   char  *Field = DetectorReplay->Line;
+   char   StateStr[8];
+   uint32 Cycles;
+   uint16 ImageCnt;
+   uint16 ReadoutRow;
+   int    DataOffset = 0;
+   uint32 i;
+   PL_SIM_LIB_DetectorRow_t *Row = &DetectorReplay->RecDetector.Row;
+   
+   while (*Field == ' ' || *Field == '\t')
+   {
+      Field++;
+   }
+   
+   if (strncmp(Field, "ROW", 3) == 0)
+   {
+      
+      if (sscanf(&Field[3], " %hu %hu %n", &ImageCnt, &ReadoutRow, &DataOffset) == 2)
+      {
+         
+         DetectorReplay->RecDetector.ImageCnt   = ImageCnt;
+         DetectorReplay->RecDetector.ReadoutRow = ReadoutRow;
+         memset(Row->Data, 0, sizeof(Row->Data));
+         strncpy(Row->Data, &Field[3+DataOffset], sizeof(Row->Data) - 1);
+         
+         DetectorReplay->RecType = DETECTOR_REPLAY_REC_ROW;
+         RetStatus = true;
+      
+      }
+      else
+      {
+         ValidLine = false;
+      }
+   
+   } /* End if ROW */
+   else if (strncmp(Field, "POWER", 5) == 0)
+   {
+      
+      Cycles = 1;
+      ValidLine = false;
+      if (sscanf(&Field[5], " %7s %u", StateStr, &Cycles) >= 1)
+      {
+         for (i = 0; i < (sizeof(PowerStateName)/sizeof(PowerStateName[0])); i++)
+         {
+            if (strcmp(StateStr, PowerStateName[i].Name) == 0)
+            {
+               DetectorReplay->RecPowerState = PowerStateName[i].State;
+               DetectorReplay->RecCycles     = (Cycles > 0) ? Cycles : 1;
+               DetectorReplay->RecType       = DETECTOR_REPLAY_REC_POWER;
+               ValidLine = true;
+               RetStatus = true;
+            }
+         }
+      }
+      
+   } /* End if POWER */
+   else
+   {
+      ValidLine = (*Field == '\0' || *Field == '#');
+   }
+   
+   if (!ValidLine)
+   {
+      
+      if (DetectorReplay->ParseErrCnt == 0)
+      {
+         CFE_EVS_SendEvent (DETECTOR_REPLAY_PARSE_EID, CFE_EVS_EventType_ERROR, 
+                            "Invalid record at %s line %d. Subsequent errors are not reported",
+                            DetectorReplay->Filename, DetectorReplay->LineNum);
+      }
+      DetectorReplay->ParseErrCnt++;
+   
+   }
+   
+   return RetStatus;
+
+} /* End ParseLine() */
+
+
+/******************************************************************************
+** Function: ParseRecord
+**
+** Parse the next record in the file into the pending record
+**
+** Notes:
+**   1. A file is rewound at most once per call so a file without records
+**      ends the replay.
+**
+*/
+static void ParseRecord(DETECTOR_REPLAY_Class_t *DetectorReplay)
+{
+
+   bool RecordFound = false;
+   bool Rewound     = false;
+   bool EndOfFile   = false;
+   
+   DetectorReplay->RecType = DETECTOR_REPLAY_REC_NONE;
+   
+   while (DetectorReplay->FileOpen && !RecordFound && !EndOfFile)
+   {
+      
+      if (ReadLine(DetectorReplay))
+      {
+         RecordFound = ParseLine(DetectorReplay);
+      }
+      else
+      {
+         if (DetectorReplay->Loop && !Rewound)
+         {
+            Rewound   = true;
+            EndOfFile = !RewindFile(DetectorReplay);
+         }
+         else
+         {
+            EndOfFile = true;
+         }
+      }
+      
+   } /* End while */
+   
+   if (EndOfFile)
+   {
+      
+      CFE_EVS_SendEvent (DETECTOR_REPLAY_END_EID, CFE_EVS_EventType_INFORMATION, 
+                         "Detector replay ended after %d rows with %d parse errors",
+                         DetectorReplay->RowCnt, DetectorReplay->ParseErrCnt);
+   
+   }
+
+} /* End ParseRecord() */
+
+
+/******************************************************************************
+** Function: ReadLine
+**
+** Read the next line into the line buffer
+**
+** Notes:
+**   1. Returns false at the end of the file.
+**   2. Carriage returns are removed and long lines are truncated.
+**
+*/
+static bool ReadLine(DETECTOR_REPLAY_Class_t *DetectorReplay)
+{
+
+   bool   LineRead  = false;
+   bool   EndOfLine = false;
+   uint32 LineLen   = 0;
+   int32  ReadLen;
+   char   Char;
+   
+   while (!EndOfLine)
+   {
+      
+      if (DetectorReplay->ReadBufPos >= DetectorReplay->ReadBufLen)
+      {
+         
+         ReadLen = OS_read(DetectorReplay->FileHandle, DetectorReplay->ReadBuf, DETECTOR_REPLAY_BUF_LEN);
+         DetectorReplay->ReadBufPos = 0;
+         DetectorReplay->ReadBufLen = (ReadLen > 0) ? ReadLen : 0;
+         EndOfLine = (DetectorReplay->ReadBufLen == 0);
+      
+      }
+      else
+      {
+         
+         Char = DetectorReplay->ReadBuf[DetectorReplay->ReadBufPos++];
+         LineRead = true;
+         
+         if (Char == '\n')
+         {
+            EndOfLine = true;
+         }
+         else if (Char != '\r' && LineLen < (DETECTOR_REPLAY_LINE_LEN - 1))
+         {
+            DetectorReplay->Line[LineLen++] = Char;
+         }
+      }
+      
+   } /* End while */
+   
+   DetectorReplay->Line[LineLen] = '\0';
+   if (LineRead)
+   {
+      DetectorReplay->LineNum++;
+   }
+   
+   return LineRead;
+
+} /* End ReadLine() */
+
+
+/******************************************************************************
+** Function: RestartRowRate
+**
+*/
+static void RestartRowRate(DETECTOR_REPLAY_Class_t *DetectorReplay)
+{
+
+   CFE_PSP_GetTime(&DetectorReplay->RateStartTime);
+   DetectorReplay->RateRowCnt = 0;
+
+} /* End RestartRowRate() */
+
+
+/******************************************************************************
+** Function: RewindFile
+**
+*/
+static bool RewindFile(DETECTOR_REPLAY_Class_t *DetectorReplay)
+{
+
+   bool RetStatus = false;
+   
+   if (OS_lseek(DetectorReplay->FileHandle, 0, OS_SEEK_SET) == 0)
+   {
+      
+      DetectorReplay->ReadBufLen = 0;
+      DetectorReplay->ReadBufPos = 0;
+      DetectorReplay->LineNum    = 0;
+      DetectorReplay->LoopCnt++;
+      RetStatus = true;
+   
+   }
+   
+   return RetStatus;
+
+} /* End RewindFile() */
+
+
+/******************************************************************************
+** Function: RowRateAvailable
+**
+** Return true if a row can be provided without exceeding the row rate
+**
+*/
+static bool RowRateAvailable(DETECTOR_REPLAY_Class_t *DetectorReplay)
+{
+
+   bool      RetStatus = true;
+   OS_time_t CurrentTime;
+   int64     Usec;
+   
+   if (DetectorReplay->RowRate > 0)
+   {
+      
+      CFE_PSP_GetTime(&CurrentTime);
+      Usec = OS_TimeGetTotalMicroseconds(OS_TimeSubtract(CurrentTime, DetectorReplay->RateStartTime));
+      
+      RetStatus = (((uint64)Usec * DetectorReplay->RowRate) / 1000000) >= (DetectorReplay->RateRowCnt + 1);
+   
+   }
+   
+   return RetStatus;
+
+} /* End RowRateAvailable() */
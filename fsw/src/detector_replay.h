@@ -0,0 +1,188 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the detector replay object
+**
+**  Notes:
+**    1. The replay object is an alternative detector data source to
+**       pl_sim_lib. It provides the power state and detector rows from a
+**       recorded capture file so field anomalies can be reproduced and the
+**       data path can be driven faster than the simulator.
+**    2. A capture file is text with one record per line. Blank lines and
+**       lines starting with '#' are ignored.
+**         POWER <OFF|INIT|RESET|READY> [cycles]
+**         ROW <image count> <readout row> <row data>
+**       A POWER record changes the power state and holds it for 'cycles'
+**       power state reads, default 1, before the next record is processed.
+**       Detector resets are recorded as a RESET power state. Row data is
+**       the rest of the line and is truncated to the detector row length.
+**       Fault rows are recorded with their bad pixels.
+**    3. Rows are only read in the READY power state. A ROW record that
+**       follows an expired non-READY state implies the READY state.
+**    4. The DETECTOR_REPLAY_ROW_RATE init file parameter limits the rows
+**       per second. Zero is unthrottled and rows are only limited by the
+**       payload's execution cycle limits. DETECTOR_REPLAY_LOOP restarts the
+**       replay at the end of the file, otherwise the last power state is
+**       held and no more rows are provided.
+**    5. The replay is only called by the payload's acquisition child task
+**       so it doesn't need its own mutex.
+**    6. There is one instance per replayed detector channel. Channel 0 uses
+**       the DETECTOR_REPLAY_FILE init file parameter and other channels
+**       insert "_ch<channel>" before its extension.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _detector_replay_
+#define _detector_replay_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "pl_sim_lib.h"  /* See prologue notes */
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+/*
+** Event Message IDs
+*/
+
+#define DETECTOR_REPLAY_OPEN_EID   (DETECTOR_REPLAY_BASE_EID + 0)
+#define DETECTOR_REPLAY_PARSE_EID  (DETECTOR_REPLAY_BASE_EID + 1)
+#define DETECTOR_REPLAY_END_EID    (DETECTOR_REPLAY_BASE_EID + 2)
+
+#define DETECTOR_REPLAY_LINE_LEN   (sizeof(((PL_SIM_LIB_DetectorRow_t *)0)->Data) + 32)
+#define DETECTOR_REPLAY_BUF_LEN    4096
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef enum
+{
+
+   DETECTOR_REPLAY_REC_NONE  = 0,  /* End of file */
+   DETECTOR_REPLAY_REC_POWER = 1,
+   DETECTOR_REPLAY_REC_ROW   = 2
+
+} DETECTOR_REPLAY_RecType_t;
+
+
+/******************************************************************************
+** DETECTOR_REPLAY_Class
+*/
+
+typedef struct
+{
+
+   /*
+   ** Configuration
+   */
+   
+   char    Filename[OS_MAX_PATH_LEN];
+   uint32  RowRate;
+   bool    Loop;
+   
+   /*
+   ** File state
+   */
+   
+   bool       FileOpen;
+   osal_id_t  FileHandle;
+   uint32     LineNum;
+   uint16     ReadBufLen;
+   uint16     ReadBufPos;
+   char       ReadBuf[DETECTOR_REPLAY_BUF_LEN];
+   char       Line[DETECTOR_REPLAY_LINE_LEN];
+   
+   /*
+   ** Pending record that has been parsed but not applied
+   */
+   
+   DETECTOR_REPLAY_RecType_t  RecType;
+   PL_SIM_LIB_Power_Enum_t    RecPowerState;
+   uint32                     RecCycles;
+   PL_SIM_LIB_Detector_t      RecDetector;
+   
+   /*
+   ** Replay state
+   */
+   
+   PL_SIM_LIB_Power_Enum_t  PowerState;
+   uint32     HoldCnt;
+   OS_time_t  RateStartTime;
+   uint64     RateRowCnt;
+   
+   uint32  RowCnt;
+   uint32  LoopCnt;
+   uint32  ParseErrCnt;
+
+} DETECTOR_REPLAY_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: DETECTOR_REPLAY_Constructor
+**
+** Initialize the detector replay object to a known state
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**   2. The capture file is opened and the first record is parsed. If the
+**      file can't be opened the power state is OFF.
+**
+*/
+void DETECTOR_REPLAY_Constructor(DETECTOR_REPLAY_Class_t *DetectorReplay, INITBL_Class_t *IniTbl, uint16 Channel);
+
+
+/******************************************************************************
+** Function: DETECTOR_REPLAY_ReadDetector
+**
+** Load Detector with the next detector row
+**
+** Notes:
+**   1. Returns false if a row isn't available because the next record is a
+**      power state change, the row rate limit has been reached or the
+**      replay has ended.
+**
+*/
+bool DETECTOR_REPLAY_ReadDetector(DETECTOR_REPLAY_Class_t *DetectorReplay, PL_SIM_LIB_Detector_t *Detector);
+
+
+/******************************************************************************
+** Function: DETECTOR_REPLAY_ReadPowerState
+**
+** Return the replay's power state
+**
+** Notes:
+**   1. Each call is a power state 'cycle'. See prologue notes.
+**
+*/
+PL_SIM_LIB_Power_Enum_t DETECTOR_REPLAY_ReadPowerState(DETECTOR_REPLAY_Class_t *DetectorReplay);
+
+
+#endif /* _detector_replay_ */
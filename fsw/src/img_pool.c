@@ -0,0 +1,400 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the image processing worker pool object
+**
+**  Notes:
+**    1. A counting semaphore wakes one worker for each queued image. The
+**       work queue has multiple consumers so it's protected by a mutex.
+**    2. An image's rows are written by the acquisition task before the
+**       image is queued and its results are written by a worker before
+**       its state is set to done. The mutex and the atomic state accesses
+**       order these writes with the reads by the next stage.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include "app_cfg.h"
+#include "img_pool.h"
+#include "perf_hist.h"
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static IMG_POOL_Class_t *ImgPool = NULL;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static IMG_POOL_Image_t *GetWork(void);
+static void ProcessImage(IMG_POOL_Worker_t *Worker, IMG_POOL_Image_t *Image);
+
+
+/******************************************************************************
+** Function: IMG_POOL_Constructor
+**
+*/
+void IMG_POOL_Constructor(IMG_POOL_Class_t *ImgPoolPtr, INITBL_Class_t *IniTbl)
+{
+
+   int32  SysStatus;
+   uint16 WorkerCnt;
+   uint16 i;
+   CHILDMGR_TaskInit_t ChildTaskInit;
+
+   ImgPool = ImgPoolPtr;
+
+   CFE_PSP_MemSet((void*)ImgPool, 0, sizeof(IMG_POOL_Class_t));
+
+   for (i=0; i < IMG_POOL_IMAGE_CNT; i++)
+   {
+      ImgPool->Image[i].State = IMG_POOL_IMAGE_FREE;
+   }
+
+   WorkerCnt = INITBL_GetIntConfig(IniTbl, CFG_IMG_POOL_WORKER_CNT);
+   if (WorkerCnt > IMG_POOL_WORKER_MAX)
+   {
+      CFE_EVS_SendEvent (IMG_POOL_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR,
+                         "Invalid image worker count %d, must be less than or equal to %d. Using %d workers.",
+                         WorkerCnt, IMG_POOL_WORKER_MAX, IMG_POOL_WORKER_MAX);
+      WorkerCnt = IMG_POOL_WORKER_MAX;
+   }
+
+   if (WorkerCnt > 0)
+   {
+
+      SysStatus = OS_MutSemCreate(&ImgPool->MutexId, "PL_MGR_IMGPOOL", 0);
+      if (SysStatus == OS_SUCCESS)
+      {
+         SysStatus = OS_CountSemCreate(&ImgPool->WorkSemId, "PL_MGR_IMGWORK", 0, 0);
+      }
+
+      for (i=0; (SysStatus == OS_SUCCESS) && (i < WorkerCnt); i++)
+      {
+
+         snprintf(ImgPool->Worker[i].TaskName, OS_MAX_API_NAME, "%s%d",
+                  INITBL_GetStrConfig(IniTbl, CFG_IMG_POOL_CHILD_NAME), i);
+
+         ChildTaskInit.TaskName  = ImgPool->Worker[i].TaskName;
+         ChildTaskInit.PerfId    = INITBL_GetIntConfig(IniTbl, CFG_IMG_POOL_CHILD_PERF_ID);
+         ChildTaskInit.StackSize = INITBL_GetIntConfig(IniTbl, CFG_IMG_POOL_CHILD_STACK_SIZE);
+         ChildTaskInit.Priority  = INITBL_GetIntConfig(IniTbl, CFG_IMG_POOL_CHILD_PRIORITY);
+
+         SysStatus = CHILDMGR_Constructor(&ImgPool->Worker[i].ChildMgr, ChildMgr_TaskMainCallback,
+                                          IMG_POOL_WorkerTask, &ChildTaskInit);
+         if (SysStatus == CFE_SUCCESS)
+         {
+            ImgPool->WorkerCnt++;
+         }
+
+      } /* End worker loop */
+
+      if (SysStatus != CFE_SUCCESS)
+      {
+         CFE_EVS_SendEvent (IMG_POOL_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR,
+                            "Image worker initialization failed, %d of %d workers started. Status = 0x%08X",
+                            ImgPool->WorkerCnt, WorkerCnt, SysStatus);
+      }
+
+   } /* End if WorkerCnt > 0 */
+
+} /* End IMG_POOL_Constructor() */
+
+
+/******************************************************************************
+** Function: IMG_POOL_AddRow
+**
+** Notes:
+**   1. Rows after the buffer is full are ignored. The detector doesn't read
+**      out more rows than an image has before restarting at its first row.
+**
+*/
+void IMG_POOL_AddRow(IMG_POOL_Image_t *Image, const PL_SIM_LIB_Detector_t *Detector)
+{
+
+   if (Image->RowCnt < PL_SIM_LIB_DETECTOR_ROWS_PER_IMAGE)
+   {
+      Image->Row[Image->RowCnt] = *Detector;
+      Image->RowCnt++;
+   }
+
+} /* End IMG_POOL_AddRow() */
+
+
+/******************************************************************************
+** Function: IMG_POOL_AllocImage
+**
+** Notes:
+**   1. A drop event is only sent for the first drop after a status reset.
+**
+*/
+IMG_POOL_Image_t *IMG_POOL_AllocImage(DETCTOR_MON_Class_t *DetectorMon, IMG_STATS_Class_t *ImgStats,
+                                      SCI_FILE_Class_t *SciFile, osal_id_t DoneSemId)
+{
+
+   IMG_POOL_Image_t *Image = NULL;
+   uint16 InUseCnt;
+   uint16 i;
+
+   for (i=0; (Image == NULL) && (i < IMG_POOL_IMAGE_CNT); i++)
+   {
+      if (__atomic_load_n(&ImgPool->Image[i].State, __ATOMIC_ACQUIRE) == IMG_POOL_IMAGE_FREE)
+      {
+         Image = &ImgPool->Image[i];
+      }
+   }
+
+   if (Image != NULL)
+   {
+
+      __atomic_store_n(&Image->State, IMG_POOL_IMAGE_FILLING, __ATOMIC_RELAXED);
+      Image->DetectorMon = DetectorMon;
+      Image->ImgStats    = ImgStats;
+      Image->SciFile     = SciFile;
+      Image->DoneSemId   = DoneSemId;
+      Image->RowCnt      = 0;
+
+      InUseCnt = __atomic_add_fetch(&ImgPool->ImageInUseCnt, 1, __ATOMIC_RELAXED);
+      if (InUseCnt > ImgPool->ImageInUseHwm)
+      {
+         ImgPool->ImageInUseHwm = InUseCnt;
+      }
+
+   }
+   else
+   {
+
+      if (ImgPool->DropCnt == 0)
+      {
+         CFE_EVS_SendEvent (IMG_POOL_IMAGE_DROP_EID, CFE_EVS_EventType_ERROR,
+                            "No image buffer is free, detector data is being dropped");
+      }
+      ImgPool->DropCnt++;
+
+   }
+
+   return Image;
+
+} /* End IMG_POOL_AllocImage() */
+
+
+/******************************************************************************
+** Function: IMG_POOL_CommitImage
+**
+*/
+void IMG_POOL_CommitImage(IMG_POOL_Image_t *Image)
+{
+
+   DETECTOR_MON_Merge(Image->DetectorMon, &Image->MonResult);
+
+   if (Image->RowCnt > 0)
+   {
+      if (SCI_FILE_GetRowControl(&Image->Row[Image->RowCnt-1]) == SCI_FILE_LAST_ROW)
+      {
+         IMG_STATS_SendImageSummary(Image->ImgStats, &Image->StatsResult);
+      }
+   }
+
+   SCI_FILE_WriteImage(Image->SciFile, Image->Row, Image->RowCnt, &Image->Encoded,
+                       (Image->MonResult.BadRowCnt > 0));
+
+   IMG_POOL_FreeImage(Image);
+
+} /* End IMG_POOL_CommitImage() */
+
+
+/******************************************************************************
+** Function: IMG_POOL_Dispatch
+**
+*/
+void IMG_POOL_Dispatch(IMG_POOL_Image_t *Image)
+{
+
+   __atomic_store_n(&Image->State, IMG_POOL_IMAGE_QUEUED, __ATOMIC_RELAXED);
+
+   OS_MutSemTake(ImgPool->MutexId);
+   ImgPool->WorkQueue[ImgPool->WorkHead % IMG_POOL_IMAGE_CNT] = Image;
+   ImgPool->WorkHead++;
+   OS_MutSemGive(ImgPool->MutexId);
+
+   OS_CountSemGive(ImgPool->WorkSemId);
+
+} /* End IMG_POOL_Dispatch() */
+
+
+/******************************************************************************
+** Function: IMG_POOL_Enabled
+**
+*/
+bool IMG_POOL_Enabled(void)
+{
+
+   return (ImgPool->WorkerCnt > 0);
+
+} /* End IMG_POOL_Enabled() */
+
+
+/******************************************************************************
+** Function: IMG_POOL_FreeImage
+**
+*/
+void IMG_POOL_FreeImage(IMG_POOL_Image_t *Image)
+{
+
+   __atomic_sub_fetch(&ImgPool->ImageInUseCnt, 1, __ATOMIC_RELAXED);
+   __atomic_store_n(&Image->State, IMG_POOL_IMAGE_FREE, __ATOMIC_RELEASE);
+
+} /* End IMG_POOL_FreeImage() */
+
+
+/******************************************************************************
+** Function: IMG_POOL_ImageDone
+**
+*/
+bool IMG_POOL_ImageDone(const IMG_POOL_Image_t *Image)
+{
+
+   return (__atomic_load_n(&Image->State, __ATOMIC_ACQUIRE) == IMG_POOL_IMAGE_DONE);
+
+} /* End IMG_POOL_ImageDone() */
+
+
+/******************************************************************************
+** Function: IMG_POOL_ResetStatus
+**
+** Notes:
+**   1. ImageCnt is incremented by the workers so it's reset atomically.
+**
+*/
+void IMG_POOL_ResetStatus(void)
+{
+
+   ImgPool->ImageInUseHwm = 0;
+   ImgPool->DropCnt       = 0;
+   __atomic_store_n(&ImgPool->ImageCnt, 0, __ATOMIC_RELAXED);
+
+} /* End IMG_POOL_ResetStatus() */
+
+
+/******************************************************************************
+** Function: IMG_POOL_WorkerTask
+**
+** Notes:
+**   1. Returning false terminates the child task.
+**   2. Worker's ChildMgr is the first member of IMG_POOL_Worker_t so it's
+**      also a pointer to the worker that owns the task.
+**
+*/
+bool IMG_POOL_WorkerTask(CHILDMGR_Class_t *ChildMgr)
+{
+
+   IMG_POOL_Worker_t *Worker = (IMG_POOL_Worker_t *)ChildMgr;
+   IMG_POOL_Image_t  *Image;
+   bool RetStatus = false;
+
+   if (OS_CountSemTake(ImgPool->WorkSemId) == OS_SUCCESS)
+   {
+
+      Image = GetWork();
+      if (Image != NULL)
+      {
+         ProcessImage(Worker, Image);
+      }
+      RetStatus = true;
+
+   }
+
+   return RetStatus;
+
+} /* End IMG_POOL_WorkerTask() */
+
+
+/******************************************************************************
+** Function: GetWork
+**
+** Remove the oldest image from the work queue
+**
+** Notes:
+**   1. Returns NULL if the queue is empty.
+**
+*/
+static IMG_POOL_Image_t *GetWork(void)
+{
+
+   IMG_POOL_Image_t *Image = NULL;
+
+   OS_MutSemTake(ImgPool->MutexId);
+
+   if (ImgPool->WorkTail != ImgPool->WorkHead)
+   {
+      Image = ImgPool->WorkQueue[ImgPool->WorkTail % IMG_POOL_IMAGE_CNT];
+      ImgPool->WorkTail++;
+   }
+
+   OS_MutSemGive(ImgPool->MutexId);
+
+   return Image;
+
+} /* End GetWork() */
+
+
+/******************************************************************************
+** Function: ProcessImage
+**
+** Validate an image's rows, accumulate its statistics and build its science
+** file records
+**
+** Notes:
+**   1. Only the image buffer and the worker's encoder are modified so
+**      images can be processed concurrently. See prologue notes.
+**
+*/
+static void ProcessImage(IMG_POOL_Worker_t *Worker, IMG_POOL_Image_t *Image)
+{
+
+   OS_time_t StageTime;
+   uint16 i;
+
+   DETECTOR_MON_Constructor(&Image->MonResult);
+
+   for (i=0; i < Image->RowCnt; i++)
+   {
+
+      PERF_HIST_Start(&StageTime);
+      DETECTOR_MON_CheckData(&Image->MonResult, &Image->Row[i].Row);
+      PERF_HIST_Stop(PERF_HIST_CHECK_DATA, &StageTime);
+
+      IMG_STATS_AddImageRow(Image->ImgStats, &Image->StatsResult, &Image->Row[i], (i == 0));
+
+   }
+
+   SCI_FILE_EncodeImage(Image->SciFile, &Worker->Encoder, Image->Row, Image->RowCnt, &Image->Encoded);
+
+   __atomic_add_fetch(&ImgPool->ImageCnt, 1, __ATOMIC_RELAXED);
+   __atomic_store_n(&Image->State, IMG_POOL_IMAGE_DONE, __ATOMIC_RELEASE);
+   OS_BinSemGive(Image->DoneSemId);
+
+} /* End ProcessImage() */
@@ -0,0 +1,290 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the image processing worker pool object
+**
+**  Notes:
+**    1. The pool is a three stage pipeline. The acquisition child task
+**       gathers each channel's detector rows into a whole image buffer,
+**       an IMG_POOL worker child task validates the image's rows,
+**       accumulates its statistics and builds its compressed and
+**       checksummed science file records, and the channel's SCI_WRITER
+**       child task commits the results in image order. The acquisition of
+**       the next image overlaps the processing of the previous images.
+**    2. IMG_POOL_WORKER_CNT worker tasks share one work queue so images
+**       from any channel are processed by the first idle worker. Images
+**       from the same channel can be processed concurrently because a
+**       worker only uses the image buffer and its own encoder. See the
+**       SCI_FILE, IMG_STATS and DETECTOR_MON prologue notes.
+**    3. IMG_POOL_IMAGE_CNT image buffers are shared by all of the channels.
+**       Only the acquisition task allocates buffers and only SCI_WRITER
+**       tasks free them so a buffer's state is the only shared data and
+**       it's accessed atomically. If no buffer is free the detector row is
+**       dropped and the drop counter is incremented.
+**    4. A worker count of 0 disables the pool and each row is processed
+**       by the acquisition task and written by the SCI_WRITER task as it's
+**       read.
+**    5. This object is a singleton owned by the payload object.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _img_pool_
+#define _img_pool_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "pl_sim_lib.h"  /* See prologue notes */
+#include "sci_file.h"
+#include "detector_mon.h"
+#include "img_stats.h"
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+/*
+** Event Message IDs
+*/
+
+#define IMG_POOL_CONSTRUCTOR_EID  (IMG_POOL_BASE_EID + 0)
+#define IMG_POOL_IMAGE_DROP_EID   (IMG_POOL_BASE_EID + 1)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef enum
+{
+
+   IMG_POOL_IMAGE_FREE    = 1,
+   IMG_POOL_IMAGE_FILLING = 2,   /* Owned by the acquisition task */
+   IMG_POOL_IMAGE_QUEUED  = 3,   /* Waiting for or owned by a worker */
+   IMG_POOL_IMAGE_DONE    = 4    /* Waiting to be committed */
+
+} IMG_POOL_ImageState_t;
+
+
+/******************************************************************************
+** Whole image buffer
+**
+** The channel object pointers are set when the buffer is allocated. The
+** results are only valid when the image is done.
+*/
+
+typedef struct
+{
+
+   uint32  State;   /* IMG_POOL_ImageState_t, accessed atomically */
+
+   DETCTOR_MON_Class_t  *DetectorMon;
+   IMG_STATS_Class_t    *ImgStats;
+   SCI_FILE_Class_t     *SciFile;
+   osal_id_t             DoneSemId;
+
+   uint16                 RowCnt;
+   PL_SIM_LIB_Detector_t  Row[PL_SIM_LIB_DETECTOR_ROWS_PER_IMAGE];
+
+   /*
+   ** Worker results
+   */
+
+   DETCTOR_MON_Class_t      MonResult;
+   IMG_STATS_Image_t        StatsResult;
+   SCI_FILE_EncodedImage_t  Encoded;
+
+} IMG_POOL_Image_t;
+
+
+/******************************************************************************
+** Worker
+*/
+
+typedef struct
+{
+
+   CHILDMGR_Class_t    ChildMgr;    /* Must be first, see IMG_POOL_WorkerTask() */
+   char                TaskName[OS_MAX_API_NAME];
+   SCI_FILE_Encoder_t  Encoder;
+
+} IMG_POOL_Worker_t;
+
+
+/******************************************************************************
+** IMG_POOL_Class
+*/
+
+typedef struct
+{
+
+   osal_id_t  MutexId;      /* Serializes work queue access   */
+   osal_id_t  WorkSemId;    /* Counts images in the work queue */
+
+   uint16  WorkerCnt;
+
+   /*
+   ** Status
+   */
+
+   uint16  ImageInUseCnt;
+   uint16  ImageInUseHwm;
+   uint16  ImageCnt;        /* Images processed by the workers */
+   uint16  DropCnt;         /* Detector rows dropped, see prologue notes */
+
+   /*
+   ** Work queue, protected by MutexId. It can't overflow because it's as
+   ** long as the number of image buffers.
+   */
+
+   uint32  WorkHead;
+   uint32  WorkTail;
+   IMG_POOL_Image_t *WorkQueue[IMG_POOL_IMAGE_CNT];
+
+   IMG_POOL_Worker_t  Worker[IMG_POOL_WORKER_MAX];
+   IMG_POOL_Image_t   Image[IMG_POOL_IMAGE_CNT];
+
+} IMG_POOL_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+/******************************************************************************
+** Function: IMG_POOL_Constructor
+**
+** Initialize the image pool to a known state and start its worker tasks
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**   2. Worker task names are the IMG_POOL_CHILD_NAME init file parameter
+**      followed by the worker number.
+**   3. The pool is disabled if no worker task can be started.
+**
+*/
+void IMG_POOL_Constructor(IMG_POOL_Class_t *ImgPoolPtr, INITBL_Class_t *IniTbl);
+
+
+/******************************************************************************
+** Function: IMG_POOL_AddRow
+**
+** Copy a detector row into an image buffer
+**
+** Notes:
+**   1. Only called by the acquisition task for an image it's filling.
+**
+*/
+void IMG_POOL_AddRow(IMG_POOL_Image_t *Image, const PL_SIM_LIB_Detector_t *Detector);
+
+
+/******************************************************************************
+** Function: IMG_POOL_AllocImage
+**
+** Allocate an image buffer for a channel
+**
+** Notes:
+**   1. Only called by the acquisition task. See prologue notes.
+**   2. Returns NULL if no buffer is free and the drop counter is
+**      incremented.
+**   3. DoneSemId is given when a worker finishes the image.
+**
+*/
+IMG_POOL_Image_t *IMG_POOL_AllocImage(DETCTOR_MON_Class_t *DetectorMon, IMG_STATS_Class_t *ImgStats,
+                                      SCI_FILE_Class_t *SciFile, osal_id_t DoneSemId);
+
+
+/******************************************************************************
+** Function: IMG_POOL_CommitImage
+**
+** Commit a processed image's results to its channel and free the image
+**
+** Notes:
+**   1. Called by the channel's SCI_WRITER task in image order after
+**      IMG_POOL_ImageDone() returns true.
+**   2. The image summary telemetry is only sent if the image has its last
+**      row.
+**
+*/
+void IMG_POOL_CommitImage(IMG_POOL_Image_t *Image);
+
+
+/******************************************************************************
+** Function: IMG_POOL_Dispatch
+**
+** Queue a filled image buffer to be processed by a worker
+**
+*/
+void IMG_POOL_Dispatch(IMG_POOL_Image_t *Image);
+
+
+/******************************************************************************
+** Function: IMG_POOL_Enabled
+**
+** Return true if the pool has worker tasks
+**
+*/
+bool IMG_POOL_Enabled(void);
+
+
+/******************************************************************************
+** Function: IMG_POOL_FreeImage
+**
+** Return an image buffer to the pool without committing it
+**
+*/
+void IMG_POOL_FreeImage(IMG_POOL_Image_t *Image);
+
+
+/******************************************************************************
+** Function: IMG_POOL_ImageDone
+**
+** Return true if a worker has finished processing the image
+**
+*/
+bool IMG_POOL_ImageDone(const IMG_POOL_Image_t *Image);
+
+
+/******************************************************************************
+** Function: IMG_POOL_ResetStatus
+**
+** Reset counters and status flags to a known reset state.
+**
+** Notes:
+**   1. Any counter or variable that is reported in HK telemetry that doesn't
+**      change the functional behavior should be reset.
+**
+*/
+void IMG_POOL_ResetStatus(void);
+
+
+/******************************************************************************
+** Function: IMG_POOL_WorkerTask
+**
+** Pend for an image in the work queue and process it
+**
+** Notes:
+**   1. This function must comply with the CHILDMGR callback definition.
+**
+*/
+bool IMG_POOL_WorkerTask(CHILDMGR_Class_t *ChildMgr);
+
+
+#endif /* _img_pool_ */
@@ -0,0 +1,254 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the image statistics object
+**
+**  Notes:
+**    1. Each row is decoded and reduced in a branch-free loop with
+**       row-local accumulators so the compiler can vectorize the min, max,
+**       sum, sum of squares and saturation count. Bytes that aren't pixel
+**       values are masked out of the accumulators. The histogram is updated in a
+**       separate loop because its scattered increments can't be vectorized.
+**       Both loops read the row while it's in the cache.
+**    2. The variance is the population variance computed from the sum and
+**       sum of squares when the summary is sent.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+
+#include "app_cfg.h"
+#include "img_stats.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define ROW_LEN  (sizeof(((PL_SIM_LIB_DetectorRow_t *)0)->Data))
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void StartImage(IMG_STATS_Image_t *Image, uint16 ImageId);
+
+
+/******************************************************************************
+** Function: IMG_STATS_Constructor
+**
+*/
+void IMG_STATS_Constructor(IMG_STATS_Class_t *ImgStats, INITBL_Class_t *IniTbl, uint16 Channel)
+{
+
+   uint32 SatLevel;
+   
+   CFE_PSP_MemSet((void*)ImgStats, 0, sizeof(IMG_STATS_Class_t));
+   
+   ImgStats->Channel = Channel;
+
+   SatLevel = INITBL_GetIntConfig(IniTbl, CFG_IMG_STATS_SAT_LEVEL);
+   if (SatLevel > DETECTOR_PIXEL_MAX)
+   {
+      CFE_EVS_SendEvent (IMG_STATS_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR, 
+                         "Invalid pixel saturation level %d, must be less than or equal to %d. Using %d.",
+                         SatLevel, DETECTOR_PIXEL_MAX, DETECTOR_PIXEL_MAX);
+      SatLevel = DETECTOR_PIXEL_MAX;
+   }
+   ImgStats->SatLevel = (uint8)SatLevel;
+   
+   StartImage(&ImgStats->Image, 0);
+   
+   CFE_MSG_Init(CFE_MSG_PTR(ImgStats->ImageSummaryTlm.TelemetryHeader), 
+                CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_PL_MGR_IMAGE_SUMMARY_TLM_TOPICID)),
+                sizeof(PL_MGR_ImageSummaryTlm_t));
+
+} /* End IMG_STATS_Constructor() */
+
+
+/******************************************************************************
+** Function: IMG_STATS_AddRow
+**
+** Notes:
+**   1. See prologue notes.
+**
+*/
+void IMG_STATS_AddRow(IMG_STATS_Class_t *ImgStats, const PL_SIM_LIB_Detector_t *Detector,
+                      bool FirstRow, bool LastRow)
+{
+
+   IMG_STATS_AddImageRow(ImgStats, &ImgStats->Image, Detector, FirstRow);
+   
+   if (LastRow)
+   {
+      IMG_STATS_SendImageSummary(ImgStats, &ImgStats->Image);
+      StartImage(&ImgStats->Image, Detector->ImageCnt + 1);
+   }
+
+} /* End IMG_STATS_AddRow() */
+
+
+/******************************************************************************
+** Function: IMG_STATS_AddImageRow
+**
+** Notes:
+**   1. See prologue notes.
+**
+*/
+void IMG_STATS_AddImageRow(const IMG_STATS_Class_t *ImgStats, IMG_STATS_Image_t *Image,
+                           const PL_SIM_LIB_Detector_t *Detector, bool FirstRow)
+{
+
+   const uint8 *Pixel = (const uint8 *)Detector->Row.Data;
+   const uint8 *RowEnd;
+   uint32 ByteCnt;
+   uint32 Value;
+   uint32 Valid;
+   uint32 Mask;
+   uint32 RowCnt   = 0;
+   uint32 RowMin   = 255;
+   uint32 RowMax   = 0;
+   uint32 RowSum   = 0;
+   uint32 RowSumSq = 0;
+   uint32 RowSat   = 0;
+   uint32 i;
+   
+   if (FirstRow)
+   {
+      StartImage(Image, Detector->ImageCnt);
+   }
+   
+   RowEnd  = memchr(Pixel, '\0', ROW_LEN);
+   ByteCnt = (RowEnd == NULL) ? ROW_LEN : (uint32)(RowEnd - Pixel);
+   
+   for (i = 0; i < ByteCnt; i++)
+   {
+      Value     = (uint8)(Pixel[i] - DETECTOR_PIXEL_ZERO);
+      Valid     = (Value <= DETECTOR_PIXEL_MAX);
+      Mask      = 0 - Valid;
+      RowMin    = ((Value | ~Mask) < RowMin) ? (Value | ~Mask) : RowMin;
+      RowMax    = ((Value & Mask) > RowMax) ? (Value & Mask) : RowMax;
+      RowSum   += Value & Mask;
+      RowSumSq += (Value * Value) & Mask;
+      RowSat   += Valid & (Value >= ImgStats->SatLevel);
+      RowCnt   += Valid;
+   }
+   
+   for (i = 0; i < ByteCnt; i++)
+   {
+      Value = (uint8)(Pixel[i] - DETECTOR_PIXEL_ZERO);
+      if (Value <= DETECTOR_PIXEL_MAX)
+      {
+         Image->Hist[Value]++;
+      }
+   }
+   
+   if (RowCnt > 0)
+   {
+      if (RowMin < Image->Min) Image->Min = RowMin;
+      if (RowMax > Image->Max) Image->Max = RowMax;
+   }
+   Image->Sum      += RowSum;
+   Image->SumSq    += RowSumSq;
+   Image->SatCnt   += RowSat;
+   Image->PixelCnt += RowCnt;
+   Image->RowCnt++;
+   
+} /* End IMG_STATS_AddImageRow() */
+
+
+/******************************************************************************
+** Function: IMG_STATS_SendImageSummary
+**
+** Notes:
+**   1. Histogram bins are limited to the telemetry field's maximum value.
+**
+*/
+void IMG_STATS_SendImageSummary(IMG_STATS_Class_t *ImgStats, const IMG_STATS_Image_t *Image)
+{
+
+   PL_MGR_ImageSummaryTlm_Payload_t *Payload = &ImgStats->ImageSummaryTlm.Payload;
+   double Mean = 0.0;
+   double Variance = 0.0;
+   uint32 i;
+   
+   if (Image->PixelCnt > 0)
+   {
+      Mean     = (double)Image->Sum / Image->PixelCnt;
+      Variance = ((double)Image->SumSq / Image->PixelCnt) - (Mean * Mean);
+   }
+   
+   Payload->Channel  = ImgStats->Channel;
+   Payload->ImageId  = Image->ImageId;
+   Payload->RowCnt   = Image->RowCnt;
+   Payload->PixelCnt = Image->PixelCnt;
+   Payload->Min      = (Image->PixelCnt > 0) ? Image->Min : 0;
+   Payload->Max      = Image->Max;
+   Payload->Mean     = (float)Mean;
+   Payload->Variance = (float)Variance;
+   Payload->SatCnt   = Image->SatCnt;
+   
+   for (i = 0; i < IMG_STATS_HIST_BINS; i++)
+   {
+      Payload->Hist[i] = (Image->Hist[i] > 0xFFFF) ? 0xFFFF : (uint16)Image->Hist[i];
+   }
+   
+   CFE_SB_TimeStampMsg(CFE_MSG_PTR(ImgStats->ImageSummaryTlm.TelemetryHeader));
+   CFE_SB_TransmitMsg(CFE_MSG_PTR(ImgStats->ImageSummaryTlm.TelemetryHeader), true);
+   
+   ImgStats->ImageSummaryCnt++;
+
+} /* End IMG_STATS_SendImageSummary() */
+
+
+/******************************************************************************
+** Function: IMG_STATS_ResetStatus
+**
+*/
+void IMG_STATS_ResetStatus(IMG_STATS_Class_t *ImgStats)
+{
+
+   ImgStats->ImageSummaryCnt = 0;
+
+} /* End IMG_STATS_ResetStatus() */
+
+
+/******************************************************************************
+** Function: StartImage
+**
+*/
+static void StartImage(IMG_STATS_Image_t *Image, uint16 ImageId)
+{
+
+   Image->ImageId  = ImageId;
+   Image->RowCnt   = 0;
+   Image->PixelCnt = 0;
+   Image->Min      = 255;
+   Image->Max      = 0;
+   Image->Sum      = 0;
+   Image->SumSq    = 0;
+   Image->SatCnt   = 0;
+   memset(Image->Hist, 0, sizeof(Image->Hist));
+
+} /* End StartImage() */
@@ -0,0 +1,183 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the image statistics object
+**
+**  Notes:
+**    1. Statistics are accumulated as each detector row is read so image
+**       content can be assessed without downlinking science files. When
+**       an image's last row is added an image summary telemetry packet is
+**       sent.
+**    2. Each byte of a row up to the row's string terminator is a pixel.
+**       Pixels are decoded to their 0..DETECTOR_PIXEL_MAX values so the
+**       statistics are in detector units. Bytes that aren't pixel values
+**       are faults reported by DETECTOR_MON and they're not included.
+**    3. A pixel is saturated if its value is greater than or equal to the
+**       IMG_STATS_SAT_LEVEL init file parameter, 0..DETECTOR_PIXEL_MAX.
+**    4. Rows are added by the payload's acquisition child task. The summary
+**       packet is owned by this object and is sent from that task. When the
+**       IMG_POOL worker pool is used the summary is sent by the channel's
+**       SCI_WRITER child task, see note 6.
+**    5. There is one instance per detector channel and the summary packet
+**       identifies the channel.
+**    6. An image's statistics are accumulated in an IMG_STATS_Image_t so an
+**       IMG_POOL worker can accumulate a whole image without using the
+**       instance's current image. The worker's image is reported with
+**       IMG_STATS_SendImageSummary().
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _img_stats_
+#define _img_stats_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "pl_sim_lib.h"  /* See prologue notes */
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+/*
+** Event Message IDs
+*/
+
+#define IMG_STATS_CONSTRUCTOR_EID  (IMG_STATS_BASE_EID + 0)
+
+/*
+** One histogram bin per pixel value. Must match the ImageHistogram EDS
+** definition.
+*/
+
+#define IMG_STATS_HIST_BINS  (DETECTOR_PIXEL_MAX + 1)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** Image accumulators
+*/
+
+typedef struct
+{
+
+   uint16  ImageId;
+   uint16  RowCnt;
+   uint32  PixelCnt;
+   uint8   Min;
+   uint8   Max;
+   uint32  Sum;
+   uint64  SumSq;
+   uint32  SatCnt;
+   uint32  Hist[IMG_STATS_HIST_BINS];
+
+} IMG_STATS_Image_t;
+
+
+/******************************************************************************
+** IMG_STATS_Class
+*/
+
+typedef struct
+{
+
+   uint16  Channel;
+   uint8   SatLevel;
+   uint16  ImageSummaryCnt;
+   
+   IMG_STATS_Image_t  Image;   /* Current image */
+   
+   PL_MGR_ImageSummaryTlm_t ImageSummaryTlm;
+
+} IMG_STATS_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: IMG_STATS_Constructor
+**
+** Initialize the image statistics object to a known state
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**
+*/
+void IMG_STATS_Constructor(IMG_STATS_Class_t *ImgStats, INITBL_Class_t *IniTbl, uint16 Channel);
+
+
+/******************************************************************************
+** Function: IMG_STATS_AddRow
+**
+** Add a detector row to the current image's statistics
+**
+** Notes:
+**   1. FirstRow starts a new image and LastRow sends the image summary
+**      telemetry packet.
+**
+*/
+void IMG_STATS_AddRow(IMG_STATS_Class_t *ImgStats, const PL_SIM_LIB_Detector_t *Detector,
+                      bool FirstRow, bool LastRow);
+
+
+/******************************************************************************
+** Function: IMG_STATS_AddImageRow
+**
+** Add a detector row to an image's statistics
+**
+** Notes:
+**   1. FirstRow starts the image. ImgStats is only used for its
+**      configuration so this can be called from any task.
+**
+*/
+void IMG_STATS_AddImageRow(const IMG_STATS_Class_t *ImgStats, IMG_STATS_Image_t *Image,
+                           const PL_SIM_LIB_Detector_t *Detector, bool FirstRow);
+
+
+/******************************************************************************
+** Function: IMG_STATS_SendImageSummary
+**
+** Send an image's summary telemetry packet
+**
+*/
+void IMG_STATS_SendImageSummary(IMG_STATS_Class_t *ImgStats, const IMG_STATS_Image_t *Image);
+
+
+/******************************************************************************
+** Function: IMG_STATS_ResetStatus
+**
+** Reset counters and status flags to a known reset state.
+**
+** Notes:
+**   1. Any counter or variable that is reported in HK telemetry that doesn't
+**      change the functional behavior should be reset.
+**
+*/
+void IMG_STATS_ResetStatus(IMG_STATS_Class_t *ImgStats);
+
+
+#endif /* _img_stats_ */
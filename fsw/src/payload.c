@@ -45,6 +45,18 @@ static PAYLOAD_Class_t *Payload = NULL;
 /** Local Function Prototypes **/
 /*******************************/
 
+static void ConstructChannel(PAYLOAD_Channel_t *Channel, INITBL_Class_t *IniTbl, uint16 Id);
+static void DispatchImage(PAYLOAD_Channel_t *Channel);
+static void GatherDetectorRow(PAYLOAD_Channel_t *Channel, SCI_FILE_Control_t Control);
+static PAYLOAD_Channel_t *GetChannel(uint16 Id, const char *CmdName);
+static void ManageChannel(PAYLOAD_Channel_t *Channel);
+static void ProcessDetectorRow(PAYLOAD_Channel_t *Channel);
+static bool ReadDetectorRow(PAYLOAD_Channel_t *Channel);
+static PL_SIM_LIB_Power_Enum_t ReadPowerState(PAYLOAD_Channel_t *Channel);
+static void ResetCycleStatus(void);
+static void ResumeChannel(PAYLOAD_Channel_t *Channel);
+static void UpdateAcqRate(const OS_time_t *CurrentTime);
+
 
 /******************************************************************************
 ** Function: PAYLOAD_Constructor
@@ -53,70 +65,251 @@ static PAYLOAD_Class_t *Payload = NULL;
 void PAYLOAD_Constructor(PAYLOAD_Class_t *PayloadPtr, INITBL_Class_t *IniTbl)
 {
  
+   int32  SysStatus;
+   uint32 CycleRowLim;
+   uint16 i;
+   CHILDMGR_TaskInit_t ChildTaskInit;
+
    Payload = PayloadPtr;
 
    CFE_PSP_MemSet((void*)Payload, 0, sizeof(PAYLOAD_Class_t));
    
-   Payload->PowerState     = PL_SIM_LIB_Power_OFF;
-   Payload->PrevPowerState = PL_SIM_LIB_Power_OFF;
+   CycleRowLim = INITBL_GetIntConfig(IniTbl, CFG_PAYLOAD_CYCLE_ROW_LIM);
+   if (CycleRowLim == 0 || CycleRowLim > PAYLOAD_CYCLE_ROW_LIM_MAX)
+   {
+      CFE_EVS_SendEvent (PAYLOAD_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR,
+                         "Invalid cycle row limit %u, must be between 1 and %d. Using %d.",
+                         (unsigned int)CycleRowLim, PAYLOAD_CYCLE_ROW_LIM_MAX,
+                         (CycleRowLim == 0) ? 1 : PAYLOAD_CYCLE_ROW_LIM_MAX);
+      CycleRowLim = (CycleRowLim == 0) ? 1 : PAYLOAD_CYCLE_ROW_LIM_MAX;
+   }
+   Payload->CycleRowLim  = (uint16)CycleRowLim;
+   Payload->CycleUsecLim = INITBL_GetIntConfig(IniTbl, CFG_PAYLOAD_CYCLE_USEC_LIM);
+   
+   Payload->ChannelCnt = INITBL_GetIntConfig(IniTbl, CFG_PAYLOAD_CHANNEL_CNT);
+   if (Payload->ChannelCnt == 0 || Payload->ChannelCnt > PAYLOAD_CHANNEL_MAX)
+   {
+      CFE_EVS_SendEvent (PAYLOAD_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR,
+                         "Invalid detector channel count %d, must be between 1 and %d. Using 1 channel.",
+                         Payload->ChannelCnt, PAYLOAD_CHANNEL_MAX);
+      Payload->ChannelCnt = 1;
+   }
+   
+   PERF_HIST_Constructor(&Payload->PerfHist, IniTbl);
+   SCI_STREAM_Constructor(&Payload->SciStream, IniTbl, Payload->ChannelCnt);
+   SCI_CATALOG_Constructor(&Payload->SciCatalog, IniTbl);
+   SCI_RETAIN_Constructor(&Payload->SciRetain, IniTbl);
+   for (i=0; i < Payload->ChannelCnt; i++)
+   {
+      ConstructChannel(&Payload->Channel[i], IniTbl, i);
+   }
+   
+   /*
+   ** Start the writer tasks after all of the channels' science files exist
+   */
+   
+   for (i=0; i < Payload->ChannelCnt; i++)
+   {
+      SCI_WRITER_Constructor(&Payload->Channel[i].SciWriter, IniTbl, &Payload->Channel[i].SciFile,
+                             &Payload->Channel[i].DetectorMon, &Payload->Channel[i].ImgStats, i);
+   }
+   
+   IMG_POOL_Constructor(&Payload->ImgPool, IniTbl);
+   
+   /*
+   ** Resume the channels' science data collection before the acquisition
+   ** task starts so the detector interface doesn't need the mutex
+   */
+   
+   for (i=0; i < Payload->ChannelCnt; i++)
+   {
+      ResumeChannel(&Payload->Channel[i]);
+   }
+   
+   /*
+   ** Start the acquisition task after all of the data path objects exist
+   */
+   
+   Payload->AcqPeriodMs = INITBL_GetIntConfig(IniTbl, CFG_ACQ_PERIOD_MS);
+   Payload->AcqIdleMs   = INITBL_GetIntConfig(IniTbl, CFG_ACQ_IDLE_MS);
+   if (Payload->AcqIdleMs == 0)
+   {
+      CFE_EVS_SendEvent (PAYLOAD_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR,
+                         "Invalid acquisition idle time of 0 ms. Using 1 ms.");
+      Payload->AcqIdleMs = 1;
+   }
+   CFE_PSP_GetTime(&Payload->AcqNextCycleTime);
+   Payload->AcqRateStartTime = Payload->AcqNextCycleTime;
    
-   SCI_FILE_Constructor(&Payload->SciFile, IniTbl);
-   DETECTOR_MON_Constructor(&Payload->DetectorMon);
+   SysStatus = OS_MutSemCreate(&Payload->DetectorMutexId, "PL_MGR_DETECTOR", 0);
+   
+   if (SysStatus == OS_SUCCESS)
+   {
+      SysStatus = OS_BinSemCreate(&Payload->AcqWakeSemId, "PL_MGR_ACQWAKE", OS_SEM_EMPTY, 0);
+   }
+   
+   if (SysStatus == OS_SUCCESS)
+   {
+      
+      ChildTaskInit.TaskName  = INITBL_GetStrConfig(IniTbl, CFG_ACQ_CHILD_NAME);
+      ChildTaskInit.PerfId    = INITBL_GetIntConfig(IniTbl, CFG_ACQ_CHILD_PERF_ID);
+      ChildTaskInit.StackSize = INITBL_GetIntConfig(IniTbl, CFG_ACQ_CHILD_STACK_SIZE);
+      ChildTaskInit.Priority  = INITBL_GetIntConfig(IniTbl, CFG_ACQ_CHILD_PRIORITY);
+
+      SysStatus = CHILDMGR_Constructor(&Payload->AcqChildMgr, ChildMgr_TaskMainCallback,
+                                       PAYLOAD_AcqChildTask, &ChildTaskInit);
+   }
+   
+   if (SysStatus != CFE_SUCCESS)
+   {
+      CFE_EVS_SendEvent (PAYLOAD_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR,
+                         "Acquisition child task initialization failed. Status = 0x%08X", SysStatus);
+   }
    
 } /* End PAYLOAD_Constructor() */
 
 
+/******************************************************************************
+** Function: PAYLOAD_AcqChildTask
+**
+** Notes:
+**   1. The next cycle time is advanced by the period so the cycle rate
+**      doesn't drift. If a cycle overruns the next cycle starts immediately
+**      and the schedule is restarted from the current time.
+**
+*/
+bool PAYLOAD_AcqChildTask(CHILDMGR_Class_t *ChildMgr)
+{
+
+   OS_time_t StartTime;
+   OS_time_t CurrentTime;
+   int64     DelayMs;
+   
+   CFE_PSP_GetTime(&StartTime);
+   
+   PAYLOAD_ManageData();
+   
+   CFE_PSP_GetTime(&CurrentTime);
+   Payload->AcqCycleCnt++;
+   Payload->AcqCycleUsec = OS_TimeGetTotalMicroseconds(OS_TimeSubtract(CurrentTime, StartTime));
+   if (Payload->AcqCycleUsec > Payload->AcqCycleUsecMax)
+   {
+      Payload->AcqCycleUsecMax = Payload->AcqCycleUsec;
+   }
+   UpdateAcqRate(&CurrentTime);
+   
+   if (Payload->AcqPeriodMs > 0)
+   {
+      
+      Payload->AcqNextCycleTime = OS_TimeAdd(Payload->AcqNextCycleTime, 
+                                             OS_TimeAssembleFromMilliseconds(0, Payload->AcqPeriodMs));
+      DelayMs = OS_TimeGetTotalMilliseconds(OS_TimeSubtract(Payload->AcqNextCycleTime, CurrentTime));
+      
+      if (DelayMs > 0)
+      {
+         OS_TaskDelay((uint32)DelayMs);
+      }
+      else
+      {
+         Payload->AcqOverrunCnt++;
+         Payload->AcqNextCycleTime = CurrentTime;
+      }
+   }
+   else if (Payload->CycleRowCnt == 0)
+   {
+      /* Free-running with no detector data so wait for a command or the idle timeout */
+      OS_BinSemTimedWait(Payload->AcqWakeSemId, Payload->AcqIdleMs);
+   }
+   
+   return true;
+
+} /* End PAYLOAD_AcqChildTask() */
+
+
 /******************************************************************************
 ** Functions: PAYLOAD_ManageData
 **
-** Reading detector data manage science files
+** Read each channel's detector data and manage its science files
 **
 ** Notes:
 **   1. This function is called every PL_MGR 'execution cycle' regardless of
 **      the power and payload state.
+**   2. A status reset requested by PAYLOAD_ResetStatus() is performed
+**      before the cycle. See prologue notes.
 **
 */
 void PAYLOAD_ManageData(void)
 {
 
-   Payload->PowerState = PL_SIM_LIB_ReadPowerState();
+   uint16 i;
    
-   if (Payload->PowerState == PL_SIM_LIB_Power_READY)
-   {   
-      if (PL_SIM_LIB_ReadDetector(&Payload->Detector))
-      {
+   if (__atomic_exchange_n(&Payload->ResetStatusReq, false, __ATOMIC_ACQUIRE))
+   {
+      ResetCycleStatus();
+   }
+   
+   Payload->CycleRowCnt = 0;
+   
+   for (i=0; i < Payload->ChannelCnt; i++)
+   {
+      ManageChannel(&Payload->Channel[i]);
+      Payload->CycleRowCnt += Payload->Channel[i].CycleRowCnt;
+   }
+   
+   SCI_STREAM_EndCycle();
 
-         DETECTOR_MON_CheckData(&Payload->Detector.Row); // EX1: Replace
-         // EX1: DETECTOR_MON_CheckDataEx1(&Payload->Detector.Row);
-           
-         if (Payload->Detector.ReadoutRow == 0)
-            SCI_FILE_WriteDetectorData(&Payload->Detector, SCI_FILE_FIRST_ROW);
-         else if (Payload->Detector.ReadoutRow >= (PL_SIM_LIB_DETECTOR_ROWS_PER_IMAGE-1))
-            SCI_FILE_WriteDetectorData(&Payload->Detector, SCI_FILE_LAST_ROW);
-         else
-            SCI_FILE_WriteDetectorData(&Payload->Detector, SCI_FILE_ROW);
-      
-      } /* End if read data */
+} /* End PAYLOAD_ManageData() */
+
+
+/******************************************************************************
+** Functions: PAYLOAD_ConfigSciFileCmd
+**
+** Set a channel's science file configuration parameters
+**
+** Note:
+**  1. This function must comply with the CMDMGR_CmdFuncPtr definition
+*/
+bool PAYLOAD_ConfigSciFileCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   const PL_MGR_ConfigSciFileCmd_Payload_t *ConfigCmd = CMDMGR_PAYLOAD_PTR(MsgPtr, PL_MGR_ConfigSciFile_t);
+   PAYLOAD_Channel_t *Channel = GetChannel(ConfigCmd->Channel, "Config science file");
+   bool RetStatus = false;
+   
+   if (Channel != NULL)
+   {
+      if (SCI_FILE_ValidConfig(&ConfigCmd->Config))
+      {
+         RetStatus = SCI_WRITER_Request(&Channel->SciWriter, SCI_WRITER_REQUEST_CONFIG, &ConfigCmd->Config);
+      }
    }
-   else
+   
+   return RetStatus;
+
+} /* End PAYLOAD_ConfigSciFileCmd() */
+
+
+/******************************************************************************
+** Functions: PAYLOAD_Powered
+**
+*/
+bool PAYLOAD_Powered(void)
+{
+
+   bool   Powered = false;
+   uint16 i;
+   
+   for (i=0; i < Payload->ChannelCnt; i++)
    {
-      /* Check whether transitioned from READY to non-READY state */
-      if (Payload->PrevPowerState == PL_SIM_LIB_Power_READY)
+      if (Payload->Channel[i].PowerState != PL_SIM_LIB_Power_OFF)
       {
-         if (Payload->SciFile.State == SCI_FILE_ENABLED)
-         {
-            CFE_EVS_SendEvent(PAYLOAD_SHUTDOWN_SCI_EID, CFE_EVS_EventType_ERROR, 
-                              "Terminating science data collection. Payload power transitioned from %s to %s",
-                              PL_SIM_LIB_GetPowerStateStr(Payload->PrevPowerState),
-                              PL_SIM_LIB_GetPowerStateStr(Payload->PowerState));
-            SCI_FILE_WriteDetectorData(&Payload->Detector, SCI_FILE_SHUTDOWN);
-         }
+         Powered = true;
       }
    }
    
-   Payload->PrevPowerState = Payload->PowerState;
+   return Powered;
 
-} /* End PAYLOAD_ManageData() */
+} /* End PAYLOAD_Powered() */
 
 
 /******************************************************************************
@@ -131,19 +324,35 @@ void PAYLOAD_ManageData(void)
 bool PAYLOAD_ResetDetectorCmd (void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
 {
 
+   const PL_MGR_Channel_Payload_t *ResetCmd = CMDMGR_PAYLOAD_PTR(MsgPtr, PL_MGR_ResetDetector_t);
+   PAYLOAD_Channel_t *Channel = GetChannel(ResetCmd->Channel, "Reset detector");
    bool RetStatus = false;
 
-   if (Payload->PowerState == PL_SIM_LIB_Power_READY)
+   if (Channel != NULL)
    {
-      PL_SIM_LIB_DetectorReset();
-      RetStatus = true;
+      
+      if (Channel->DetectorSource != PAYLOAD_DETECTOR_SIM)
+      {
+         CFE_EVS_SendEvent (PAYLOAD_RESET_DETECTOR_CMD_ERR_EID, CFE_EVS_EventType_ERROR, 
+                            "Reset detector cmd rejected. Channel %d is replayed and doesn't have detector electronics.",
+                            Channel->Id);
+      }
+      else if (Channel->PowerState == PL_SIM_LIB_Power_READY)
+      {
+         OS_MutSemTake(Payload->DetectorMutexId);
+         PL_SIM_LIB_DetectorReset();
+         OS_MutSemGive(Payload->DetectorMutexId);
+         OS_BinSemGive(Payload->AcqWakeSemId);
+         RetStatus = true;
+      
+      }  
+      else
+      { 
+         CFE_EVS_SendEvent (PAYLOAD_RESET_DETECTOR_CMD_ERR_EID, CFE_EVS_EventType_ERROR, 
+                            "Resetcommand cmd rejected. Payload must be in power READY state and it's in the %s state.",
+                            PL_SIM_LIB_GetPowerStateStr(Channel->PowerState));
+      }
    
-   }  
-   else
-   { 
-      CFE_EVS_SendEvent (PAYLOAD_RESET_DETECTOR_CMD_ERR_EID, CFE_EVS_EventType_ERROR, 
-                         "Resetcommand cmd rejected. Payload must be in power READY state and it's in the %s state.",
-                         PL_SIM_LIB_GetPowerStateStr(Payload->PowerState));
    }
    
    return RetStatus;
@@ -155,23 +364,33 @@ bool PAYLOAD_ResetDetectorCmd (void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr
 ** Function:  PAYLOAD_ResetStatus
 **
 ** Notes:
-**   1. All PAYLOAD state data is managed by commands so nothing to do except
-**      call owned objects
+**   1. All PAYLOAD state data is managed by commands so only the execution
+**      cycle statistics and the owned objects' status are reset. See the
+**      prologue notes for the tasks that reset them.
 ** 
 */
 void PAYLOAD_ResetStatus(void)
 {
 
-   DETECTOR_MON_ResetStatus();
-
-      
+   uint16 i;
+   
+   PERF_HIST_ResetStatus();
+   
+   for (i=0; i < Payload->ChannelCnt; i++)
+   {
+      SCI_WRITER_Request(&Payload->Channel[i].SciWriter, SCI_WRITER_REQUEST_RESET, NULL);
+   }
+   
+   __atomic_store_n(&Payload->ResetStatusReq, true, __ATOMIC_RELEASE);
+   OS_BinSemGive(Payload->AcqWakeSemId);
+   
 } /* End PAYLOAD_ResetStatus() */
 
 
 /******************************************************************************
 ** Functions: PAYLOAD_StartSciCmd
 **
-** Start collecting and saving payload detector data to a file.
+** Start collecting and saving a channel's detector data to a file.
 **
 ** Note:
 **  1. This function must comply with the CMDMGR_CmdFuncPtr definition
@@ -179,29 +398,41 @@ void PAYLOAD_ResetStatus(void)
 bool PAYLOAD_StartSciCmd (void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
 {
 
+   const PL_MGR_Channel_Payload_t *StartCmd = CMDMGR_PAYLOAD_PTR(MsgPtr, PL_MGR_StartSci_t);
+   PAYLOAD_Channel_t *Channel = GetChannel(StartCmd->Channel, "Start science");
    bool RetStatus = false;
    
-   if (Payload->PowerState == PL_SIM_LIB_Power_READY)
+   if (Channel != NULL)
    {
       
-      PL_SIM_LIB_DetectorOn();      
-      
-      if (SCI_FILE_Start() == true)
+      if (Channel->PowerState == PL_SIM_LIB_Power_READY)
       {
+         
+         if (Channel->DetectorSource == PAYLOAD_DETECTOR_SIM)
+         {
+            OS_MutSemTake(Payload->DetectorMutexId);
+            PL_SIM_LIB_DetectorOn();      
+            OS_MutSemGive(Payload->DetectorMutexId);
+         }
+         
+         if (SCI_WRITER_Request(&Channel->SciWriter, SCI_WRITER_REQUEST_START, NULL))
+         {
 
-         CFE_EVS_SendEvent (PAYLOAD_START_SCI_CMD_EID, CFE_EVS_EventType_INFORMATION, 
-                            "Start science data collection accepted");
+            OS_BinSemGive(Payload->AcqWakeSemId);
+            CFE_EVS_SendEvent (PAYLOAD_START_SCI_CMD_EID, CFE_EVS_EventType_INFORMATION, 
+                               "Start channel %d science data collection accepted", Channel->Id);
+         
+            RetStatus = true;
+         }
+      }  
+      else
+      { 
+      
+         CFE_EVS_SendEvent (PAYLOAD_START_SCI_CMD_ERR_EID, CFE_EVS_EventType_ERROR, 
+                            "Start channel %d science data collection rejected. Payload in %s state and not the READY power state",
+                            Channel->Id, PL_SIM_LIB_GetPowerStateStr(Channel->PowerState));
       
-         RetStatus = true;
       }
-   }  
-   else
-   { 
-   
-      CFE_EVS_SendEvent (PAYLOAD_START_SCI_CMD_ERR_EID, CFE_EVS_EventType_ERROR, 
-                         "Start science data collection rejected. Payload in %s state and not the READY power state",
-                        PL_SIM_LIB_GetPowerStateStr(Payload->PowerState));
-   
    }
    
    return RetStatus;
@@ -213,23 +444,491 @@ bool PAYLOAD_StartSciCmd (void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
 /******************************************************************************
 ** Functions: PAYLOAD_StopSciCmd
 **
-** Stop collecting and saving payload detector data to a file.
+** Stop collecting and saving a channel's detector data to a file.
 **
 ** Note:
 **  1. This function must comply with the CMDMGR_CmdFuncPtr definition
 */
 bool PAYLOAD_StopSciCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
 {
-   char EventStr[132];
+
+   const PL_MGR_Channel_Payload_t *StopCmd = CMDMGR_PAYLOAD_PTR(MsgPtr, PL_MGR_StopSci_t);
+   PAYLOAD_Channel_t *Channel = GetChannel(StopCmd->Channel, "Stop science");
+   bool RetStatus = false;
    
-   PL_SIM_LIB_DetectorOff();
-   SCI_FILE_Stop(EventStr, 132);
+   if (Channel != NULL)
+   {
+      
+      if (Channel->DetectorSource == PAYLOAD_DETECTOR_SIM)
+      {
+         OS_MutSemTake(Payload->DetectorMutexId);
+         PL_SIM_LIB_DetectorOff();
+         OS_MutSemGive(Payload->DetectorMutexId);
+      }
+      
+      RetStatus = SCI_WRITER_Request(&Channel->SciWriter, SCI_WRITER_REQUEST_STOP, NULL);
    
-   CFE_EVS_SendEvent (PAYLOAD_STOP_SCI_CMD_EID, CFE_EVS_EventType_INFORMATION, 
-                      "%s", EventStr);
-                            
-   return true;
+   }
+   
+   return RetStatus;
 
 } /* End PAYLOAD_StopSciCmd() */
 
 
+/******************************************************************************
+** Function: ConstructChannel
+**
+** Construct a channel's detector source and data path objects
+**
+** Notes:
+**   1. The channel's SCI_WRITER is constructed by the caller after all of the
+**      channels are constructed. See PAYLOAD_Constructor().
+**   2. pl_sim_lib simulates one detector so channels after channel 0 are
+**      always replayed.
+**
+*/
+static void ConstructChannel(PAYLOAD_Channel_t *Channel, INITBL_Class_t *IniTbl, uint16 Id)
+{
+
+   Channel->Id = Id;
+   
+   Channel->PowerState     = PL_SIM_LIB_Power_OFF;
+   Channel->PrevPowerState = PL_SIM_LIB_Power_OFF;
+   
+   if (Id == 0)
+   {
+      Channel->DetectorSource = INITBL_GetIntConfig(IniTbl, CFG_PAYLOAD_DETECTOR_SOURCE);
+      if (Channel->DetectorSource != PAYLOAD_DETECTOR_SIM && Channel->DetectorSource != PAYLOAD_DETECTOR_REPLAY)
+      {
+         CFE_EVS_SendEvent (PAYLOAD_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR,
+                            "Invalid detector source %d, using the simulator", Channel->DetectorSource);
+         Channel->DetectorSource = PAYLOAD_DETECTOR_SIM;
+      }
+   }
+   else
+   {
+      Channel->DetectorSource = PAYLOAD_DETECTOR_REPLAY;
+   }
+   
+   if (Channel->DetectorSource == PAYLOAD_DETECTOR_REPLAY)
+   {
+      DETECTOR_REPLAY_Constructor(&Channel->DetectorReplay, IniTbl, Id);
+   }
+   
+   SCI_FILE_Constructor(&Channel->SciFile, IniTbl, Id);
+   DETECTOR_MON_Constructor(&Channel->DetectorMon);
+   IMG_STATS_Constructor(&Channel->ImgStats, IniTbl, Id);
+
+} /* End ConstructChannel() */
+
+
+/******************************************************************************
+** Function: DispatchImage
+**
+** Queue the channel's image to its SCI_WRITER and dispatch it to a worker
+**
+** Notes:
+**   1. The image is queued to the writer first so the writer commits it in
+**      the order it was read. If the writer's queue is full the image is
+**      dropped and the writer's overflow counter is incremented.
+**
+*/
+static void DispatchImage(PAYLOAD_Channel_t *Channel)
+{
+
+   if (SCI_WRITER_EnqueueImage(&Channel->SciWriter, Channel->Image))
+   {
+      IMG_POOL_Dispatch(Channel->Image);
+   }
+   else
+   {
+      IMG_POOL_FreeImage(Channel->Image);
+   }
+   
+   Channel->Image = NULL;
+
+} /* End DispatchImage() */
+
+
+/******************************************************************************
+** Function: GatherDetectorRow
+**
+** Add the detector row that was just read to the channel's image
+**
+** Notes:
+**   1. An incomplete image is dispatched when the next image's first row
+**      is read.
+**   2. The row is dropped if an image buffer can't be allocated.
+**
+*/
+static void GatherDetectorRow(PAYLOAD_Channel_t *Channel, SCI_FILE_Control_t Control)
+{
+
+   if (Channel->Image != NULL && Control == SCI_FILE_FIRST_ROW)
+   {
+      DispatchImage(Channel);
+   }
+   
+   if (Channel->Image == NULL)
+   {
+      Channel->Image = IMG_POOL_AllocImage(&Channel->DetectorMon, &Channel->ImgStats,
+                                           &Channel->SciFile, Channel->SciWriter.WakeSemId);
+   }
+   
+   if (Channel->Image != NULL)
+   {
+      IMG_POOL_AddRow(Channel->Image, &Channel->Detector);
+      if (Control == SCI_FILE_LAST_ROW)
+      {
+         DispatchImage(Channel);
+      }
+   }
+
+} /* End GatherDetectorRow() */
+
+
+/******************************************************************************
+** Function: GetChannel
+**
+** Return a pointer to a command's channel or NULL if the channel is invalid
+**
+** Notes:
+**   1. An error event is sent if the channel is invalid.
+**
+*/
+static PAYLOAD_Channel_t *GetChannel(uint16 Id, const char *CmdName)
+{
+
+   PAYLOAD_Channel_t *Channel = NULL;
+   
+   if (Id < Payload->ChannelCnt)
+   {
+      Channel = &Payload->Channel[Id];
+   }
+   else
+   {
+      CFE_EVS_SendEvent (PAYLOAD_INVALID_CHANNEL_EID, CFE_EVS_EventType_ERROR, 
+                         "%s command rejected. Channel %d must be less than the channel count %d",
+                         CmdName, Id, Payload->ChannelCnt);
+   }
+   
+   return Channel;
+
+} /* End GetChannel() */
+
+
+/******************************************************************************
+** Function: ManageChannel
+**
+** Read a channel's detector data and manage its science files
+**
+** Notes:
+**   1. Only the channel's objects and the shared objects described in the
+**      header prologue are used so channels are independent.
+**
+*/
+static void ManageChannel(PAYLOAD_Channel_t *Channel)
+{
+
+   bool      ReadDetector = true;
+   bool      ShutdownQueued = true;
+   bool      RowRead;
+   SCI_FILE_Status_t SciFileStatus;
+   OS_time_t StartTime;
+   OS_time_t CurrentTime;
+   OS_time_t StageTime;
+   
+   OS_MutSemTake(Payload->DetectorMutexId);
+   Channel->PowerState = ReadPowerState(Channel);
+   OS_MutSemGive(Payload->DetectorMutexId);
+   
+   Channel->CycleRowCnt = 0;
+   
+   if (Channel->PowerState == PL_SIM_LIB_Power_READY)
+   {   
+      
+      CFE_PSP_GetTime(&StartTime);
+      
+      while (ReadDetector)
+      {
+      
+         OS_MutSemTake(Payload->DetectorMutexId);
+         PERF_HIST_Start(&StageTime);
+         RowRead = ReadDetectorRow(Channel);
+         PERF_HIST_Stop(PERF_HIST_READ_DETECTOR, &StageTime);
+         OS_MutSemGive(Payload->DetectorMutexId);
+         
+         if (RowRead)
+         {
+            
+            if (Channel->CycleLimited)
+            {
+               Channel->CycleLimitCnt++;
+               Channel->CycleLimited = false;
+            }
+            
+            ProcessDetectorRow(Channel);
+            Channel->CycleRowCnt++;
+            
+            CFE_PSP_GetTime(&CurrentTime);
+            if ((Channel->CycleRowCnt >= Payload->CycleRowLim) ||
+                (Payload->CycleUsecLim > 0 &&
+                 OS_TimeGetTotalMicroseconds(OS_TimeSubtract(CurrentTime, StartTime)) >= Payload->CycleUsecLim))
+            {
+               Channel->CycleLimited = true;
+               ReadDetector = false;
+            }
+         
+         }
+         else
+         {
+            Channel->CycleLimited = false;
+            ReadDetector = false;
+         }
+      
+      } /* End while reading detector */
+      
+      Channel->RowCnt += Channel->CycleRowCnt;
+      if (Channel->CycleRowCnt > Channel->CycleRowCntMax)
+      {
+         Channel->CycleRowCntMax = Channel->CycleRowCnt;
+      }
+      
+   }
+   else
+   {
+      Channel->CycleLimited = false;
+      
+      if (Channel->Image != NULL)
+      {
+         DispatchImage(Channel);
+      }
+      
+      /* Check whether transitioned from READY to non-READY state */
+      if (Channel->PrevPowerState == PL_SIM_LIB_Power_READY)
+      {
+         SCI_FILE_GetStatus(&Channel->SciFile, &SciFileStatus);
+         if (SciFileStatus.State == SCI_FILE_ENABLED)
+         {
+            if (SCI_WRITER_Enqueue(&Channel->SciWriter, &Channel->Detector, SCI_FILE_SHUTDOWN, false))
+            {
+               CFE_EVS_SendEvent(PAYLOAD_SHUTDOWN_SCI_EID, CFE_EVS_EventType_ERROR, 
+                                 "Terminating channel %d science data collection. Payload power transitioned from %s to %s",
+                                 Channel->Id,
+                                 PL_SIM_LIB_GetPowerStateStr(Channel->PrevPowerState),
+                                 PL_SIM_LIB_GetPowerStateStr(Channel->PowerState));
+            }
+            else
+            {
+               ShutdownQueued = false;
+            }
+         }
+      }
+   }
+   
+   /* A shutdown that couldn't be queued is retried next cycle */
+   Channel->PrevPowerState = ShutdownQueued ? Channel->PowerState : PL_SIM_LIB_Power_READY;
+
+} /* End ManageChannel() */
+
+
+/******************************************************************************
+** Function: ProcessDetectorRow
+**
+** Check the detector row that was just read, add it to the image statistics
+** and the science stream, and queue it to be written to the science file.
+**
+** Notes:
+**   1. When the IMG_POOL is enabled the row is gathered into an image and
+**      the image is checked, added to the statistics and written by the
+**      pipeline. See prologue notes.
+**
+*/
+static void ProcessDetectorRow(PAYLOAD_Channel_t *Channel)
+{
+
+   SCI_FILE_Control_t Control = SCI_FILE_GetRowControl(&Channel->Detector);
+   bool      RowFault;
+   OS_time_t StageTime;
+   
+   if (IMG_POOL_Enabled())
+   {
+      GatherDetectorRow(Channel, Control);
+      SCI_STREAM_AddRow(Channel->Id, &Channel->Detector, (Control == SCI_FILE_LAST_ROW));
+   }
+   else
+   {
+      
+      PERF_HIST_Start(&StageTime);
+      RowFault = !DETECTOR_MON_CheckData(&Channel->DetectorMon, &Channel->Detector.Row); // EX1: Replace
+      // EX1: RowFault = !DETECTOR_MON_CheckDataEx1(&Channel->DetectorMon, &Channel->Detector.Row);
+      PERF_HIST_Stop(PERF_HIST_CHECK_DATA, &StageTime);
+     
+      IMG_STATS_AddRow(&Channel->ImgStats, &Channel->Detector, (Control == SCI_FILE_FIRST_ROW), (Control == SCI_FILE_LAST_ROW));
+      SCI_STREAM_AddRow(Channel->Id, &Channel->Detector, (Control == SCI_FILE_LAST_ROW));
+      SCI_WRITER_Enqueue(&Channel->SciWriter, &Channel->Detector, Control, RowFault);
+   
+   }
+
+} /* End ProcessDetectorRow() */
+
+
+/******************************************************************************
+** Function: ReadDetectorRow
+**
+** Read a detector row from the channel's detector source
+**
+** Notes:
+**   1. The caller must hold the detector mutex.
+**
+*/
+static bool ReadDetectorRow(PAYLOAD_Channel_t *Channel)
+{
+
+   bool RowRead;
+   
+   if (Channel->DetectorSource == PAYLOAD_DETECTOR_REPLAY)
+   {
+      RowRead = DETECTOR_REPLAY_ReadDetector(&Channel->DetectorReplay, &Channel->Detector);
+   }
+   else
+   {
+      RowRead = PL_SIM_LIB_ReadDetector(&Channel->Detector);
+   }
+   
+   return RowRead;
+
+} /* End ReadDetectorRow() */
+
+
+/******************************************************************************
+** Function: ReadPowerState
+**
+** Read the payload power state from the channel's detector source
+**
+** Notes:
+**   1. The caller must hold the detector mutex.
+**
+*/
+static PL_SIM_LIB_Power_Enum_t ReadPowerState(PAYLOAD_Channel_t *Channel)
+{
+
+   PL_SIM_LIB_Power_Enum_t PowerState;
+   
+   if (Channel->DetectorSource == PAYLOAD_DETECTOR_REPLAY)
+   {
+      PowerState = DETECTOR_REPLAY_ReadPowerState(&Channel->DetectorReplay);
+   }
+   else
+   {
+      PowerState = PL_SIM_LIB_ReadPowerState();
+   }
+   
+   return PowerState;
+
+} /* End ReadPowerState() */
+
+
+/******************************************************************************
+** Function: ResetCycleStatus
+**
+** Reset the status that's updated by the acquisition task
+**
+** Notes:
+**   1. Only called by the acquisition task. See prologue notes.
+**   2. When IMG_POOL is enabled the detector monitor and image statistics
+**      are updated by the SCI_WRITER child task which resets them.
+**
+*/
+static void ResetCycleStatus(void)
+{
+
+   uint16 i;
+   PAYLOAD_Channel_t *Channel;
+   
+   Payload->AcqCycleCnt     = 0;
+   Payload->AcqOverrunCnt   = 0;
+   Payload->AcqCycleUsecMax = 0;
+   
+   SCI_STREAM_ResetStatus();
+   IMG_POOL_ResetStatus();
+   
+   for (i=0; i < Payload->ChannelCnt; i++)
+   {
+      
+      Channel = &Payload->Channel[i];
+      
+      Channel->CycleRowCntMax = 0;
+      Channel->CycleLimitCnt  = 0;
+      Channel->RowCnt         = 0;
+   
+      if (!IMG_POOL_Enabled())
+      {
+         DETECTOR_MON_ResetStatus(&Channel->DetectorMon);
+         IMG_STATS_ResetStatus(&Channel->ImgStats);
+      }
+      SCI_WRITER_ResetStatus(&Channel->SciWriter);
+   
+   }
+
+} /* End ResetCycleStatus() */
+
+
+/******************************************************************************
+** Function: ResumeChannel
+**
+** Resume a channel's science data collection after a restart
+**
+** Notes:
+**   1. Only resumed when the channel's SCI_FILE restored a checkpoint that
+**      was collecting. See prologue notes.
+**
+*/
+static void ResumeChannel(PAYLOAD_Channel_t *Channel)
+{
+
+   if (Channel->SciFile.State == SCI_FILE_ENABLED)
+   {
+      
+      if (Channel->DetectorSource == PAYLOAD_DETECTOR_SIM)
+      {
+         PL_SIM_LIB_DetectorOn();
+      }
+      
+      Channel->PrevPowerState = PL_SIM_LIB_Power_READY;
+      
+      CFE_EVS_SendEvent (PAYLOAD_RESUME_SCI_EID, CFE_EVS_EventType_INFORMATION, 
+                         "Resumed channel %d science data collection after a restart", Channel->Id);
+   
+   }
+
+} /* End ResumeChannel() */
+
+
+/******************************************************************************
+** Function: UpdateAcqRate
+**
+** Update the acquisition cycle and row rates once per second.
+**
+*/
+static void UpdateAcqRate(const OS_time_t *CurrentTime)
+{
+
+   int64 ElapsedUsec = OS_TimeGetTotalMicroseconds(OS_TimeSubtract(*CurrentTime, Payload->AcqRateStartTime));
+
+   Payload->AcqRateCycleCnt++;
+   Payload->AcqRateRowCnt += Payload->CycleRowCnt;
+   
+   if (ElapsedUsec >= 1000000)
+   {
+      
+      Payload->AcqCycleRate = (uint16)((Payload->AcqRateCycleCnt * 1000000LL) / ElapsedUsec);
+      Payload->AcqRowRate   = (uint16)((Payload->AcqRateRowCnt * 1000000LL) / ElapsedUsec);
+      
+      Payload->AcqRateStartTime = *CurrentTime;
+      Payload->AcqRateCycleCnt  = 0;
+      Payload->AcqRateRowCnt    = 0;
+   
+   }
+
+} /* End UpdateAcqRate() */
@@ -28,6 +28,60 @@
 **       Commands are used to start/stop science data file management. An 
 **       alternative design would be a data driven one where the science
 **       files would be generated whenever the detector ouptputs data.
+**    4. Each execution cycle detector rows are read until the detector has
+**       no more data or the cycle's row or time limit is reached. The limits
+**       are defined in the JSON init file and a time limit of 0 is
+**       unlimited. A channel's CycleLimitCnt counts the cycles whose limit
+**       deferred rows, i.e. the next cycle's first read had a row.
+**    5. Detector data is acquired by a child task that executes a cycle
+**       every ACQ_PERIOD_MS milliseconds. A period of 0 free-runs the task
+**       against the detector. When a free-running cycle reads no rows the
+**       task blocks on a wake semaphore for up to ACQ_IDLE_MS milliseconds.
+**       The detector has no data ready notification so the timeout paces
+**       the polling, and the start science, reset detector and reset status
+**       commands give the semaphore so they're acted on immediately. The
+**       PL_MGR main task only processes commands and telemetry. A mutex
+**       serializes the detector interface calls made by the child task and
+**       by commands.
+**    6. The PAYLOAD_DETECTOR_SOURCE init file parameter selects whether
+**       channel 0's power state and detector rows are read from pl_sim_lib
+**       or replayed from a capture file by DETECTOR_REPLAY. Detector on,
+**       off and reset commands are only sent to pl_sim_lib for a channel
+**       whose source is the simulator. A replayed channel has no detector
+**       electronics so its reset command is rejected.
+**    7. The payload has PAYLOAD_CHANNEL_CNT detector channels. Each channel
+**       has its own detector state, monitor, image statistics, science file
+**       and science file writer so a channel is processed without using
+**       another channel's data. pl_sim_lib simulates one detector so
+**       channels after channel 0 are always replayed. Commands that act on
+**       a detector or its science files have a channel parameter.
+**    8. The acquisition child task reads each channel's detector in turn
+**       and each channel's SCI_WRITER child task writes its science files
+**       so file writes and encoding for different channels run
+**       concurrently. The performance histograms and the science stream
+**       are shared by all of the channels.
+**    9. When the IMG_POOL worker pool is enabled the acquisition task only
+**       reads rows, streams them and gathers them into whole images. Each
+**       image is queued to the channel's SCI_WRITER before it's dispatched
+**       to a worker so the writer commits the images in the order they
+**       were read. An incomplete image is dispatched when the next image's
+**       first row is read or when the detector leaves the READY state.
+**   10. The science file catalog and retention objects are shared by all
+**       of the channels. Each channel's science files are added to them
+**       when they're closed and the retention quotas apply to all of the
+**       channels' files.
+**   11. Status counters are only modified by the task that updates them.
+**       PAYLOAD_ResetStatus() sets a request flag that the acquisition task
+**       consumes at the start of its next cycle. The SCI_FILE status and,
+**       when IMG_POOL is enabled, the detector monitor and image statistics
+**       counters are reset by the SCI_WRITER child task. The performance
+**       histograms are shared by these tasks so they're reset directly
+**       with atomic stores.
+**   12. A channel's SCI_FILE resumes science data collection after a
+**       restart when its Critical Data Store checkpoint was collecting. The
+**       channel is resumed as though it was in the READY power state so
+**       collection is shut down by the first cycle if the detector isn't
+**       READY. A simulated detector is turned on when it's resumed.
 **
 **  References:
 **    1. OpenSatKit Object-based Application Developer's Guide
@@ -44,7 +98,15 @@
 #include "app_cfg.h"
 #include "pl_sim_lib.h"  /* See prologue notes */
 #include "sci_file.h"
+#include "sci_writer.h"
 #include "detector_mon.h"
+#include "img_stats.h"
+#include "sci_stream.h"
+#include "perf_hist.h"
+#include "detector_replay.h"
+#include "img_pool.h"
+#include "sci_catalog.h"
+#include "sci_retain.h"
 
 /***********************/
 /** Macro Definitions **/
@@ -60,11 +122,58 @@
 #define PAYLOAD_STOP_SCI_CMD_ERR_EID       (PAYLOAD_BASE_EID + 3)
 #define PAYLOAD_SHUTDOWN_SCI_EID           (PAYLOAD_BASE_EID + 4)
 #define PAYLOAD_RESET_DETECTOR_CMD_ERR_EID (PAYLOAD_BASE_EID + 5)
+#define PAYLOAD_CONSTRUCTOR_EID            (PAYLOAD_BASE_EID + 6)
+#define PAYLOAD_INVALID_CHANNEL_EID        (PAYLOAD_BASE_EID + 7)
+#define PAYLOAD_RESUME_SCI_EID             (PAYLOAD_BASE_EID + 8)
 
 /**********************/
 /** Type Definitions **/
 /**********************/
 
+typedef enum
+{
+
+   PAYLOAD_DETECTOR_SIM    = 1,
+   PAYLOAD_DETECTOR_REPLAY = 2
+
+} PAYLOAD_DetectorSource_t;
+
+
+
+/******************************************************************************
+** Detector Channel
+*/
+
+typedef struct
+{
+
+   uint16  Id;
+   
+   PAYLOAD_DetectorSource_t DetectorSource;
+   PL_SIM_LIB_Power_Enum_t  PowerState;
+   PL_SIM_LIB_Power_Enum_t  PrevPowerState;
+   PL_SIM_LIB_Detector_t    Detector;
+   
+   /*
+   ** Execution cycle statistics
+   */
+   
+   uint16  CycleRowCnt;      /* Rows read during the last cycle */
+   uint16  CycleRowCntMax;
+   uint16  CycleLimitCnt;    /* Cycles whose row or time limit deferred rows */
+   bool    CycleLimited;     /* Last cycle was terminated by a limit */
+   uint32  RowCnt;
+   
+   IMG_POOL_Image_t       *Image;     /* Image being gathered, see prologue */
+   
+   SCI_FILE_Class_t        SciFile;
+   SCI_WRITER_Class_t      SciWriter;
+   DETCTOR_MON_Class_t     DetectorMon;
+   IMG_STATS_Class_t       ImgStats;
+   DETECTOR_REPLAY_Class_t DetectorReplay;
+
+} PAYLOAD_Channel_t;
+
 
 /******************************************************************************
 ** PL_MGR Class
@@ -73,12 +182,45 @@
 typedef struct
 {
    
-   PL_SIM_LIB_Power_Enum_t PowerState;
-   PL_SIM_LIB_Power_Enum_t PrevPowerState;
-   PL_SIM_LIB_Detector_t   Detector;
+   CHILDMGR_Class_t  AcqChildMgr;
+   osal_id_t         DetectorMutexId;
+   osal_id_t         AcqWakeSemId;
+   bool              ResetStatusReq;   /* See prologue notes */
+   
+   /*
+   ** Acquisition task timing and statistics
+   */
+   
+   uint32     AcqPeriodMs;
+   uint32     AcqIdleMs;
+   OS_time_t  AcqNextCycleTime;
+   OS_time_t  AcqRateStartTime;
+   uint32     AcqRateCycleCnt;
+   uint32     AcqRateRowCnt;
+   
+   uint32  AcqCycleCnt;
+   uint16  AcqOverrunCnt;
+   uint16  AcqCycleRate;    /* Cycles per second measured over the last second */
+   uint16  AcqRowRate;      /* Rows per second measured over the last second   */
+   uint32  AcqCycleUsec;    /* Execution time of the last cycle                */
+   uint32  AcqCycleUsecMax;
+   
+   /*
+   ** Execution cycle row limits, applied to each channel
+   */
+   
+   uint16  CycleRowLim;
+   uint32  CycleUsecLim;     /* 0 is unlimited */
+   uint16  CycleRowCnt;      /* Rows read from all channels during the last cycle */
+   
+   PERF_HIST_Class_t    PerfHist;
+   SCI_STREAM_Class_t   SciStream;
+   IMG_POOL_Class_t     ImgPool;
+   SCI_CATALOG_Class_t  SciCatalog;
+   SCI_RETAIN_Class_t   SciRetain;
    
-   SCI_FILE_Class_t    SciFile;
-   DETCTOR_MON_Class_t DetectorMon;
+   uint16              ChannelCnt;
+   PAYLOAD_Channel_t   Channel[PAYLOAD_CHANNEL_MAX];
 
 } PAYLOAD_Class_t;
 
@@ -100,15 +242,62 @@ typedef struct
 void PAYLOAD_Constructor(PAYLOAD_Class_t *PayloadPtr, INITBL_Class_t *IniTbl);
 
 
+/******************************************************************************
+** Function: PAYLOAD_AcqChildTask
+**
+** Execute one acquisition cycle and wait for the next cycle.
+**
+** Notes:
+**   1. This function must comply with the CHILDMGR callback definition.
+**   2. See prologue notes for acquisition timing.
+**
+*/
+bool PAYLOAD_AcqChildTask(CHILDMGR_Class_t *ChildMgr);
+
+
 /******************************************************************************
 ** Function: PAYLOAD_ManageData
 **
-** Execute a single simulation step.
+** Read and process detector data for one execution cycle.
+**
+** Notes:
+**   1. Called by the acquisition child task.
+**   2. Detector data is queued for the SCI_WRITER child task or gathered
+**      into images for the IMG_POOL workers. No science file I/O is
+**      performed in the caller's context.
+**   3. See prologue notes for the number of rows read each cycle.
+**   4. Each channel is processed by ManageChannel() which only uses the
+**      channel's objects and the shared objects described in the
+**      prologue notes.
 **
 */
 void PAYLOAD_ManageData(void);
 
 
+/******************************************************************************
+** Function: PAYLOAD_ConfigSciFileCmd
+**
+** Set a channel's science file configuration parameters
+**
+** Notes:
+**  1. This function must comply with the CMDMGR_CmdFuncPtr definition
+**  2. See SCI_FILE_Config() for when the configuration is applied.
+**  3. The configuration is validated by the command and applied by the
+**     channel's SCI_WRITER child task. See sci_writer.h prologue notes.
+**
+*/
+bool PAYLOAD_ConfigSciFileCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: PAYLOAD_Powered
+**
+** Return true if any channel's detector is not in the power OFF state
+**
+*/
+bool PAYLOAD_Powered(void);
+
+
 /******************************************************************************
 ** Functions: PAYLOAD_ResetDetectorCmd
 **
@@ -119,6 +308,8 @@ void PAYLOAD_ManageData(void);
 **  2. Reset allows an intermediate level of initialization to be simulated
 **     that allows some system state to persist across the reset. For
 **     science data may be allowed to resume immediately after a reset.
+**  3. Replayed channels don't have detector electronics so the command
+**     is rejected for them.
 **
 */
 bool PAYLOAD_ResetDetectorCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
@@ -132,6 +323,8 @@ bool PAYLOAD_ResetDetectorCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
 ** Notes:
 **   1. Any counter or variable that is reported in HK telemetry that doesn't
 **      change the functional behavior should be reset.
+**   2. The counters are reset by the tasks that update them so they may not
+**      be reset when this returns. See prologue notes.
 **
 */
 void PAYLOAD_ResetStatus(void);
@@ -160,6 +353,9 @@ bool PAYLOAD_StartSciCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
 **  1. This function must comply with the CMDMGR_CmdFuncPtr definition
 **  2. Use separate command function codes & functions as opposed to one 
 **     command with a parameter that would need validation
+**  3. The files are closed by the channel's SCI_WRITER child task after
+**     the rows read before the command are written and the child task
+**     reports the result. See sci_writer.h prologue notes.
 **
 */
 bool PAYLOAD_StopSciCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
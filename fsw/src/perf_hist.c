@@ -0,0 +1,195 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the data path performance histogram object
+**
+**  Notes:
+**    None
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include "app_cfg.h"
+#include "perf_hist.h"
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static PERF_HIST_Class_t *PerfHist = NULL;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void LoadStage(PL_MGR_PerfStage_t *TlmStage, PERF_HIST_Stage_t Stage);
+
+
+/******************************************************************************
+** Function: PERF_HIST_Constructor
+**
+*/
+void PERF_HIST_Constructor(PERF_HIST_Class_t *PerfHistPtr, INITBL_Class_t *IniTbl)
+{
+
+   PerfHist = PerfHistPtr;
+
+   CFE_PSP_MemSet((void*)PerfHist, 0, sizeof(PERF_HIST_Class_t));
+
+   CFE_MSG_Init(CFE_MSG_PTR(PerfHist->PerfTlm.TelemetryHeader), 
+                CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_PL_MGR_PERF_TLM_TOPICID)),
+                sizeof(PL_MGR_PerfTlm_t));
+
+} /* End PERF_HIST_Constructor() */
+
+
+/******************************************************************************
+** Function: PERF_HIST_ResetStatus
+**
+** Notes:
+**   1. A stage update that overlaps the reset may be partially counted.
+**
+*/
+void PERF_HIST_ResetStatus(void)
+{
+
+   uint16 Stage;
+   uint16 Bin;
+   PL_MGR_PerfStage_t *PerfStage;
+   
+   for (Stage=0; Stage < PERF_HIST_STAGE_CNT; Stage++)
+   {
+      PerfStage = &PerfHist->Stage[Stage];
+      __atomic_store_n(&PerfStage->Cnt, 0, __ATOMIC_RELAXED);
+      __atomic_store_n(&PerfStage->MaxUsec, 0, __ATOMIC_RELAXED);
+      for (Bin=0; Bin < PERF_HIST_BINS; Bin++)
+      {
+         __atomic_store_n(&PerfStage->Hist[Bin], 0, __ATOMIC_RELAXED);
+      }
+   }
+
+} /* End PERF_HIST_ResetStatus() */
+
+
+/******************************************************************************
+** Function: PERF_HIST_SendTlm
+**
+*/
+void PERF_HIST_SendTlm(void)
+{
+
+   PL_MGR_PerfTlm_Payload_t *Payload = &PerfHist->PerfTlm.Payload;
+   
+   LoadStage(&Payload->ReadDetector, PERF_HIST_READ_DETECTOR);
+   LoadStage(&Payload->CheckData,    PERF_HIST_CHECK_DATA);
+   LoadStage(&Payload->WriteData,    PERF_HIST_WRITE_DATA);
+   LoadStage(&Payload->CreateFile,   PERF_HIST_CREATE_FILE);
+   LoadStage(&Payload->CloseFile,    PERF_HIST_CLOSE_FILE);
+   LoadStage(&Payload->SyncFile,     PERF_HIST_SYNC_FILE);
+   
+   CFE_SB_TimeStampMsg(CFE_MSG_PTR(PerfHist->PerfTlm.TelemetryHeader));
+   CFE_SB_TransmitMsg(CFE_MSG_PTR(PerfHist->PerfTlm.TelemetryHeader), true);
+
+} /* End PERF_HIST_SendTlm() */
+
+
+/******************************************************************************
+** Function: PERF_HIST_Start
+**
+*/
+void PERF_HIST_Start(OS_time_t *StartTime)
+{
+
+   CFE_PSP_GetTime(StartTime);
+
+} /* End PERF_HIST_Start() */
+
+
+/******************************************************************************
+** Function: PERF_HIST_Stop
+**
+** Notes:
+**   1. The bin is the number of significant bits in the microsecond time.
+**      A negative time from a PSP time adjustment is counted in bin 0. See
+**      the header prologue.
+**   2. A failed compare and exchange reloads MaxUsec so the loop ends when
+**      this time or a longer time has been stored.
+**
+*/
+void PERF_HIST_Stop(PERF_HIST_Stage_t Stage, const OS_time_t *StartTime)
+{
+
+   OS_time_t CurrentTime;
+   int64     Usec;
+   uint32    StageUsec = 0;
+   uint32    Bin = 0;
+   uint32    MaxUsec;
+   PL_MGR_PerfStage_t *PerfStage = &PerfHist->Stage[Stage];
+   
+   CFE_PSP_GetTime(&CurrentTime);
+   Usec = OS_TimeGetTotalMicroseconds(OS_TimeSubtract(CurrentTime, *StartTime));
+   
+   if (Usec > 0)
+   {
+      StageUsec = (Usec > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32)Usec;
+      Bin = 32 - __builtin_clz(StageUsec);
+      if (Bin >= PERF_HIST_BINS)
+      {
+         Bin = PERF_HIST_BINS - 1;
+      }
+   }
+   
+   __atomic_fetch_add(&PerfStage->Cnt, 1, __ATOMIC_RELAXED);
+   __atomic_fetch_add(&PerfStage->Hist[Bin], 1, __ATOMIC_RELAXED);
+   MaxUsec = __atomic_load_n(&PerfStage->MaxUsec, __ATOMIC_RELAXED);
+   while (StageUsec > MaxUsec &&
+          !__atomic_compare_exchange_n(&PerfStage->MaxUsec, &MaxUsec, StageUsec, false,
+                                       __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+   {
+      /* MaxUsec was reloaded with the stored value, see notes */
+   }
+
+} /* End PERF_HIST_Stop() */
+
+
+/******************************************************************************
+** Function: LoadStage
+**
+** Load a telemetry stage with a stage's statistics using atomic loads
+**
+*/
+static void LoadStage(PL_MGR_PerfStage_t *TlmStage, PERF_HIST_Stage_t Stage)
+{
+
+   uint16 Bin;
+   PL_MGR_PerfStage_t *PerfStage = &PerfHist->Stage[Stage];
+   
+   TlmStage->Cnt     = __atomic_load_n(&PerfStage->Cnt, __ATOMIC_RELAXED);
+   TlmStage->MaxUsec = __atomic_load_n(&PerfStage->MaxUsec, __ATOMIC_RELAXED);
+   for (Bin=0; Bin < PERF_HIST_BINS; Bin++)
+   {
+      TlmStage->Hist[Bin] = __atomic_load_n(&PerfStage->Hist[Bin], __ATOMIC_RELAXED);
+   }
+
+} /* End LoadStage() */
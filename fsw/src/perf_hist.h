@@ -0,0 +1,149 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the data path performance histogram object
+**
+**  Notes:
+**    1. Each data path stage has an execution count, a maximum execution
+**       time and a histogram of execution times. Histogram bin 0 counts
+**       times less than 1 microsecond and bin i counts times from 2^(i-1)
+**       up to 2^i microseconds. The last bin also counts all longer times.
+**    2. Times are measured with the PSP's local time, CFE_PSP_GetTime(),
+**       like PL_MGR's other interval timing so a stage costs two clock
+**       reads and a few integer operations. The PSP doesn't guarantee the
+**       time is monotonic so a time that goes backwards is counted as 0
+**       microseconds. The instrumentation is always enabled.
+**    3. The file stages are timed by every detector channel's SCI_WRITER
+**       child task so the statistics are updated, reset and reported with
+**       atomic operations rather than a mutex. A telemetry packet or reset
+**       may overlap a stage update that is in progress, which is
+**       acceptable for performance data.
+**    4. The performance telemetry packet is owned by this object and is
+**       sent by the app's main task.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _perf_hist_
+#define _perf_hist_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define PERF_HIST_BINS  20   /* Must match EDS PerfHistogram dimension */
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef enum
+{
+
+   PERF_HIST_READ_DETECTOR = 0,
+   PERF_HIST_CHECK_DATA    = 1,
+   PERF_HIST_WRITE_DATA    = 2,
+   PERF_HIST_CREATE_FILE   = 3,
+   PERF_HIST_CLOSE_FILE    = 4,
+   PERF_HIST_SYNC_FILE     = 5,
+   PERF_HIST_STAGE_CNT     = 6
+   
+} PERF_HIST_Stage_t;
+
+
+/******************************************************************************
+** PERF_HIST_Class
+*/
+
+typedef struct
+{
+
+   PL_MGR_PerfStage_t Stage[PERF_HIST_STAGE_CNT];
+   
+   PL_MGR_PerfTlm_t   PerfTlm;
+
+} PERF_HIST_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: PERF_HIST_Constructor
+**
+** Initialize the performance histogram object to a known state
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**
+*/
+void PERF_HIST_Constructor(PERF_HIST_Class_t *PerfHistPtr, INITBL_Class_t *IniTbl);
+
+
+/******************************************************************************
+** Function: PERF_HIST_ResetStatus
+**
+** Reset counters and status flags to a known reset state.
+**
+** Notes:
+**   1. Any counter or variable that is reported in HK telemetry that doesn't
+**      change the functional behavior should be reset.
+**   2. The statistics are reset with atomic stores so this can be called
+**      while other tasks are timing stages. See prologue notes.
+**
+*/
+void PERF_HIST_ResetStatus(void);
+
+
+/******************************************************************************
+** Function: PERF_HIST_SendTlm
+**
+** Send the performance telemetry packet
+**
+*/
+void PERF_HIST_SendTlm(void);
+
+
+/******************************************************************************
+** Function: PERF_HIST_Start
+**
+** Load StartTime with the start time of a stage execution
+**
+*/
+void PERF_HIST_Start(OS_time_t *StartTime);
+
+
+/******************************************************************************
+** Function: PERF_HIST_Stop
+**
+** Add the time since StartTime to a stage's statistics
+**
+*/
+void PERF_HIST_Stop(PERF_HIST_Stage_t Stage, const OS_time_t *StartTime);
+
+
+#endif /* _perf_hist_ */
@@ -41,7 +41,9 @@
 #define  INITBL_OBJ   (&(PlMgr.IniTbl))
 #define  CMDMGR_OBJ   (&(PlMgr.CmdMgr))
 #define  PAYLOAD_OBJ  (&(PlMgr.Payload))
-#define  SCI_FILE_OBJ (&(PlMgr.Payload.SciFile))
+#define  SCI_STREAM_OBJ (&(PlMgr.Payload.SciStream))
+#define  SCI_CATALOG_OBJ (&(PlMgr.Payload.SciCatalog))
+#define  SCI_RETAIN_OBJ  (&(PlMgr.Payload.SciRetain))
 
 
 /*******************************/
@@ -50,7 +52,11 @@
 
 static int32 InitApp(void);
 static int32 ProcessCommands(void);
+static void ProcessExecuteTick(void);
+static bool ValidMsgId(const CFE_SB_Buffer_t *SbBufPtr, CFE_SB_MsgId_t ExpectedMid);
 static void SendStatusTlm(void);
+static void SendAcqTlm(void);
+static void SendFileInfoTlm(void);
 
 /**********************/
 /** File Global Data **/
@@ -96,8 +102,10 @@ void PL_MGR_AppMain(void)
    {
 
       /*
-      ** ProcessCommands() pends indefinitely. & manages CFE_ES_PerfLogEntry()
-      ** calls. The scheduler sends a message to manage science files.
+      ** ProcessCommands() pends on the execute pipe, reads the command pipe
+      ** & manages CFE_ES_PerfLogEntry() calls. The scheduler sends a message
+      ** on the execute pipe to send telemetry. Science data is managed by
+      ** child tasks.
       */
 	  
       RunStatus = ProcessCommands();
@@ -148,13 +156,56 @@ bool PL_MGR_ResetAppCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
 
    CMDMGR_ResetStatus(CMDMGR_OBJ);
    PAYLOAD_ResetStatus();
-   SCI_FILE_ResetStatus();
+   
+   memset(PlMgr.FileInfoValid, 0, sizeof(PlMgr.FileInfoValid));
+   PlMgr.CmdPipeHwm       = 0;
+   PlMgr.ExePipeHwm       = 0;
+   PlMgr.ExeMissedTickCnt = 0;
 
    return true;
 
 } /* End PL_MGR_ResetAppCmd() */
 
 
+/******************************************************************************
+** Function: PL_MGR_SendFileInfoCmd
+**
+** Send a channel's file information telemetry packet
+**
+** Notes:
+**   1. Function signature must match CMDMGR_CmdFuncPtr typedef 
+**   2. The packet includes the channel's staged science file configuration.
+*/
+
+bool PL_MGR_SendFileInfoCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   const PL_MGR_Channel_Payload_t *SendCmd = CMDMGR_PAYLOAD_PTR(MsgPtr, PL_MGR_SendFileInfo_t);
+   bool RetStatus = false;
+   
+   if (SendCmd->Channel < PlMgr.Payload.ChannelCnt)
+   {
+      
+      PlMgr.FileInfoValid[SendCmd->Channel] = false;
+      SendFileInfoTlm();
+      
+      RetStatus = true;
+   
+   }
+   else
+   {
+   
+      CFE_EVS_SendEvent (PL_MGR_SEND_FILE_INFO_CMD_EID, CFE_EVS_EventType_ERROR, 
+                         "Send file info command rejected. Channel %d must be less than the channel count %d",
+                         SendCmd->Channel, PlMgr.Payload.ChannelCnt);
+   
+   }
+   
+   return RetStatus;
+
+} /* End PL_MGR_SendFileInfoCmd() */
+
+
 /******************************************************************************
 ** Function: InitApp
 **
@@ -183,11 +234,15 @@ static int32 InitApp(void)
       ** Initialize cFE interfaces 
       */
 
-      CFE_SB_CreatePipe(&PlMgr.CmdPipe, INITBL_GetIntConfig(INITBL_OBJ, CFG_CMD_PIPE_DEPTH), 
+      PlMgr.CmdPipeDepth = INITBL_GetIntConfig(INITBL_OBJ, CFG_CMD_PIPE_DEPTH);
+      
+      CFE_SB_CreatePipe(&PlMgr.CmdPipe, PlMgr.CmdPipeDepth, 
                         INITBL_GetStrConfig(INITBL_OBJ, CFG_CMD_PIPE_NAME));
+      CFE_SB_Subscribe(PlMgr.CmdMid, PlMgr.CmdPipe);
       
-      CFE_SB_Subscribe(PlMgr.CmdMid,     PlMgr.CmdPipe);
-      CFE_SB_Subscribe(PlMgr.ExecuteMid, PlMgr.CmdPipe);
+      CFE_SB_CreatePipe(&PlMgr.ExePipe, INITBL_GetIntConfig(INITBL_OBJ, CFG_EXE_PIPE_DEPTH), 
+                        INITBL_GetStrConfig(INITBL_OBJ, CFG_EXE_PIPE_NAME));
+      CFE_SB_Subscribe(PlMgr.ExecuteMid, PlMgr.ExePipe);
 
       /*
       ** Initialize App Framework Components 
@@ -198,14 +253,27 @@ static int32 InitApp(void)
       CMDMGR_RegisterFunc(CMDMGR_OBJ, PL_MGR_RESET_CC, NULL, PL_MGR_ResetAppCmd, 0);
               
   
-      CMDMGR_RegisterFunc(CMDMGR_OBJ, PL_MGR_START_SCI_CC,       PAYLOAD_OBJ,  PAYLOAD_StartSciCmd, 0);
-      CMDMGR_RegisterFunc(CMDMGR_OBJ, PL_MGR_STOP_SCI_CC,        PAYLOAD_OBJ,  PAYLOAD_StopSciCmd,  0);
-      CMDMGR_RegisterFunc(CMDMGR_OBJ, PL_MGR_RESET_DETECTOR_CC,  PAYLOAD_OBJ,  PAYLOAD_ResetDetectorCmd, 0);
-      CMDMGR_RegisterFunc(CMDMGR_OBJ, PL_MGR_CONFIG_SCI_FILE_CC, SCI_FILE_OBJ, SCI_FILE_ConfigCmd,  sizeof(PL_MGR_ConfigSciFile_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, PL_MGR_START_SCI_CC,       PAYLOAD_OBJ,  PAYLOAD_StartSciCmd, sizeof(PL_MGR_Channel_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, PL_MGR_STOP_SCI_CC,        PAYLOAD_OBJ,  PAYLOAD_StopSciCmd,  sizeof(PL_MGR_Channel_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, PL_MGR_RESET_DETECTOR_CC,  PAYLOAD_OBJ,  PAYLOAD_ResetDetectorCmd, sizeof(PL_MGR_Channel_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, PL_MGR_CONFIG_SCI_FILE_CC, PAYLOAD_OBJ,  PAYLOAD_ConfigSciFileCmd, sizeof(PL_MGR_ConfigSciFileCmd_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, PL_MGR_CONFIG_SCI_STREAM_CC, SCI_STREAM_OBJ, SCI_STREAM_ConfigCmd, sizeof(PL_MGR_ConfigSciStream_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, PL_MGR_QUERY_CATALOG_CC,   SCI_CATALOG_OBJ, SCI_CATALOG_QueryCmd, sizeof(PL_MGR_QueryCatalog_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, PL_MGR_DUMP_CATALOG_CC,    SCI_CATALOG_OBJ, SCI_CATALOG_DumpCmd,  sizeof(PL_MGR_DumpCatalog_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, PL_MGR_CONFIG_RETAIN_CC,   SCI_RETAIN_OBJ,  SCI_RETAIN_ConfigCmd,  sizeof(PL_MGR_ConfigRetain_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, PL_MGR_SET_FILE_RETAIN_CC, SCI_RETAIN_OBJ,  SCI_RETAIN_SetFileCmd, sizeof(PL_MGR_SetFileRetain_Payload_t));
+      CMDMGR_RegisterFunc(CMDMGR_OBJ, PL_MGR_SEND_FILE_INFO_CC,  NULL,            PL_MGR_SendFileInfoCmd, sizeof(PL_MGR_Channel_Payload_t));
      
       CFE_MSG_Init(CFE_MSG_PTR(PlMgr.StatusTlm.TelemetryHeader), 
                    CFE_SB_ValueToMsgId(INITBL_GetIntConfig(INITBL_OBJ, CFG_PL_MGR_STATUS_TLM_TOPICID)),
                    sizeof(PL_MGR_StatusTlm_t));
+      CFE_MSG_Init(CFE_MSG_PTR(PlMgr.AcqTlm.TelemetryHeader), 
+                   CFE_SB_ValueToMsgId(INITBL_GetIntConfig(INITBL_OBJ, CFG_PL_MGR_ACQ_TLM_TOPICID)),
+                   sizeof(PL_MGR_AcqTlm_t));
+      CFE_MSG_Init(CFE_MSG_PTR(PlMgr.FileInfoTlm.TelemetryHeader), 
+                   CFE_SB_ValueToMsgId(INITBL_GetIntConfig(INITBL_OBJ, CFG_PL_MGR_FILE_INFO_TLM_TOPICID)),
+                   sizeof(PL_MGR_FileInfoTlm_t));
+      memset(PlMgr.FileInfoValid, 0, sizeof(PlMgr.FileInfoValid));
 
       /*
       ** Application startup event message
@@ -225,74 +293,104 @@ static int32 InitApp(void)
 /******************************************************************************
 ** Function: ProcessCommands
 **
+** Notes:
+**   1. The task pends forever on the execute pipe. At each wakeup the
+**      command pipe is read before the rest of the execute pipe so
+**      commands never wait behind queued execute messages and the task
+**      doesn't poll when it's idle. Commands are processed within one
+**      scheduler period.
+**   2. At most one pipe depth of messages is read from the command pipe
+**      per call so a command flood can't starve telemetry.
+**   3. All pending execute messages are read and collapsed into a single
+**      execution. The extras are accounted for as missed ticks.
+**   4. cFE doesn't report a pipe's depth so each pipe's high-water mark is
+**      the maximum number of messages read from it during one call.
+**
 */
 static int32 ProcessCommands(void)
 {
 
    int32  RetStatus = CFE_ES_RunStatus_APP_RUN;
    int32  SysStatus;
+   uint16 CmdCnt = 0;
+   uint16 ExeCnt = 0;
 
    CFE_SB_Buffer_t* SbBufPtr;
-   CFE_SB_MsgId_t   MsgId = CFE_SB_INVALID_MSG_ID;
 
 
    CFE_ES_PerfLogExit(PlMgr.PerfId);
-   SysStatus = CFE_SB_ReceiveBuffer(&SbBufPtr, PlMgr.CmdPipe, CFE_SB_PEND_FOREVER);
+   SysStatus = CFE_SB_ReceiveBuffer(&SbBufPtr, PlMgr.ExePipe, CFE_SB_PEND_FOREVER);
    CFE_ES_PerfLogEntry(PlMgr.PerfId);
 
    if (SysStatus == CFE_SUCCESS)
    {
       
-      SysStatus = CFE_MSG_GetMsgId(&SbBufPtr->Msg, &MsgId);
+      if (ValidMsgId(SbBufPtr, PlMgr.ExecuteMid)) 
+      {
+         ExeCnt++;
+      }
+      
+      SysStatus = CFE_SB_ReceiveBuffer(&SbBufPtr, PlMgr.CmdPipe, CFE_SB_POLL);
+   
+   }
    
-      if (SysStatus == CFE_SUCCESS)
+   while (SysStatus == CFE_SUCCESS)
+   {
+      
+      if (ValidMsgId(SbBufPtr, PlMgr.CmdMid)) 
       {
-  
-         if (CFE_SB_MsgId_Equal(MsgId, PlMgr.CmdMid)) 
-         {
-            
-            CMDMGR_DispatchFunc(CMDMGR_OBJ, &SbBufPtr->Msg);
-         
-         } 
-         else if (CFE_SB_MsgId_Equal(MsgId, PlMgr.ExecuteMid))
-         {
-
-            PAYLOAD_ManageData();
-            if (PlMgr.Payload.PowerState != PL_SIM_LIB_Power_OFF)
-            {
-               SendStatusTlm();
-            }
-            else
-            {
-               if (PlMgr.TlmSlowRateCnt >= PlMgr.TlmSlowRate)
-               {
-                  SendStatusTlm();
-                  PlMgr.TlmSlowRateCnt = 0;
-               }
-               else
-               {
-                  PlMgr.TlmSlowRateCnt++;
-               }
-            }
-         }
-         else
-         {
-            
-            CFE_EVS_SendEvent(PL_MGR_INVALID_CMD_EID, CFE_EVS_EventType_ERROR,
-                              "Received invalid command packet, MID = 0x%04X",
-                              CFE_SB_MsgIdToValue(MsgId));
-         } 
-
+         CMDMGR_DispatchFunc(CMDMGR_OBJ, &SbBufPtr->Msg);
+      }
+      
+      CmdCnt++;
+      if (CmdCnt < PlMgr.CmdPipeDepth)
+      {
+         SysStatus = CFE_SB_ReceiveBuffer(&SbBufPtr, PlMgr.CmdPipe, CFE_SB_POLL);
       }
       else
       {
-         
-         CFE_EVS_SendEvent(PL_MGR_INVALID_CMD_EID, CFE_EVS_EventType_ERROR,
-                           "CFE couldn't retrieve message ID from the message, Status = %d", SysStatus);
+         SysStatus = CFE_SB_NO_MESSAGE;
       }
+   
+   } /* End command pipe loop */
+   
+   if (SysStatus == CFE_SB_NO_MESSAGE)
+   {
+      
+      SysStatus = CFE_SB_ReceiveBuffer(&SbBufPtr, PlMgr.ExePipe, CFE_SB_POLL);
+      
+      while (SysStatus == CFE_SUCCESS)
+      {
+         
+         if (ValidMsgId(SbBufPtr, PlMgr.ExecuteMid)) 
+         {
+            ExeCnt++;
+         }
+         
+         SysStatus = CFE_SB_ReceiveBuffer(&SbBufPtr, PlMgr.ExePipe, CFE_SB_POLL);
+         
+      } /* End execute pipe loop */
+      
+   }
+
+   if (CmdCnt > PlMgr.CmdPipeHwm)
+   {
+      PlMgr.CmdPipeHwm = CmdCnt;
+   }
+   if (ExeCnt > PlMgr.ExePipeHwm)
+   {
+      PlMgr.ExePipeHwm = ExeCnt;
+   }
+   
+   if (ExeCnt > 0)
+   {
       
-   } /* Valid SB receive */ 
-   else 
+      PlMgr.ExeMissedTickCnt += (ExeCnt - 1);
+      ProcessExecuteTick();
+   
+   }
+   
+   if (SysStatus != CFE_SB_NO_MESSAGE)
    {
    
          CFE_ES_WriteToSysLog("PL_MGR software bus error. Status = 0x%08X\n", SysStatus);   /* Use SysLog, events may not be working */
@@ -304,6 +402,84 @@ static int32 ProcessCommands(void)
 } /* End ProcessCommands() */
 
 
+/******************************************************************************
+** Function: ProcessExecuteTick
+**
+** Notes:
+**   1. Telemetry is sent at a slower rate when every detector channel is
+**      powered off.
+**
+*/
+static void ProcessExecuteTick(void)
+{
+
+   SendFileInfoTlm();
+   if (PAYLOAD_Powered())
+   {
+      SendStatusTlm();
+      SendAcqTlm();
+      PERF_HIST_SendTlm();
+   }
+   else
+   {
+      if (PlMgr.TlmSlowRateCnt >= PlMgr.TlmSlowRate)
+      {
+         SendStatusTlm();
+         SendAcqTlm();
+         PERF_HIST_SendTlm();
+         PlMgr.TlmSlowRateCnt = 0;
+      }
+      else
+      {
+         PlMgr.TlmSlowRateCnt++;
+      }
+   }
+
+} /* End ProcessExecuteTick() */
+
+
+/******************************************************************************
+** Function: ValidMsgId
+**
+** Return true if a received message has the message ID expected on its pipe.
+**
+*/
+static bool ValidMsgId(const CFE_SB_Buffer_t *SbBufPtr, CFE_SB_MsgId_t ExpectedMid)
+{
+
+   bool   RetStatus = false;
+   int32  SysStatus;
+   CFE_SB_MsgId_t MsgId = CFE_SB_INVALID_MSG_ID;
+
+   SysStatus = CFE_MSG_GetMsgId(&SbBufPtr->Msg, &MsgId);
+
+   if (SysStatus == CFE_SUCCESS)
+   {
+
+      if (CFE_SB_MsgId_Equal(MsgId, ExpectedMid)) 
+      {
+         RetStatus = true;
+      }
+      else
+      {
+         CFE_EVS_SendEvent(PL_MGR_INVALID_CMD_EID, CFE_EVS_EventType_ERROR,
+                           "Received invalid command packet, MID = 0x%04X",
+                           CFE_SB_MsgIdToValue(MsgId));
+      }
+
+   }
+   else
+   {
+      
+      CFE_EVS_SendEvent(PL_MGR_INVALID_CMD_EID, CFE_EVS_EventType_ERROR,
+                        "CFE couldn't retrieve message ID from the message, Status = %d", SysStatus);
+   }
+
+   return RetStatus;
+
+} /* End ValidMsgId() */
+
+
 /******************************************************************************
 ** Function: SendStatusTlm
 **
@@ -312,6 +488,10 @@ static void SendStatusTlm(void)
 {
 
    PL_MGR_StatusTlm_Payload_t *Payload = &PlMgr.StatusTlm.Payload;
+   PL_MGR_ChannelStatus_t     *ChannelStatus;
+   PAYLOAD_Channel_t          *Channel;
+   SCI_FILE_Status_t           SciFileStatus;
+   uint16 i;
 
    /*
    ** CMDMGR Data
@@ -319,27 +499,135 @@ static void SendStatusTlm(void)
 
    Payload->ValidCmdCnt   = PlMgr.CmdMgr.ValidCmdCnt;
    Payload->InvalidCmdCnt = PlMgr.CmdMgr.InvalidCmdCnt;
+   Payload->CmdPipeHwm    = PlMgr.CmdPipeHwm;
+   Payload->ExePipeHwm    = PlMgr.ExePipeHwm;
+   Payload->ExeMissedTickCnt = PlMgr.ExeMissedTickCnt;
 
    
    /*
    ** Payload Data
    */
    
-   Payload->PayloadPowerState         = PlMgr.Payload.PowerState;
-   Payload->PayloadDetectorFault      = PlMgr.Payload.DetectorMon.FaultPresent;
-   Payload->PayloadDetectorReadoutRow = PlMgr.Payload.Detector.ReadoutRow;
-   Payload->PayloadDetectorImageCnt   = PlMgr.Payload.Detector.ImageCnt;
+   Payload->SciStreamEnabled        = PlMgr.Payload.SciStream.Enabled;
+   Payload->SciStreamChannel        = PlMgr.Payload.SciStream.Channel;
+   Payload->SciStreamPktCnt         = PlMgr.Payload.SciStream.PktCnt;
+   Payload->SciStreamBudgetDropCnt  = PlMgr.Payload.SciStream.BudgetDropCnt;
+   Payload->SciStreamTransmitErrCnt = PlMgr.Payload.SciStream.TransmitErrCnt;
+   
+   Payload->ImgPoolWorkerCnt = PlMgr.Payload.ImgPool.WorkerCnt;
+   Payload->ImgPoolInUseHwm  = PlMgr.Payload.ImgPool.ImageInUseHwm;
+   Payload->ImgPoolImageCnt  = PlMgr.Payload.ImgPool.ImageCnt;
+   Payload->ImgPoolDropCnt   = PlMgr.Payload.ImgPool.DropCnt;
+   
+   Payload->RetainPolicy      = PlMgr.Payload.SciRetain.Policy;
+   Payload->RetainFileCnt     = PlMgr.Payload.SciRetain.FileCnt;
+   Payload->RetainFileQuota   = PlMgr.Payload.SciRetain.FileQuota;
+   Payload->RetainEvictCnt    = PlMgr.Payload.SciRetain.EvictCnt;
+   Payload->RetainEvictErrCnt = PlMgr.Payload.SciRetain.EvictErrCnt;
+   Payload->RetainByteCnt     = PlMgr.Payload.SciRetain.ByteCnt;
+   Payload->RetainByteQuota   = PlMgr.Payload.SciRetain.ByteQuota;
+   
+   Payload->ChannelCnt = PlMgr.Payload.ChannelCnt;
+   for (i=0; i < PlMgr.Payload.ChannelCnt; i++)
+   {
+      
+      Channel       = &PlMgr.Payload.Channel[i];
+      ChannelStatus = &Payload->Channel[i];
+      
+      ChannelStatus->PowerState          = Channel->PowerState;
+      ChannelStatus->DetectorFault       = Channel->DetectorMon.FaultPresent;
+      ChannelStatus->DetectorBadRowCnt   = Channel->DetectorMon.BadRowCnt;
+      ChannelStatus->DetectorBadPixelCnt = Channel->DetectorMon.BadPixelCnt;
+      ChannelStatus->DetectorBadPixelIdx = Channel->DetectorMon.BadPixelIdx;
+      ChannelStatus->DetectorReadoutRow  = Channel->Detector.ReadoutRow;
+      ChannelStatus->DetectorImageCnt    = Channel->Detector.ImageCnt;
+      ChannelStatus->CycleRowCnt         = Channel->CycleRowCnt;
+      ChannelStatus->CycleRowCntMax      = Channel->CycleRowCntMax;
+      ChannelStatus->CycleLimitCnt       = Channel->CycleLimitCnt;
+      ChannelStatus->RowCnt              = Channel->RowCnt;
 
-   /*
-   ** Science File Data
-   */   
+      /*
+      ** Science File Data
+      */   
 
-   Payload->SciFileOpen     = PlMgr.Payload.SciFile.IsOpen;
-   Payload->SciFileImageCnt = PlMgr.Payload.SciFile.ImageCnt;   
-   strncpy(Payload->SciFilename, PlMgr.Payload.SciFile.Name, OS_MAX_PATH_LEN);
+      SCI_FILE_GetStatus(&Channel->SciFile, &SciFileStatus);
+      
+      ChannelStatus->SciFileOpen      = SciFileStatus.FileOpen;
+      ChannelStatus->SciFileImageCnt  = SciFileStatus.ImageCnt;   
+      ChannelStatus->SciFileCompRatio = SciFileStatus.CompRatio;
+      ChannelStatus->SciFileCodecUsec = SciFileStatus.CodecUsec;
+      ChannelStatus->SciFileImageCrc  = SciFileStatus.LastImageCrc;
+      ChannelStatus->SciFileSyncCnt   = SciFileStatus.SyncCnt;
+      ChannelStatus->SciFileRoiSavedBytes = SciFileStatus.RoiSavedByteCnt;
+      ChannelStatus->SciFileConfigPending = SciFileStatus.ConfigPending;
+      
+      ChannelStatus->SciWriterQueueCnt    = SCI_WRITER_GetQueueCnt(&Channel->SciWriter);
+      ChannelStatus->SciWriterQueueHwm    = Channel->SciWriter.QueueHwm;
+      ChannelStatus->SciWriterOverflowCnt = Channel->SciWriter.OverflowCnt;
+   
+   }
    
    CFE_SB_TimeStampMsg(CFE_MSG_PTR(PlMgr.StatusTlm.TelemetryHeader));
    CFE_SB_TransmitMsg(CFE_MSG_PTR(PlMgr.StatusTlm.TelemetryHeader), true);
 
 } /* End SendStatusTlm() */
 
+
+/******************************************************************************
+** Function: SendFileInfoTlm
+**
+** Notes:
+**   1. A channel's packet is only sent when its SCI_FILE information change
+**      count differs from the last count that was sent for the channel.
+**
+*/
+static void SendFileInfoTlm(void)
+{
+
+   uint16 i;
+   SCI_FILE_Class_t *SciFile;
+   SCI_FILE_Status_t SciFileStatus;
+   
+   for (i=0; i < PlMgr.Payload.ChannelCnt; i++)
+   {
+      
+      SciFile = &PlMgr.Payload.Channel[i].SciFile;
+      SCI_FILE_GetStatus(SciFile, &SciFileStatus);
+      
+      if (!PlMgr.FileInfoValid[i] || PlMgr.FileInfoChangeCnt[i] != SciFileStatus.InfoChangeCnt)
+      {
+         
+         PlMgr.FileInfoChangeCnt[i] = SCI_FILE_GetFileInfo(SciFile, &PlMgr.FileInfoTlm.Payload);
+         PlMgr.FileInfoValid[i]     = true;
+         PlMgr.FileInfoTlm.Payload.Channel = i;
+         
+         CFE_SB_TimeStampMsg(CFE_MSG_PTR(PlMgr.FileInfoTlm.TelemetryHeader));
+         CFE_SB_TransmitMsg(CFE_MSG_PTR(PlMgr.FileInfoTlm.TelemetryHeader), true);
+      
+      }
+   }
+
+} /* End SendFileInfoTlm() */
+
+
+/******************************************************************************
+** Function: SendAcqTlm
+**
+*/
+static void SendAcqTlm(void)
+{
+
+   PL_MGR_AcqTlm_Payload_t *Payload = &PlMgr.AcqTlm.Payload;
+
+   Payload->PeriodMs     = PlMgr.Payload.AcqPeriodMs;
+   Payload->CycleCnt     = PlMgr.Payload.AcqCycleCnt;
+   Payload->OverrunCnt   = PlMgr.Payload.AcqOverrunCnt;
+   Payload->CycleRate    = PlMgr.Payload.AcqCycleRate;
+   Payload->RowRate      = PlMgr.Payload.AcqRowRate;
+   Payload->CycleUsec    = PlMgr.Payload.AcqCycleUsec;
+   Payload->CycleUsecMax = PlMgr.Payload.AcqCycleUsecMax;
+   
+   CFE_SB_TimeStampMsg(CFE_MSG_PTR(PlMgr.AcqTlm.TelemetryHeader));
+   CFE_SB_TransmitMsg(CFE_MSG_PTR(PlMgr.AcqTlm.TelemetryHeader), true);
+
+} /* End SendAcqTlm() */
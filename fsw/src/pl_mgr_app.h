@@ -28,6 +28,20 @@
 **       and when science files can be created is managed at the app level
 **       so the SCI_FILE object's scope is limited to science data formats
 **       and science file management. 
+**    4. Detector data is acquired by the PAYLOAD object's child task. The
+**       scheduler's execute message only drives telemetry.
+**    5. Commands and scheduler execute messages use separate pipes so a
+**       command never waits behind queued execute messages. The main task
+**       pends on the execute pipe and reads the command pipe first at each
+**       wakeup. See ProcessCommands().
+**    6. The status telemetry packet is a compact housekeeping packet sent
+**       at a fixed rate. The science file information packet is only sent
+**       when the science file or its configuration changes and after an
+**       app reset command.
+**    7. The payload has multiple detector channels. Commands that act on a
+**       detector or its science files have a channel parameter, the status
+**       telemetry packet has a section for each channel and a science file
+**       information packet is sent for each channel.
 **
 **  References:
 **    1. OpenSatKit Object-based Application Developer's Guide
@@ -52,6 +66,7 @@
 #define PL_MGR_EXIT_EID          (PL_MGR_BASE_EID + 1)
 #define PL_MGR_NOOP_CMD_EID      (PL_MGR_BASE_EID + 2)
 #define PL_MGR_INVALID_CMD_EID   (PL_MGR_BASE_EID + 3)
+#define PL_MGR_SEND_FILE_INFO_CMD_EID  (PL_MGR_BASE_EID + 4)
 
 /**********************/
 /** Type Definitions **/
@@ -79,6 +94,7 @@ typedef struct
    
    INITBL_Class_t   IniTbl;
    CFE_SB_PipeId_t  CmdPipe;
+   CFE_SB_PipeId_t  ExePipe;
    CMDMGR_Class_t   CmdMgr;
    
    /*
@@ -86,6 +102,8 @@ typedef struct
    */
 
    PL_MGR_StatusTlm_t StatusTlm;
+   PL_MGR_AcqTlm_t    AcqTlm;
+   PL_MGR_FileInfoTlm_t FileInfoTlm;
 
    /*
    ** PL_MGR state and Child Objects
@@ -96,6 +114,12 @@ typedef struct
    CFE_SB_MsgId_t   ExecuteMid;
    uint32           TlmSlowRate;
    uint32           TlmSlowRateCnt;
+   uint16           CmdPipeDepth;
+   uint16           CmdPipeHwm;         /* Max commands read in one loop */
+   uint16           ExePipeHwm;         /* Max execute messages read in one loop */
+   uint32           ExeMissedTickCnt;   /* Execute messages collapsed into one */
+   bool             FileInfoValid[PAYLOAD_CHANNEL_MAX];      /* FileInfoChangeCnt has been sent */
+   uint16           FileInfoChangeCnt[PAYLOAD_CHANNEL_MAX];  /* Channel's SCI_FILE change count last sent */
    
    PAYLOAD_Class_t  Payload;
    
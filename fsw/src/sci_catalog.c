@@ -0,0 +1,766 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the science file catalog object
+**
+**  Notes:
+**    None
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+
+#include "app_cfg.h"
+#include "sci_catalog.h"
+#include "sci_crc.h"
+#include "sci_sync.h"
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static SCI_CATALOG_Class_t *SciCatalog = NULL;
+
+static const char *DumpHeader = "# PL_MGR science file catalog\n"
+                                "# Seq Channel Filename FileFormat Codec Flags Priority FileLen FileCrc ImageCnt\n"
+                                "#    ImageId Flags Offset\n";
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void AddIndex(uint16 Slot);
+static bool CreateCatalogFile(void);
+static uint32 EntryOffset(uint16 Slot);
+static uint16 HashImage(uint16 Channel, uint16 ImageId);
+static void IndexEntries(void);
+static void LoadCatalogFile(void);
+static void RemoveIndex(uint16 Slot);
+static bool ValidFileEntry(const SCI_CATALOG_FileEntry_t *FileEntry, uint16 Slot);
+static void WriteDumpEntry(osal_id_t FileHandle, const PL_MGR_CatalogEntry_t *Entry);
+static void WriteEntry(uint16 Slot, bool Sync);
+
+
+/******************************************************************************
+** Function: SCI_CATALOG_Constructor
+**
+*/
+void SCI_CATALOG_Constructor(SCI_CATALOG_Class_t *SciCatalogPtr, INITBL_Class_t *IniTbl)
+{
+
+   SciCatalog = SciCatalogPtr;
+
+   CFE_PSP_MemSet((void*)SciCatalog, 0, sizeof(SCI_CATALOG_Class_t));
+   memset(SciCatalog->Bucket, 0xFF, sizeof(SciCatalog->Bucket));
+
+   SCI_CRC_InitTables();
+
+   strncpy(SciCatalog->Filename, INITBL_GetStrConfig(IniTbl, CFG_SCI_CATALOG_FILE), OS_MAX_PATH_LEN);
+   SciCatalog->Filename[OS_MAX_PATH_LEN-1] = '\0';
+   strncpy(SciCatalog->DumpFilename, INITBL_GetStrConfig(IniTbl, CFG_SCI_CATALOG_DUMP_FILE), OS_MAX_PATH_LEN);
+   SciCatalog->DumpFilename[OS_MAX_PATH_LEN-1] = '\0';
+
+   SciCatalog->NextSeq = 1;
+
+   if (OS_MutSemCreate(&SciCatalog->MutexId, "PL_MGR_CATALOG", 0) != OS_SUCCESS)
+   {
+      CFE_EVS_SendEvent (SCI_CATALOG_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR,
+                         "Science file catalog mutex creation failed");
+   }
+
+   CFE_MSG_Init(CFE_MSG_PTR(SciCatalog->CatalogTlm.TelemetryHeader),
+                CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_PL_MGR_CATALOG_TLM_TOPICID)),
+                sizeof(PL_MGR_CatalogTlm_t));
+
+   LoadCatalogFile();
+
+} /* End SCI_CATALOG_Constructor() */
+
+
+/******************************************************************************
+** Function: SCI_CATALOG_AddFile
+**
+** Notes:
+**   1. The oldest entry is removed from the index before its slot is reused.
+**   2. The catalog file is synced after the slot is written when Sync is
+**      true so a synced science file's entry isn't lost by a reset.
+**
+*/
+void SCI_CATALOG_AddFile(PL_MGR_CatalogEntry_t *Entry, bool Sync)
+{
+
+   uint16 Slot;
+
+   OS_MutSemTake(SciCatalog->MutexId);
+
+   Entry->Seq = SciCatalog->NextSeq++;
+   Slot = Entry->Seq % SCI_CATALOG_ENTRY_CNT;
+
+   if (SciCatalog->Entry[Slot].Seq != 0)
+   {
+      RemoveIndex(Slot);
+      SciCatalog->EntryCnt--;
+   }
+
+   SciCatalog->Entry[Slot] = *Entry;
+   if (SciCatalog->Entry[Slot].ImageCnt > SCI_CATALOG_FILE_IMAGE_MAX)
+   {
+      SciCatalog->Entry[Slot].ImageCnt = SCI_CATALOG_FILE_IMAGE_MAX;
+   }
+
+   AddIndex(Slot);
+   SciCatalog->EntryCnt++;
+
+   WriteEntry(Slot, Sync);
+
+   OS_MutSemGive(SciCatalog->MutexId);
+
+} /* End SCI_CATALOG_AddFile() */
+
+
+/******************************************************************************
+** Function: SCI_CATALOG_DumpCmd
+**
+** Notes:
+**   1. Each entry is copied while the mutex is held and written to the dump
+**      file after it's released so SCI_WRITER file closes aren't blocked by
+**      the dump file writes.
+**
+*/
+bool SCI_CATALOG_DumpCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   const PL_MGR_DumpCatalog_Payload_t *DumpCmd = CMDMGR_PAYLOAD_PTR(MsgPtr, PL_MGR_DumpCatalog_t);
+   bool       RetStatus = false;
+   bool       EntryValid;
+   int32      SysStatus;
+   osal_id_t  FileHandle;
+   uint32     Seq;
+   uint32     NextSeq;
+   uint16     Slot;
+   uint16     DumpCnt = 0;
+   char       Filename[OS_MAX_PATH_LEN];
+   PL_MGR_CatalogEntry_t Entry;
+
+   if (DumpCmd->Filename[0] == '\0')
+   {
+      strcpy(Filename, SciCatalog->DumpFilename);
+   }
+   else
+   {
+      strncpy(Filename, DumpCmd->Filename, OS_MAX_PATH_LEN);
+      Filename[OS_MAX_PATH_LEN-1] = '\0';
+   }
+
+   SysStatus = OS_OpenCreate(&FileHandle, Filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+
+   if (SysStatus == OS_SUCCESS)
+   {
+
+      OS_write(FileHandle, DumpHeader, strlen(DumpHeader));
+
+      OS_MutSemTake(SciCatalog->MutexId);
+      NextSeq = SciCatalog->NextSeq;
+      OS_MutSemGive(SciCatalog->MutexId);
+
+      Seq = (NextSeq > SCI_CATALOG_ENTRY_CNT) ? (NextSeq - SCI_CATALOG_ENTRY_CNT) : 1;
+      for ( ; Seq < NextSeq; Seq++)
+      {
+
+         Slot = Seq % SCI_CATALOG_ENTRY_CNT;
+
+         OS_MutSemTake(SciCatalog->MutexId);
+         EntryValid = (SciCatalog->Entry[Slot].Seq == Seq);
+         if (EntryValid)
+         {
+            Entry = SciCatalog->Entry[Slot];
+         }
+         OS_MutSemGive(SciCatalog->MutexId);
+
+         if (EntryValid)
+         {
+            WriteDumpEntry(FileHandle, &Entry);
+            DumpCnt++;
+         }
+
+      } /* End entry loop */
+
+      OS_close(FileHandle);
+
+      CFE_EVS_SendEvent (SCI_CATALOG_DUMP_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                         "Science file catalog with %d files written to %s", DumpCnt, Filename);
+      RetStatus = true;
+
+   }
+   else
+   {
+
+      CFE_EVS_SendEvent (SCI_CATALOG_DUMP_CMD_EID, CFE_EVS_EventType_ERROR,
+                         "Dump science file catalog command failed to create %s. Status = %d",
+                         Filename, SysStatus);
+
+   }
+
+   return RetStatus;
+
+} /* End SCI_CATALOG_DumpCmd() */
+
+
+/******************************************************************************
+** Function: SCI_CATALOG_GetEntry
+**
+*/
+bool SCI_CATALOG_GetEntry(uint16 Slot, PL_MGR_CatalogEntry_t *Entry)
+{
+
+   bool RetStatus = false;
+
+   if (Slot < SCI_CATALOG_ENTRY_CNT)
+   {
+
+      OS_MutSemTake(SciCatalog->MutexId);
+
+      if (SciCatalog->Entry[Slot].Seq != 0)
+      {
+         *Entry    = SciCatalog->Entry[Slot];
+         RetStatus = true;
+      }
+
+      OS_MutSemGive(SciCatalog->MutexId);
+
+   }
+
+   return RetStatus;
+
+} /* End SCI_CATALOG_GetEntry() */
+
+
+/******************************************************************************
+** Function: SCI_CATALOG_Lookup
+**
+*/
+bool SCI_CATALOG_Lookup(uint16 Channel, uint16 ImageId, PL_MGR_CatalogEntry_t *Entry, uint16 *ImageIdx)
+{
+
+   bool   RetStatus = false;
+   uint16 Node;
+   uint16 Slot;
+   uint16 i;
+
+   OS_MutSemTake(SciCatalog->MutexId);
+
+   Node = SciCatalog->Bucket[HashImage(Channel, ImageId)];
+
+   while (Node != SCI_CATALOG_NO_NODE && !RetStatus)
+   {
+
+      Slot = Node / SCI_CATALOG_FILE_IMAGE_MAX;
+      i    = Node % SCI_CATALOG_FILE_IMAGE_MAX;
+
+      if (SciCatalog->Entry[Slot].Channel == Channel &&
+          SciCatalog->Entry[Slot].Image[i].ImageId == ImageId)
+      {
+         *Entry    = SciCatalog->Entry[Slot];
+         *ImageIdx = i;
+         RetStatus = true;
+      }
+      else
+      {
+         Node = SciCatalog->NextNode[Node];
+      }
+
+   } /* End bucket loop */
+
+   OS_MutSemGive(SciCatalog->MutexId);
+
+   return RetStatus;
+
+} /* End SCI_CATALOG_Lookup() */
+
+
+/******************************************************************************
+** Function: SCI_CATALOG_QueryCmd
+**
+*/
+bool SCI_CATALOG_QueryCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   const PL_MGR_QueryCatalog_Payload_t *QueryCmd = CMDMGR_PAYLOAD_PTR(MsgPtr, PL_MGR_QueryCatalog_t);
+   PL_MGR_CatalogTlm_Payload_t *Payload = &SciCatalog->CatalogTlm.Payload;
+   bool RetStatus = false;
+
+   if (SCI_CATALOG_Lookup(QueryCmd->Channel, QueryCmd->ImageId, &Payload->Entry, &Payload->ImageIdx))
+   {
+
+      CFE_SB_TimeStampMsg(CFE_MSG_PTR(SciCatalog->CatalogTlm.TelemetryHeader));
+      CFE_SB_TransmitMsg(CFE_MSG_PTR(SciCatalog->CatalogTlm.TelemetryHeader), true);
+
+      CFE_EVS_SendEvent (SCI_CATALOG_QUERY_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                         "Channel %d image %d is in %s at byte offset %u",
+                         QueryCmd->Channel, QueryCmd->ImageId, Payload->Entry.Filename,
+                         (unsigned int)Payload->Entry.Image[Payload->ImageIdx].Offset);
+      RetStatus = true;
+
+   }
+   else
+   {
+
+      CFE_EVS_SendEvent (SCI_CATALOG_QUERY_CMD_EID, CFE_EVS_EventType_ERROR,
+                         "Query science file catalog command failed, channel %d image %d is not in the catalog",
+                         QueryCmd->Channel, QueryCmd->ImageId);
+
+   }
+
+   return RetStatus;
+
+} /* End SCI_CATALOG_QueryCmd() */
+
+
+/******************************************************************************
+** Function: SCI_CATALOG_RemoveFile
+**
+** Notes:
+**   1. The slot is written as unused so the entry isn't restored at startup.
+**
+*/
+void SCI_CATALOG_RemoveFile(uint32 Seq)
+{
+
+   uint16 Slot = Seq % SCI_CATALOG_ENTRY_CNT;
+
+   OS_MutSemTake(SciCatalog->MutexId);
+
+   if (Seq != 0 && SciCatalog->Entry[Slot].Seq == Seq)
+   {
+      RemoveIndex(Slot);
+      SciCatalog->EntryCnt--;
+      memset(&SciCatalog->Entry[Slot], 0, sizeof(PL_MGR_CatalogEntry_t));
+      WriteEntry(Slot, false);
+   }
+
+   OS_MutSemGive(SciCatalog->MutexId);
+
+} /* End SCI_CATALOG_RemoveFile() */
+
+
+/******************************************************************************
+** Function: SCI_CATALOG_SetRetain
+**
+*/
+bool SCI_CATALOG_SetRetain(uint32 Seq, uint16 Priority, bool Downlinked)
+{
+
+   bool   RetStatus = false;
+   uint16 Slot = Seq % SCI_CATALOG_ENTRY_CNT;
+   PL_MGR_CatalogEntry_t *Entry = &SciCatalog->Entry[Slot];
+
+   OS_MutSemTake(SciCatalog->MutexId);
+
+   if (Seq != 0 && Entry->Seq == Seq)
+   {
+      Entry->Priority = Priority;
+      if (Downlinked)
+      {
+         Entry->Flags |= SCI_CATALOG_FILE_DOWNLINKED;
+      }
+      else
+      {
+         Entry->Flags &= ~SCI_CATALOG_FILE_DOWNLINKED;
+      }
+      WriteEntry(Slot, false);
+      RetStatus = true;
+   }
+
+   OS_MutSemGive(SciCatalog->MutexId);
+
+   return RetStatus;
+
+} /* End SCI_CATALOG_SetRetain() */
+
+
+/******************************************************************************
+** Function: AddIndex
+**
+** Add an entry's images to the index
+**
+** Notes:
+**   1. Nodes are added to the front of their bucket so the newest file is
+**      found first. See prologue notes.
+**
+*/
+static void AddIndex(uint16 Slot)
+{
+
+   const PL_MGR_CatalogEntry_t *Entry = &SciCatalog->Entry[Slot];
+   uint16 Bucket;
+   uint16 Node;
+   uint16 i;
+
+   for (i=0; i < Entry->ImageCnt; i++)
+   {
+      Node   = Slot * SCI_CATALOG_FILE_IMAGE_MAX + i;
+      Bucket = HashImage(Entry->Channel, Entry->Image[i].ImageId);
+      SciCatalog->NextNode[Node]   = SciCatalog->Bucket[Bucket];
+      SciCatalog->Bucket[Bucket] = Node;
+   }
+
+} /* End AddIndex() */
+
+
+/******************************************************************************
+** Function: CreateCatalogFile
+**
+** Create an empty catalog file
+**
+** Notes:
+**   1. Unwritten slots read as zero so they're unused. See prologue notes.
+**
+*/
+static bool CreateCatalogFile(void)
+{
+
+   int32 SysStatus;
+   SCI_CATALOG_FileHeader_t Header;
+
+   if (SciCatalog->FileOpen)
+   {
+      OS_close(SciCatalog->FileHandle);
+      SCI_SYNC_Close(SciCatalog->SyncFd);
+      SciCatalog->SyncFd = SCI_SYNC_NO_FD;
+   }
+
+   SysStatus = OS_OpenCreate(&SciCatalog->FileHandle, SciCatalog->Filename,
+                             OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_READ_WRITE);
+   SciCatalog->FileOpen = (SysStatus == OS_SUCCESS);
+
+   if (SciCatalog->FileOpen)
+   {
+
+      SciCatalog->SyncFd = SCI_SYNC_Open(SciCatalog->Filename);
+
+      memset(&Header, 0, sizeof(Header));
+      Header.Sync     = SCI_CATALOG_FILE_SYNC;
+      Header.Version  = SCI_CATALOG_FILE_VERSION;
+      Header.EntryCnt = SCI_CATALOG_ENTRY_CNT;
+      Header.EntryLen = sizeof(SCI_CATALOG_FileEntry_t);
+
+      if (OS_write(SciCatalog->FileHandle, &Header, sizeof(Header)) != sizeof(Header))
+      {
+         SysStatus = OS_ERROR;
+      }
+
+   }
+
+   if (SysStatus != OS_SUCCESS)
+   {
+      CFE_EVS_SendEvent (SCI_CATALOG_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR,
+                         "Error creating science file catalog %s. Status = %d. Catalog won't be saved.",
+                         SciCatalog->Filename, SysStatus);
+   }
+
+   return (SysStatus == OS_SUCCESS);
+
+} /* End CreateCatalogFile() */
+
+
+/******************************************************************************
+** Function: EntryOffset
+**
+** Return a slot's catalog file byte offset
+**
+*/
+static uint32 EntryOffset(uint16 Slot)
+{
+
+   return sizeof(SCI_CATALOG_FileHeader_t) + Slot * sizeof(SCI_CATALOG_FileEntry_t);
+
+} /* End EntryOffset() */
+
+
+/******************************************************************************
+** Function: HashImage
+**
+** Return an image's hash bucket
+**
+** Notes:
+**   1. Consecutive image IDs are in consecutive buckets.
+**
+*/
+static uint16 HashImage(uint16 Channel, uint16 ImageId)
+{
+
+   return (uint16)((ImageId ^ ((uint32)Channel << 8)) & (SCI_CATALOG_HASH_LEN - 1));
+
+} /* End HashImage() */
+
+
+/******************************************************************************
+** Function: IndexEntries
+**
+** Index the entries loaded from the catalog file from the oldest to the
+** newest
+**
+** Notes:
+**   1. An entry older than the catalog's newest SCI_CATALOG_ENTRY_CNT
+**      entries is stale because its slot wasn't successfully rewritten. It's
+**      discarded.
+**
+*/
+static void IndexEntries(void)
+{
+
+   uint32 Seq;
+   uint16 Slot;
+
+   for (Slot=0; Slot < SCI_CATALOG_ENTRY_CNT; Slot++)
+   {
+      if ((SciCatalog->Entry[Slot].Seq + SCI_CATALOG_ENTRY_CNT) < SciCatalog->NextSeq)
+      {
+         SciCatalog->Entry[Slot].Seq = 0;
+      }
+   }
+
+   Seq = (SciCatalog->NextSeq > SCI_CATALOG_ENTRY_CNT) ? (SciCatalog->NextSeq - SCI_CATALOG_ENTRY_CNT) : 1;
+   for ( ; Seq < SciCatalog->NextSeq; Seq++)
+   {
+      Slot = Seq % SCI_CATALOG_ENTRY_CNT;
+      if (SciCatalog->Entry[Slot].Seq == Seq)
+      {
+         AddIndex(Slot);
+         SciCatalog->EntryCnt++;
+      }
+   }
+
+} /* End IndexEntries() */
+
+
+/******************************************************************************
+** Function: LoadCatalogFile
+**
+** Open the catalog file, load its valid entries and build the index
+**
+** Notes:
+**   1. If the file can't be opened the catalog is only kept in memory.
+**
+*/
+static void LoadCatalogFile(void)
+{
+
+   int32  SysStatus;
+   bool   FileValid = false;
+   uint32 MaxSeq = 0;
+   uint16 Slot;
+   SCI_CATALOG_FileHeader_t Header;
+   SCI_CATALOG_FileEntry_t  FileEntry;
+
+   SysStatus = OS_OpenCreate(&SciCatalog->FileHandle, SciCatalog->Filename, OS_FILE_FLAG_CREATE, OS_READ_WRITE);
+   SciCatalog->FileOpen = (SysStatus == OS_SUCCESS);
+   SciCatalog->SyncFd   = SCI_SYNC_NO_FD;
+
+   if (SciCatalog->FileOpen)
+   {
+
+      SciCatalog->SyncFd = SCI_SYNC_Open(SciCatalog->Filename);
+
+      if (OS_read(SciCatalog->FileHandle, &Header, sizeof(Header)) == sizeof(Header))
+      {
+         FileValid = (Header.Sync     == SCI_CATALOG_FILE_SYNC    &&
+                      Header.Version  == SCI_CATALOG_FILE_VERSION &&
+                      Header.EntryCnt == SCI_CATALOG_ENTRY_CNT    &&
+                      Header.EntryLen == sizeof(SCI_CATALOG_FileEntry_t));
+      }
+
+      if (FileValid)
+      {
+
+         for (Slot=0; Slot < SCI_CATALOG_ENTRY_CNT; Slot++)
+         {
+            if (OS_read(SciCatalog->FileHandle, &FileEntry, sizeof(FileEntry)) == sizeof(FileEntry))
+            {
+               if (ValidFileEntry(&FileEntry, Slot))
+               {
+                  SciCatalog->Entry[Slot] = FileEntry.Entry;
+                  if (FileEntry.Entry.Seq > MaxSeq)
+                  {
+                     MaxSeq = FileEntry.Entry.Seq;
+                  }
+               }
+            }
+         } /* End slot loop */
+
+         SciCatalog->NextSeq = MaxSeq + 1;
+         IndexEntries();
+
+      }
+      else
+      {
+
+         CreateCatalogFile();
+
+      }
+
+      CFE_EVS_SendEvent (SCI_CATALOG_CONSTRUCTOR_EID, CFE_EVS_EventType_INFORMATION,
+                         "Science file catalog %s loaded with %d files",
+                         SciCatalog->Filename, SciCatalog->EntryCnt);
+
+   }
+   else
+   {
+
+      CFE_EVS_SendEvent (SCI_CATALOG_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR,
+                         "Error opening science file catalog %s. Status = %d. Catalog won't be saved.",
+                         SciCatalog->Filename, SysStatus);
+
+   }
+
+} /* End LoadCatalogFile() */
+
+
+/******************************************************************************
+** Function: RemoveIndex
+**
+** Remove an entry's images from the index
+**
+*/
+static void RemoveIndex(uint16 Slot)
+{
+
+   const PL_MGR_CatalogEntry_t *Entry = &SciCatalog->Entry[Slot];
+   uint16 *Link;
+   uint16 Node;
+   uint16 i;
+
+   for (i=0; i < Entry->ImageCnt; i++)
+   {
+
+      Node = Slot * SCI_CATALOG_FILE_IMAGE_MAX + i;
+      Link = &SciCatalog->Bucket[HashImage(Entry->Channel, Entry->Image[i].ImageId)];
+
+      while (*Link != SCI_CATALOG_NO_NODE && *Link != Node)
+      {
+         Link = &SciCatalog->NextNode[*Link];
+      }
+
+      if (*Link == Node)
+      {
+         *Link = SciCatalog->NextNode[Node];
+      }
+
+   } /* End image loop */
+
+} /* End RemoveIndex() */
+
+
+/******************************************************************************
+** Function: ValidFileEntry
+**
+** Return true if a catalog file slot has a valid entry
+**
+*/
+static bool ValidFileEntry(const SCI_CATALOG_FileEntry_t *FileEntry, uint16 Slot)
+{
+
+   return (FileEntry->Entry.Seq != 0 &&
+           (FileEntry->Entry.Seq % SCI_CATALOG_ENTRY_CNT) == Slot &&
+           FileEntry->Entry.ImageCnt <= SCI_CATALOG_FILE_IMAGE_MAX &&
+           FileEntry->Crc == SCI_CRC_Update(SCI_CRC_INIT, &FileEntry->Entry, sizeof(PL_MGR_CatalogEntry_t)));
+
+} /* End ValidFileEntry() */
+
+
+/******************************************************************************
+** Function: WriteDumpEntry
+**
+** Write an entry's file line followed by a line for each of its images
+**
+*/
+static void WriteDumpEntry(osal_id_t FileHandle, const PL_MGR_CatalogEntry_t *Entry)
+{
+
+   char   Line[OS_MAX_PATH_LEN + 100];
+   uint16 i;
+
+   snprintf(Line, sizeof(Line), "%u %d %s %d %d 0x%04X %d %u 0x%08X %d\n",
+            (unsigned int)Entry->Seq, Entry->Channel, Entry->Filename, Entry->FileFormat,
+            Entry->Codec, Entry->Flags, Entry->Priority, (unsigned int)Entry->FileLen,
+            (unsigned int)Entry->FileCrc, Entry->ImageCnt);
+   OS_write(FileHandle, Line, strlen(Line));
+
+   for (i=0; i < Entry->ImageCnt; i++)
+   {
+      snprintf(Line, sizeof(Line), "   %d 0x%04X %u\n", Entry->Image[i].ImageId,
+               Entry->Image[i].Flags, (unsigned int)Entry->Image[i].Offset);
+      OS_write(FileHandle, Line, strlen(Line));
+   }
+
+} /* End WriteDumpEntry() */
+
+
+/******************************************************************************
+** Function: WriteEntry
+**
+** Write an entry to its catalog file slot
+**
+** Notes:
+**   1. The caller must hold the mutex.
+**   2. A sync failure is counted as a write error. SCI_SYNC reports the
+**      failure.
+**
+*/
+static void WriteEntry(uint16 Slot, bool Sync)
+{
+
+   bool RetStatus = false;
+   SCI_CATALOG_FileEntry_t FileEntry;
+
+   if (SciCatalog->FileOpen)
+   {
+
+      FileEntry.Entry = SciCatalog->Entry[Slot];
+      FileEntry.Crc   = SCI_CRC_Update(SCI_CRC_INIT, &FileEntry.Entry, sizeof(PL_MGR_CatalogEntry_t));
+
+      if (OS_lseek(SciCatalog->FileHandle, EntryOffset(Slot), OS_SEEK_SET) == (int32)EntryOffset(Slot))
+      {
+         RetStatus = (OS_write(SciCatalog->FileHandle, &FileEntry, sizeof(FileEntry)) == sizeof(FileEntry));
+      }
+
+      if (!RetStatus)
+      {
+         SciCatalog->WriteErrCnt++;
+         CFE_EVS_SendEvent (SCI_CATALOG_WRITE_ERR_EID, CFE_EVS_EventType_ERROR,
+                            "Error writing science file catalog %s entry %u for %s",
+                            SciCatalog->Filename, (unsigned int)FileEntry.Entry.Seq, FileEntry.Entry.Filename);
+      }
+      else if (Sync)
+      {
+         if (!SCI_SYNC_Descriptor(SciCatalog->SyncFd))
+         {
+            SciCatalog->WriteErrCnt++;
+         }
+      }
+
+   }
+
+} /* End WriteEntry() */
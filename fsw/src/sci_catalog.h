@@ -0,0 +1,263 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the science file catalog object
+**
+**  Notes:
+**    1. The catalog has an entry for each closed science file with the
+**       file's channel, format, length, CRC32C, fault flags and the file
+**       offset of each image's first row. SCI_FILE builds a file's entry
+**       as the file is written and adds it when the file is closed.
+**    2. The catalog file has a header followed by SCI_CATALOG_ENTRY_CNT
+**       fixed length entry slots. Each entry has a sequence number and it's
+**       written to slot (sequence number mod SCI_CATALOG_ENTRY_CNT) so the
+**       file never grows and the oldest entry is overwritten. Each slot has
+**       a CRC32C so a partially written slot is ignored when the catalog is
+**       loaded at startup.
+**    3. Images are indexed by channel and image ID in a hash table so an
+**       image's file and offset are found without a directory scan or a
+**       file parse. The index is rebuilt from the catalog file at startup.
+**       If an image ID is in more than one file the newest file is found.
+**       Only the newest SCI_CATALOG_ENTRY_CNT files are cataloged so an
+**       older file can't be found even if it's still stored. SCI_RETAIN
+**       keeps its own table so its file quota isn't limited by the catalog.
+**    4. Only the first SCI_CATALOG_FILE_IMAGE_MAX images of a file are
+**       indexed. The entry's INDEX_FULL flag is set if a file has more
+**       images.
+**    5. Entries are added by the SCI_WRITER child tasks and commands are
+**       processed by the PL_MGR main task. The exported functions use a
+**       mutex to serialize access to the object's data.
+**    6. This object is a singleton owned by the payload object.
+**    7. SCI_RETAIN uses the catalog to restore its retained files at
+**       startup and it removes an entry when it deletes the entry's file.
+**       An entry's retention priority and downlinked flag are saved in the
+**       catalog file.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _sci_catalog_
+#define _sci_catalog_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+/*
+** Event Message IDs
+*/
+
+#define SCI_CATALOG_CONSTRUCTOR_EID  (SCI_CATALOG_BASE_EID + 0)
+#define SCI_CATALOG_WRITE_ERR_EID    (SCI_CATALOG_BASE_EID + 1)
+#define SCI_CATALOG_QUERY_CMD_EID    (SCI_CATALOG_BASE_EID + 2)
+#define SCI_CATALOG_DUMP_CMD_EID     (SCI_CATALOG_BASE_EID + 3)
+
+/*
+** Catalog entry flags. An entry's flags include the flags of all of its
+** images.
+*/
+
+#define SCI_CATALOG_IMAGE_FAULT       0x0001   /* Image has a bad row          */
+#define SCI_CATALOG_IMAGE_PARTIAL     0x0002   /* Image's last row is missing  */
+#define SCI_CATALOG_FILE_INDEX_FULL   0x0100   /* See prologue notes           */
+#define SCI_CATALOG_FILE_WRITE_ERR    0x0200   /* File had a write error       */
+#define SCI_CATALOG_FILE_DOWNLINKED   0x0400   /* File has been downlinked     */
+
+/*
+** Catalog file format definitions. See prologue notes.
+*/
+
+#define SCI_CATALOG_FILE_VERSION   1
+#define SCI_CATALOG_FILE_SYNC      0x504C5343  /* "PLSC" */
+
+#define SCI_CATALOG_NO_NODE        0xFFFF
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   uint32  Sync;
+   uint16  Version;
+   uint16  EntryCnt;
+   uint32  EntryLen;
+
+} SCI_CATALOG_FileHeader_t;
+
+typedef struct
+{
+
+   PL_MGR_CatalogEntry_t  Entry;
+   uint32                 Crc;
+
+} SCI_CATALOG_FileEntry_t;
+
+
+/******************************************************************************
+** SCI_CATALOG_Class
+**
+** Entry[i] is catalog file slot i and it's unused if its sequence number is
+** 0. Image index node (i * SCI_CATALOG_FILE_IMAGE_MAX + j) is Entry[i]'s
+** image j and NextNode links the nodes in a hash bucket.
+*/
+
+typedef struct
+{
+
+   osal_id_t  MutexId;
+   osal_id_t  FileHandle;
+   int        SyncFd;      /* SCI_SYNC descriptor for FileHandle's file */
+   bool       FileOpen;
+   char       Filename[OS_MAX_PATH_LEN];
+   char       DumpFilename[OS_MAX_PATH_LEN];
+
+   uint32  NextSeq;
+   uint16  EntryCnt;
+   uint16  WriteErrCnt;
+
+   uint16  Bucket[SCI_CATALOG_HASH_LEN];
+   uint16  NextNode[SCI_CATALOG_ENTRY_CNT * SCI_CATALOG_FILE_IMAGE_MAX];
+
+   PL_MGR_CatalogEntry_t  Entry[SCI_CATALOG_ENTRY_CNT];
+
+   PL_MGR_CatalogTlm_t  CatalogTlm;
+
+} SCI_CATALOG_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+/******************************************************************************
+** Function: SCI_CATALOG_Constructor
+**
+** Initialize the catalog to a known state and load the catalog file
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**   2. The catalog file is created if it doesn't exist. It's recreated if
+**      its header doesn't match this build's catalog definitions.
+**
+*/
+void SCI_CATALOG_Constructor(SCI_CATALOG_Class_t *SciCatalogPtr, INITBL_Class_t *IniTbl);
+
+
+/******************************************************************************
+** Function: SCI_CATALOG_AddFile
+**
+** Add a closed science file's entry to the catalog
+**
+** Notes:
+**   1. The entry's sequence number is assigned by the catalog and it's
+**      returned in Entry's Seq.
+**   2. The catalog file slot is written in the caller's context. It's synced
+**      through the catalog file's SCI_SYNC descriptor when Sync is true.
+**      SCI_FILE syncs an entry unless the file's sync policy is NONE.
+**
+*/
+void SCI_CATALOG_AddFile(PL_MGR_CatalogEntry_t *Entry, bool Sync);
+
+
+/******************************************************************************
+** Function: SCI_CATALOG_DumpCmd
+**
+** Write the catalog's entries to a text file
+**
+** Notes:
+**  1. This function must comply with the CMDMGR_CmdFuncPtr definition
+**  2. Entries are written from the oldest to the newest.
+**
+*/
+bool SCI_CATALOG_DumpCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: SCI_CATALOG_GetEntry
+**
+** Load a copy of a catalog slot's entry
+**
+** Notes:
+**   1. Returns false if Slot is invalid or unused. Used to iterate over the
+**      catalog with slots from 0 to SCI_CATALOG_ENTRY_CNT-1.
+**
+*/
+bool SCI_CATALOG_GetEntry(uint16 Slot, PL_MGR_CatalogEntry_t *Entry);
+
+
+/******************************************************************************
+** Function: SCI_CATALOG_Lookup
+**
+** Find the catalog entry of the file containing a channel's image
+**
+** Notes:
+**   1. Returns false if the image isn't in the catalog. Otherwise Entry is
+**      loaded with a copy of the entry and ImageIdx is the image's index in
+**      the entry's Image array.
+**
+*/
+bool SCI_CATALOG_Lookup(uint16 Channel, uint16 ImageId, PL_MGR_CatalogEntry_t *Entry, uint16 *ImageIdx);
+
+
+/******************************************************************************
+** Function: SCI_CATALOG_QueryCmd
+**
+** Send the catalog entry of the file containing an image
+**
+** Notes:
+**  1. This function must comply with the CMDMGR_CmdFuncPtr definition
+**
+*/
+bool SCI_CATALOG_QueryCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: SCI_CATALOG_RemoveFile
+**
+** Remove a file's entry from the catalog
+**
+** Notes:
+**   1. Seq is the entry's sequence number. Nothing is done if the entry has
+**      already been overwritten.
+**
+*/
+void SCI_CATALOG_RemoveFile(uint32 Seq);
+
+
+/******************************************************************************
+** Function: SCI_CATALOG_SetRetain
+**
+** Set a file's retention priority and downlinked flag
+**
+** Notes:
+**   1. Seq is the entry's sequence number. Returns false if the entry has
+**      already been overwritten.
+**
+*/
+bool SCI_CATALOG_SetRetain(uint32 Seq, uint16 Priority, bool Downlinked);
+
+
+#endif /* _sci_catalog_ */
@@ -0,0 +1,827 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the science data lossless codecs
+**
+**  Notes:
+**    1. The LZ encoder follows the LZ4 block end conditions so a standard
+**       LZ4 block decoder can decode the output: the last match starts at
+**       least LZ_MF_LIMIT bytes before the end of the input and the last
+**       LZ_LAST_LITERALS bytes are always literals.
+**    2. The LZ encoder uses a single entry hash table and doesn't search
+**       for longer matches. This trades compression ratio for a bounded
+**       execution time per byte.
+**    3. Bits are written in chunks of up to RICE_PUT_BITS_MAX bits so a
+**       long unary quotient doesn't cost a call per bit.
+**    4. The decoders check every length and offset against the input and
+**       output buffers so malformed data can't overrun them. The Rice data
+**       has no sample count. It ends when fewer than 8 zero bits remain
+**       because every coded sample is 8 bits long or has a bit set.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**    3. CCSDS 121.0-B Lossless Data Compression
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+
+#include "app_cfg.h"
+#include "sci_codec.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define LZ_MIN_MATCH      4
+#define LZ_MF_LIMIT       12
+#define LZ_LAST_LITERALS  5
+#define LZ_MAX_OFFSET     0xFFFF
+#define LZ_RUN_MASK       15
+#define LZ_HASH_BITS      8
+#define LZ_HASH_SIZE      (1 << LZ_HASH_BITS)
+
+#define RICE_SAMPLE_BITS  8
+#define RICE_MAX_K        6
+#define RICE_PUT_BITS_MAX 24
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef struct
+{
+
+   uint8  *Out;
+   uint32  OutLen;
+   uint32  BytePos;
+   uint32  BitBuf;
+   uint32  BitCnt;
+   bool    Overflow;
+
+} BitWriter_t;
+
+typedef struct
+{
+
+   const uint8  *In;
+   uint32        InLen;
+   uint32        BitPos;
+
+} BitReader_t;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static uint32 DecodeLz(const uint8 *In, uint32 InLen, uint8 *Buf, uint32 DictLen, uint32 OutLen);
+static uint32 DecodeRice(const uint8 *In, uint32 InLen, uint8 *Out, uint32 OutLen);
+static uint32 EncodeLz(const uint8 *Buf, uint32 DictLen, uint32 InLen, uint8 *Out, uint32 OutLen);
+static uint32 EncodeRice(const uint8 *In, uint32 InLen, uint8 *Out, uint32 OutLen);
+static bool   GetBits(BitReader_t *Reader, uint32 BitCnt, uint32 *Value);
+static bool   GetUnary(BitReader_t *Reader, uint32 *Value);
+static bool   LzGetLength(const uint8 *In, uint32 InLen, uint32 *InPos, uint32 *Length);
+static uint32 LzHash(const uint8 *Data);
+static bool   LzPutSequence(uint8 *Out, uint32 OutLen, uint32 *OutPos, const uint8 *Literals,
+                            uint32 LiteralLen, uint32 Offset, uint32 MatchLen);
+static void   PutBits(BitWriter_t *Writer, uint32 Value, uint32 BitCnt);
+static bool   RiceEndOfData(const BitReader_t *Reader);
+static uint8  RiceMapResidual(uint8 Sample, uint8 Prediction);
+static bool   RiceUnmapResidual(uint32 Mapped, uint8 Prediction, uint8 *Sample);
+
+
+/******************************************************************************
+** Function: SCI_CODEC_Valid
+**
+*/
+bool SCI_CODEC_Valid(uint16 Codec)
+{
+
+   return (Codec == PL_MGR_SciFileCodec_NONE ||
+           Codec == PL_MGR_SciFileCodec_LZ   ||
+           Codec == PL_MGR_SciFileCodec_RICE);
+
+} /* End SCI_CODEC_Valid() */
+
+
+/******************************************************************************
+** Function: SCI_CODEC_Encode
+**
+*/
+uint32 SCI_CODEC_Encode(uint16 Codec, const uint8 *Buf, uint32 DictLen, uint32 InLen,
+                        uint8 *Out, uint32 OutLen)
+{
+
+   uint32 EncodedLen = 0;
+
+   switch (Codec)
+   {
+      case PL_MGR_SciFileCodec_LZ:
+         EncodedLen = EncodeLz(Buf, DictLen, InLen, Out, OutLen);
+         break;
+      case PL_MGR_SciFileCodec_RICE:
+         EncodedLen = EncodeRice(&Buf[DictLen], InLen, Out, OutLen);
+         break;
+      default:
+         break;
+   }
+
+   return EncodedLen;
+
+} /* End SCI_CODEC_Encode() */
+
+
+/******************************************************************************
+** Function: SCI_CODEC_Decode
+**
+*/
+uint32 SCI_CODEC_Decode(uint16 Codec, const uint8 *In, uint32 InLen, uint8 *Buf,
+                        uint32 DictLen, uint32 OutLen)
+{
+
+   uint32 DecodedLen = 0;
+
+   switch (Codec)
+   {
+      case PL_MGR_SciFileCodec_LZ:
+         DecodedLen = DecodeLz(In, InLen, Buf, DictLen, OutLen);
+         break;
+      case PL_MGR_SciFileCodec_RICE:
+         DecodedLen = DecodeRice(In, InLen, &Buf[DictLen], OutLen);
+         break;
+      default:
+         break;
+   }
+
+   return DecodedLen;
+
+} /* End SCI_CODEC_Decode() */
+
+
+/******************************************************************************
+** Function: DecodeLz
+**
+** Notes:
+**   1. Decoded bytes follow the DictLen dictionary bytes in Buf and match
+**      offsets are relative to Buf so matches can reference the dictionary.
+**   2. Matches are copied a byte at a time because a match may overlap the
+**      bytes that it produces.
+**
+*/
+static uint32 DecodeLz(const uint8 *In, uint32 InLen, uint8 *Buf, uint32 DictLen, uint32 OutLen)
+{
+
+   uint32 InPos  = 0;
+   uint32 Pos    = DictLen;
+   uint32 BufEnd = DictLen + OutLen;
+   uint32 LiteralLen;
+   uint32 MatchLen;
+   uint32 Offset;
+   uint32 i;
+   uint8  Token;
+   bool   Valid = true;
+   bool   Done  = false;
+
+   while (InPos < InLen && Valid && !Done)
+   {
+
+      Token      = In[InPos++];
+      LiteralLen = Token >> 4;
+      Valid = LzGetLength(In, InLen, &InPos, &LiteralLen) &&
+              LiteralLen <= (InLen - InPos) && LiteralLen <= (BufEnd - Pos);
+
+      if (Valid)
+      {
+
+         memcpy(&Buf[Pos], &In[InPos], LiteralLen);
+         Pos   += LiteralLen;
+         InPos += LiteralLen;
+
+         /* The last sequence is a literal run without a match */
+         if (InPos == InLen)
+         {
+            Done = true;
+         }
+         else if ((InLen - InPos) >= 2)
+         {
+            Offset   = (uint32)In[InPos] | ((uint32)In[InPos + 1] << 8);
+            InPos   += 2;
+            MatchLen = Token & LZ_RUN_MASK;
+            Valid    = LzGetLength(In, InLen, &InPos, &MatchLen);
+            MatchLen += LZ_MIN_MATCH;
+            if (Valid && Offset > 0 && Offset <= Pos && MatchLen <= (BufEnd - Pos))
+            {
+               for (i = 0; i < MatchLen; i++)
+               {
+                  Buf[Pos + i] = Buf[Pos - Offset + i];
+               }
+               Pos += MatchLen;
+            }
+            else
+            {
+               Valid = false;
+            }
+         }
+         else
+         {
+            Valid = false;
+         }
+
+      } /* End if valid literal run */
+
+   } /* End sequence loop */
+
+   return ((Valid && Done) ? (Pos - DictLen) : 0);
+
+} /* End DecodeLz() */
+
+
+/******************************************************************************
+** Function: DecodeRice
+**
+** Notes:
+**   1. See prologue notes for the end of the data.
+**
+*/
+static uint32 DecodeRice(const uint8 *In, uint32 InLen, uint8 *Out, uint32 OutLen)
+{
+
+   BitReader_t Reader;
+   uint32 OutPos = 0;
+   uint32 Id     = 0;
+   uint32 Mapped = 0;
+   uint32 Remainder = 0;
+   uint32 i;
+   bool   Valid = (InLen > 0 && OutLen > 0);
+   bool   Done  = false;
+
+   Reader.In     = In;
+   Reader.InLen  = InLen;
+   Reader.BitPos = 0;
+
+   if (Valid)
+   {
+      Valid = GetBits(&Reader, RICE_SAMPLE_BITS, &Mapped);
+      Out[OutPos++] = (uint8)Mapped;
+   }
+
+   while (Valid && !Done)
+   {
+
+      if (RiceEndOfData(&Reader))
+      {
+         Done = true;
+      }
+      else
+      {
+
+         Valid = GetBits(&Reader, SCI_CODEC_RICE_ID_BITS, &Id);
+
+         for (i = 0; i < SCI_CODEC_RICE_BLOCK_LEN && Valid && !Done; i++)
+         {
+
+            if (RiceEndOfData(&Reader))
+            {
+               Done = true;
+            }
+            else if (OutPos >= OutLen)
+            {
+               Valid = false;
+            }
+            else
+            {
+               if (Id == SCI_CODEC_RICE_RAW_ID)
+               {
+                  Valid = GetBits(&Reader, RICE_SAMPLE_BITS, &Mapped);
+               }
+               else
+               {
+                  Valid  = GetUnary(&Reader, &Mapped) && GetBits(&Reader, Id, &Remainder);
+                  Mapped = (Mapped << Id) | Remainder;
+               }
+               Valid = Valid && RiceUnmapResidual(Mapped, Out[OutPos - 1], &Out[OutPos]);
+               OutPos++;
+            }
+
+         } /* End block loop */
+      }
+
+   } /* End while data */
+
+   return (Valid ? OutPos : 0);
+
+} /* End DecodeRice() */
+
+
+/******************************************************************************
+** Function: EncodeLz
+**
+** Notes:
+**   1. Buf contains DictLen dictionary bytes followed by InLen input bytes.
+**      Hash table positions are Buf indices plus one so zero is empty.
+**
+*/
+static uint32 EncodeLz(const uint8 *Buf, uint32 DictLen, uint32 InLen, uint8 *Out, uint32 OutLen)
+{
+
+   uint32 HashTbl[LZ_HASH_SIZE];
+   uint32 BufLen     = DictLen + InLen;
+   uint32 MatchLimit = (InLen > LZ_MF_LIMIT) ? (BufLen - LZ_MF_LIMIT) : 0;
+   uint32 MatchEnd   = BufLen - LZ_LAST_LITERALS;
+   uint32 Pos;
+   uint32 AnchorPos  = DictLen;
+   uint32 RefPos;
+   uint32 MatchLen;
+   uint32 Hash;
+   uint32 OutPos     = 0;
+   bool   Overflow   = false;
+
+   memset(HashTbl, 0, sizeof(HashTbl));
+
+   for (Pos = 0; (Pos + LZ_MIN_MATCH) <= DictLen; Pos++)
+   {
+      HashTbl[LzHash(&Buf[Pos])] = Pos + 1;
+   }
+
+   Pos = DictLen;
+   while (Pos < MatchLimit && !Overflow)
+   {
+
+      Hash   = LzHash(&Buf[Pos]);
+      RefPos = HashTbl[Hash];
+      HashTbl[Hash] = Pos + 1;
+
+      if (RefPos > 0 && (Pos - (RefPos - 1)) <= LZ_MAX_OFFSET &&
+          memcmp(&Buf[RefPos - 1], &Buf[Pos], LZ_MIN_MATCH) == 0)
+      {
+
+         RefPos--;
+         MatchLen = LZ_MIN_MATCH;
+         while ((Pos + MatchLen) < MatchEnd && Buf[RefPos + MatchLen] == Buf[Pos + MatchLen])
+         {
+            MatchLen++;
+         }
+
+         Overflow = !LzPutSequence(Out, OutLen, &OutPos, &Buf[AnchorPos], Pos - AnchorPos,
+                                   Pos - RefPos, MatchLen);
+         Pos += MatchLen;
+         AnchorPos = Pos;
+
+      }
+      else
+      {
+         Pos++;
+      }
+
+   } /* End while matches allowed */
+
+   if (!Overflow)
+   {
+      Overflow = !LzPutSequence(Out, OutLen, &OutPos, &Buf[AnchorPos], BufLen - AnchorPos, 0, 0);
+   }
+
+   return (Overflow ? 0 : OutPos);
+
+} /* End EncodeLz() */
+
+
+/******************************************************************************
+** Function: EncodeRice
+**
+** Notes:
+**   1. The Rice parameter for each block is the one that produces the
+**      fewest bits. If no parameter beats the raw sample size the block is
+**      stored with the raw option.
+**
+*/
+static uint32 EncodeRice(const uint8 *In, uint32 InLen, uint8 *Out, uint32 OutLen)
+{
+
+   BitWriter_t Writer;
+   uint8  Mapped[SCI_CODEC_RICE_BLOCK_LEN];
+   uint32 SampleIdx;
+   uint32 BlockLen;
+   uint32 BlockBits;
+   uint32 BestBits;
+   uint32 BestId;
+   uint32 ZeroCnt;
+   uint32 k;
+   uint32 i;
+
+   memset(&Writer, 0, sizeof(Writer));
+   Writer.Out    = Out;
+   Writer.OutLen = OutLen;
+
+   if (InLen > 0)
+   {
+
+      PutBits(&Writer, In[0], RICE_SAMPLE_BITS);
+
+      for (SampleIdx = 1; SampleIdx < InLen && !Writer.Overflow; SampleIdx += BlockLen)
+      {
+
+         BlockLen = InLen - SampleIdx;
+         if (BlockLen > SCI_CODEC_RICE_BLOCK_LEN)
+         {
+            BlockLen = SCI_CODEC_RICE_BLOCK_LEN;
+         }
+
+         for (i = 0; i < BlockLen; i++)
+         {
+            Mapped[i] = RiceMapResidual(In[SampleIdx + i], In[SampleIdx + i - 1]);
+         }
+
+         BestId   = SCI_CODEC_RICE_RAW_ID;
+         BestBits = BlockLen * RICE_SAMPLE_BITS;
+         for (k = 0; k <= RICE_MAX_K; k++)
+         {
+            BlockBits = 0;
+            for (i = 0; i < BlockLen; i++)
+            {
+               BlockBits += (Mapped[i] >> k) + 1 + k;
+            }
+            if (BlockBits < BestBits)
+            {
+               BestBits = BlockBits;
+               BestId   = k;
+            }
+         }
+
+         PutBits(&Writer, BestId, SCI_CODEC_RICE_ID_BITS);
+         for (i = 0; i < BlockLen; i++)
+         {
+            if (BestId == SCI_CODEC_RICE_RAW_ID)
+            {
+               PutBits(&Writer, Mapped[i], RICE_SAMPLE_BITS);
+            }
+            else
+            {
+               /*
+               ** Unary coded quotient is a run of zeros terminated by a one
+               ** and it's followed by the BestId bit remainder
+               */
+               for (k = Mapped[i] >> BestId; (k + 1 + BestId) > RICE_PUT_BITS_MAX; k -= ZeroCnt)
+               {
+                  ZeroCnt = (k < RICE_PUT_BITS_MAX) ? k : RICE_PUT_BITS_MAX;
+                  PutBits(&Writer, 0, ZeroCnt);
+               }
+               PutBits(&Writer, (1 << BestId) | (Mapped[i] & ((1 << BestId) - 1)), k + 1 + BestId);
+            }
+         }
+
+      } /* End block loop */
+
+      if (Writer.BitCnt > 0)
+      {
+         PutBits(&Writer, 0, 8 - Writer.BitCnt);
+      }
+
+   } /* End if InLen > 0 */
+
+   return (Writer.Overflow ? 0 : Writer.BytePos);
+
+} /* End EncodeRice() */
+
+
+/******************************************************************************
+** Function: GetBits
+**
+** Read BitCnt bits, most significant first
+**
+** Notes:
+**   1. BitCnt must not exceed RICE_PUT_BITS_MAX.
+**
+*/
+static bool GetBits(BitReader_t *Reader, uint32 BitCnt, uint32 *Value)
+{
+
+   bool   RetStatus = false;
+   uint32 BytePos   = Reader->BitPos >> 3;
+   uint32 Window    = 0;
+   uint32 i;
+
+   if ((Reader->BitPos + BitCnt) <= (Reader->InLen * 8))
+   {
+
+      for (i = 0; i < 4; i++)
+      {
+         Window <<= 8;
+         if ((BytePos + i) < Reader->InLen)
+         {
+            Window |= Reader->In[BytePos + i];
+         }
+      }
+
+      *Value = (BitCnt > 0) ? ((Window << (Reader->BitPos & 7)) >> (32 - BitCnt)) : 0;
+      Reader->BitPos += BitCnt;
+      RetStatus = true;
+
+   }
+
+   return RetStatus;
+
+} /* End GetBits() */
+
+
+/******************************************************************************
+** Function: GetUnary
+**
+** Read a run of zeros terminated by a one and return the run length
+**
+** Notes:
+**   1. Whole bytes of zeros are skipped at once.
+**
+*/
+static bool GetUnary(BitReader_t *Reader, uint32 *Value)
+{
+
+   bool   RetStatus = false;
+   uint32 BytePos;
+   uint8  Bits;
+
+   *Value = 0;
+
+   while (!RetStatus && (Reader->BitPos >> 3) < Reader->InLen)
+   {
+
+      BytePos = Reader->BitPos >> 3;
+      Bits    = (uint8)(Reader->In[BytePos] << (Reader->BitPos & 7));
+
+      if (Bits == 0)
+      {
+         *Value += 8 - (Reader->BitPos & 7);
+         Reader->BitPos = (BytePos + 1) * 8;
+      }
+      else
+      {
+         while ((Bits & 0x80) == 0)
+         {
+            Bits <<= 1;
+            (*Value)++;
+            Reader->BitPos++;
+         }
+         Reader->BitPos++;
+         RetStatus = true;
+      }
+
+   } /* End while bytes */
+
+   return RetStatus;
+
+} /* End GetUnary() */
+
+
+/******************************************************************************
+** Function: LzGetLength
+**
+** Add a length's extension bytes when its token field is saturated
+**
+*/
+static bool LzGetLength(const uint8 *In, uint32 InLen, uint32 *InPos, uint32 *Length)
+{
+
+   bool  RetStatus = true;
+   uint8 Byte = 255;
+
+   if (*Length == LZ_RUN_MASK)
+   {
+      while (Byte == 255 && RetStatus)
+      {
+         if (*InPos < InLen)
+         {
+            Byte     = In[(*InPos)++];
+            *Length += Byte;
+         }
+         else
+         {
+            RetStatus = false;
+         }
+      }
+   }
+
+   return RetStatus;
+
+} /* End LzGetLength() */
+
+
+/******************************************************************************
+** Function: LzHash
+**
+*/
+static uint32 LzHash(const uint8 *Data)
+{
+
+   uint32 Sequence = (uint32)Data[0] | ((uint32)Data[1] << 8) |
+                     ((uint32)Data[2] << 16) | ((uint32)Data[3] << 24);
+
+   return ((Sequence * 2654435761U) >> (32 - LZ_HASH_BITS));
+
+} /* End LzHash() */
+
+
+/******************************************************************************
+** Function: LzPutSequence
+**
+** Write an LZ4 sequence. A MatchLen of zero writes the final literal run.
+**
+*/
+static bool LzPutSequence(uint8 *Out, uint32 OutLen, uint32 *OutPos, const uint8 *Literals,
+                          uint32 LiteralLen, uint32 Offset, uint32 MatchLen)
+{
+
+   bool   RetStatus = false;
+   uint32 Pos = *OutPos;
+   uint32 MaxLen;
+   uint32 RunLen;
+   uint8 *Token;
+
+   MaxLen = 1 + LiteralLen + (LiteralLen / 255) + 1;
+   if (MatchLen > 0)
+   {
+      MaxLen += 2 + ((MatchLen - LZ_MIN_MATCH) / 255) + 1;
+   }
+
+   if ((Pos + MaxLen) <= OutLen)
+   {
+
+      Token  = &Out[Pos++];
+      *Token = ((LiteralLen < LZ_RUN_MASK) ? LiteralLen : LZ_RUN_MASK) << 4;
+      if (LiteralLen >= LZ_RUN_MASK)
+      {
+         for (RunLen = LiteralLen - LZ_RUN_MASK; RunLen >= 255; RunLen -= 255)
+         {
+            Out[Pos++] = 255;
+         }
+         Out[Pos++] = (uint8)RunLen;
+      }
+
+      memcpy(&Out[Pos], Literals, LiteralLen);
+      Pos += LiteralLen;
+
+      if (MatchLen > 0)
+      {
+         Out[Pos++] = (uint8)(Offset & 0xFF);
+         Out[Pos++] = (uint8)(Offset >> 8);
+
+         RunLen  = MatchLen - LZ_MIN_MATCH;
+         *Token |= (RunLen < LZ_RUN_MASK) ? RunLen : LZ_RUN_MASK;
+         if (RunLen >= LZ_RUN_MASK)
+         {
+            for (RunLen -= LZ_RUN_MASK; RunLen >= 255; RunLen -= 255)
+            {
+               Out[Pos++] = 255;
+            }
+            Out[Pos++] = (uint8)RunLen;
+         }
+      }
+
+      *OutPos   = Pos;
+      RetStatus = true;
+
+   }
+
+   return RetStatus;
+
+} /* End LzPutSequence() */
+
+
+/******************************************************************************
+** Function: PutBits
+**
+** Append the BitCnt least significant bits of Value, most significant first
+**
+** Notes:
+**   1. BitCnt must not exceed RICE_PUT_BITS_MAX. BitBuf holds fewer than 8
+**      bits between calls so the appended bits always fit in it.
+**
+*/
+static void PutBits(BitWriter_t *Writer, uint32 Value, uint32 BitCnt)
+{
+
+   Writer->BitBuf  = (Writer->BitBuf << BitCnt) | (Value & ((1U << BitCnt) - 1));
+   Writer->BitCnt += BitCnt;
+
+   while (Writer->BitCnt >= 8 && !Writer->Overflow)
+   {
+      Writer->BitCnt -= 8;
+      if (Writer->BytePos < Writer->OutLen)
+      {
+         Writer->Out[Writer->BytePos++] = (uint8)(Writer->BitBuf >> Writer->BitCnt);
+      }
+      else
+      {
+         Writer->Overflow = true;
+      }
+   }
+
+   Writer->BitBuf &= (1U << Writer->BitCnt) - 1;
+
+} /* End PutBits() */
+
+
+/******************************************************************************
+** Function: RiceMapResidual
+**
+** Map a prediction residual to a non-negative value using the CCSDS 121.0-B
+** prediction error mapping.
+**
+*/
+static uint8 RiceMapResidual(uint8 Sample, uint8 Prediction)
+{
+
+   int32 Delta = (int32)Sample - (int32)Prediction;
+   int32 Theta = (Prediction < (255 - Prediction)) ? Prediction : (255 - Prediction);
+   int32 Mapped;
+
+   if (Delta >= 0 && Delta <= Theta)
+   {
+      Mapped = 2 * Delta;
+   }
+   else if (Delta < 0 && Delta >= -Theta)
+   {
+      Mapped = -2 * Delta - 1;
+   }
+   else
+   {
+      Mapped = Theta + ((Delta < 0) ? -Delta : Delta);
+   }
+
+   return (uint8)Mapped;
+
+} /* End RiceMapResidual() */
+
+
+/******************************************************************************
+** Function: RiceEndOfData
+**
+** Return true if only the last byte's zero padding remains
+**
+*/
+static bool RiceEndOfData(const BitReader_t *Reader)
+{
+
+   bool   RetStatus = false;
+   uint32 BitsLeft  = (Reader->InLen * 8) - Reader->BitPos;
+
+   if (BitsLeft < 8)
+   {
+      RetStatus = ((Reader->In[Reader->InLen - 1] & ((1U << BitsLeft) - 1)) == 0);
+   }
+
+   return RetStatus;
+
+} /* End RiceEndOfData() */
+
+
+/******************************************************************************
+** Function: RiceUnmapResidual
+**
+** Invert RiceMapResidual() and return false if the sample is out of range
+**
+*/
+static bool RiceUnmapResidual(uint32 Mapped, uint8 Prediction, uint8 *Sample)
+{
+
+   int32 Theta = (Prediction < (255 - Prediction)) ? Prediction : (255 - Prediction);
+   int32 Delta;
+   int32 Value;
+
+   if (Mapped <= (uint32)(2 * Theta))
+   {
+      Delta = (Mapped & 1) ? -(int32)((Mapped + 1) / 2) : (int32)(Mapped / 2);
+   }
+   else if (Theta == Prediction)
+   {
+      Delta = (int32)Mapped - Theta;
+   }
+   else
+   {
+      Delta = Theta - (int32)Mapped;
+   }
+
+   Value   = (int32)Prediction + Delta;
+   *Sample = (uint8)Value;
+
+   return (Value >= 0 && Value <= 255);
+
+} /* End RiceUnmapResidual() */
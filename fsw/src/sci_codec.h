@@ -0,0 +1,106 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the science data lossless codecs
+**
+**  Notes:
+**    1. The codecs are stateless functions so they have no constructor and
+**       can be used by any object. The caller owns all of the buffers.
+**    2. The LZ codec produces an LZ4 block: a sequence of tokens, each with
+**       a literal run and a match copy from up to 64KB back. The input can
+**       be preceded by a dictionary, for example the previous detector row,
+**       that matches may reference. The dictionary isn't part of the
+**       output so a decoder must have the same dictionary.
+**    3. The Rice codec is modeled on CCSDS 121.0-B adaptive entropy coding
+**       of 8-bit samples. The first sample is stored verbatim and the rest
+**       use a unit-delay predictor whose residuals are mapped to
+**       non-negative values. Each block of SCI_CODEC_RICE_BLOCK_LEN mapped
+**       residuals is preceded by a 3-bit option ID that is either the
+**       Rice parameter k (0..6) or SCI_CODEC_RICE_RAW_ID for 8-bit samples.
+**       Bits are packed most significant bit first and the last byte is
+**       zero padded. The Rice codec doesn't use a dictionary.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**    3. CCSDS 121.0-B Lossless Data Compression
+**
+*/
+#ifndef _sci_codec_
+#define _sci_codec_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SCI_CODEC_RICE_BLOCK_LEN  16
+#define SCI_CODEC_RICE_ID_BITS    3
+#define SCI_CODEC_RICE_RAW_ID     7
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SCI_CODEC_Valid
+**
+** Return true if Codec is a supported PL_MGR_SciFileCodec value.
+**
+*/
+bool SCI_CODEC_Valid(uint16 Codec);
+
+
+/******************************************************************************
+** Function: SCI_CODEC_Encode
+**
+** Encode InLen bytes that follow a DictLen byte dictionary in Buf.
+**
+** Notes:
+**   1. Returns the number of encoded bytes written to Out. Zero is returned
+**      if the encoded data doesn't fit in OutLen bytes so callers can limit
+**      OutLen to only accept encodings that save space.
+**   2. PL_MGR_SciFileCodec_NONE always returns zero.
+**
+*/
+uint32 SCI_CODEC_Encode(uint16 Codec, const uint8 *Buf, uint32 DictLen, uint32 InLen,
+                        uint8 *Out, uint32 OutLen);
+
+
+/******************************************************************************
+** Function: SCI_CODEC_Decode
+**
+** Decode InLen encoded bytes into Buf following a DictLen byte dictionary.
+**
+** Notes:
+**   1. Returns the number of decoded bytes written to Buf after the
+**      dictionary. Zero is returned if the encoded data is malformed or
+**      it decodes to more than OutLen bytes.
+**   2. The dictionary must be the one that was used to encode the data.
+**   3. PL_MGR_SciFileCodec_NONE always returns zero.
+**
+*/
+uint32 SCI_CODEC_Decode(uint16 Codec, const uint8 *In, uint32 InLen, uint8 *Buf,
+                        uint32 DictLen, uint32 OutLen);
+
+
+#endif /* _sci_codec_ */
@@ -0,0 +1,152 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the science data CRC32C utility
+**
+**  Notes:
+**    1. The slice-by-8 implementation combines data bytes explicitly so it
+**       doesn't depend on the processor's byte order.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+
+#include "app_cfg.h"
+#include "sci_crc.h"
+
+#if (PL_MGR_SCI_CRC_HW != 0) && defined(__SSE4_2__)
+   #include <nmmintrin.h>
+   #define SCI_CRC_USE_SSE42
+#endif
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define CRC32C_POLY  0x82F63B78
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static uint32 CrcTbl[8][256];
+
+
+/******************************************************************************
+** Function: SCI_CRC_InitTables
+**
+*/
+void SCI_CRC_InitTables(void)
+{
+
+   uint32 Crc;
+   uint32 i;
+   uint32 j;
+
+   for (i = 0; i < 256; i++)
+   {
+      Crc = i;
+      for (j = 0; j < 8; j++)
+      {
+         Crc = (Crc & 1) ? ((Crc >> 1) ^ CRC32C_POLY) : (Crc >> 1);
+      }
+      CrcTbl[0][i] = Crc;
+   }
+
+   for (i = 0; i < 256; i++)
+   {
+      for (j = 1; j < 8; j++)
+      {
+         CrcTbl[j][i] = (CrcTbl[j-1][i] >> 8) ^ CrcTbl[0][CrcTbl[j-1][i] & 0xFF];
+      }
+   }
+
+} /* End SCI_CRC_InitTables() */
+
+
+/******************************************************************************
+** Function: SCI_CRC_Update
+**
+*/
+uint32 SCI_CRC_Update(uint32 Crc, const void *Data, uint32 DataLen)
+{
+
+   const uint8 *Byte = (const uint8 *)Data;
+   uint32 Reg = ~Crc;
+
+#ifdef SCI_CRC_USE_SSE42
+
+   #if defined(__x86_64__)
+   uint64 Word;
+   
+   while (DataLen >= 8)
+   {
+      memcpy(&Word, Byte, sizeof(Word));
+      Reg = (uint32)_mm_crc32_u64(Reg, Word);
+      Byte    += 8;
+      DataLen -= 8;
+   }
+   #else
+   uint32 Word;
+   
+   while (DataLen >= 4)
+   {
+      memcpy(&Word, Byte, sizeof(Word));
+      Reg = _mm_crc32_u32(Reg, Word);
+      Byte    += 4;
+      DataLen -= 4;
+   }
+   #endif
+
+   while (DataLen > 0)
+   {
+      Reg = _mm_crc32_u8(Reg, *Byte++);
+      DataLen--;
+   }
+
+#else
+
+   while (DataLen >= 8)
+   {
+      Reg ^= (uint32)Byte[0] | ((uint32)Byte[1] << 8) | ((uint32)Byte[2] << 16) | ((uint32)Byte[3] << 24);
+      Reg  = CrcTbl[7][Reg & 0xFF] ^ CrcTbl[6][(Reg >> 8) & 0xFF] ^
+             CrcTbl[5][(Reg >> 16) & 0xFF] ^ CrcTbl[4][Reg >> 24] ^
+             CrcTbl[3][Byte[4]] ^ CrcTbl[2][Byte[5]] ^
+             CrcTbl[1][Byte[6]] ^ CrcTbl[0][Byte[7]];
+      Byte    += 8;
+      DataLen -= 8;
+   }
+
+   while (DataLen > 0)
+   {
+      Reg = (Reg >> 8) ^ CrcTbl[0][(Reg ^ *Byte++) & 0xFF];
+      DataLen--;
+   }
+
+#endif
+
+   return ~Reg;
+
+} /* End SCI_CRC_Update() */
@@ -0,0 +1,79 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the science data CRC32C (Castagnoli) utility
+**
+**  Notes:
+**    1. The CRC uses the reflected 0x82F63B78 polynomial with an initial
+**       value and final XOR of 0xFFFFFFFF so it matches iSCSI, ext4 and the
+**       SSE4.2 crc32 instruction. The check value of "123456789" is
+**       0xE3069283.
+**    2. The SSE4.2 crc32 instruction is used when the compiler targets it
+**       and PL_MGR_SCI_CRC_HW is non-zero in the platform configuration
+**       file. Otherwise a slice-by-8 table implementation is used.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _sci_crc_
+#define _sci_crc_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define SCI_CRC_INIT  0
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SCI_CRC_InitTables
+**
+** Build the slice-by-8 lookup tables
+**
+** Notes:
+**   1. This must be called prior to SCI_CRC_Update() and before any child
+**      task that computes CRCs is started.
+**
+*/
+void SCI_CRC_InitTables(void);
+
+
+/******************************************************************************
+** Function: SCI_CRC_Update
+**
+** Return the CRC of Crc's data followed by DataLen bytes of Data
+**
+** Notes:
+**   1. Start a CRC with SCI_CRC_INIT. The returned value is a complete CRC
+**      and can be passed to a subsequent call to extend it.
+**
+*/
+uint32 SCI_CRC_Update(uint32 Crc, const void *Data, uint32 DataLen);
+
+
+#endif /* _sci_crc_ */
@@ -33,99 +33,381 @@
 
 #include "app_cfg.h"
 #include "sci_file.h"
+#include "sci_retain.h"
+#include "perf_hist.h"
 
 
 /**********************/
 /** Global File Data **/
 /**********************/
 
-static SCI_FILE_Class_t *SciFile = NULL;
-
-
 /*******************************/
 /** Local Function Prototypes **/
 /*******************************/
 
-static void InitFileState(void);
-static void CreateCntFilename(uint16 ImageId);
-static bool CreateFile(uint16 ImageId);
-static void CloseFile(void);
-static bool WriteDetectorRow(PL_SIM_LIB_DetectorRow_t *DetectorRow);
+static void InitFileState(SCI_FILE_Class_t *SciFile);
+static void ApplyConfig(SCI_FILE_Class_t *SciFile);
+static void CatalogRow(SCI_FILE_Class_t *SciFile, const PL_SIM_LIB_Detector_t *Detector, SCI_FILE_Control_t Control,
+                       bool RowFault);
+static void CloseAllFiles(SCI_FILE_Class_t *SciFile);
+static void CloseFile(SCI_FILE_Class_t *SciFile);
+static void CloseSlot(SCI_FILE_Class_t *SciFile, SCI_FILE_Slot_t *Slot);
+static void CommitFile(SCI_FILE_Slot_t *Slot);
+static void CreateCntFilename(SCI_FILE_Class_t *SciFile, char *Filename, uint16 ImageId);
+static void CreateNextFilename(SCI_FILE_Class_t *SciFile, char *TmpFilename);
+static void CreateTmpFilename(char *TmpFilename, const char *Filename);
+static bool CreateFile(SCI_FILE_Class_t *SciFile, uint16 ImageId);
+static void DiscardSlot(SCI_FILE_Class_t *SciFile, SCI_FILE_Slot_t *Slot);
+static void FinishFile(SCI_FILE_Class_t *SciFile);
+static bool FlushWriteBuf(SCI_FILE_Class_t *SciFile);
+static uint32 MaxFileLen(const PL_MGR_ConfigSciFile_Payload_t *Config);
+static bool OpenSlot(SCI_FILE_Class_t *SciFile, SCI_FILE_Slot_t *Slot, uint16 ImageId, bool NextFile);
+static void OpenSyncFd(SCI_FILE_Slot_t *Slot);
+static void PublishStatus(SCI_FILE_Class_t *SciFile);
+static bool RecoverFile(SCI_FILE_Slot_t *Slot);
+static bool ReleaseTmpName(SCI_FILE_Class_t *SciFile, const char *TmpFilename);
+static void RestoreCheckpoint(SCI_FILE_Class_t *SciFile);
+static void RestoreSlot(SCI_FILE_Slot_t *Slot, const SCI_FILE_SlotCheckpoint_t *SlotCheckpoint);
+static void ResumeCollection(SCI_FILE_Class_t *SciFile);
+static bool ResumeFile(SCI_FILE_Class_t *SciFile);
+static void RotateFile(SCI_FILE_Class_t *SciFile);
+static void SaveCheckpoint(SCI_FILE_Class_t *SciFile, bool ImageBoundary);
+static void SaveSlot(SCI_FILE_SlotCheckpoint_t *SlotCheckpoint, const SCI_FILE_Slot_t *Slot);
+static void ScheduleSync(SCI_FILE_Class_t *SciFile);
+static bool SyncFile(SCI_FILE_Class_t *SciFile, SCI_FILE_Slot_t *Slot);
+static bool UniqueFilename(SCI_FILE_Slot_t *Slot);
+static bool UseNextFile(SCI_FILE_Class_t *SciFile, uint16 ImageId);
+static bool StageData(SCI_FILE_Class_t *SciFile, const void *Data, uint32 DataLen);
+static const uint8 *BuildRecord(SCI_FILE_Encoder_t *Encoder, uint16 Codec, const PL_MGR_SciRoi_t *Roi,
+                                const PL_SIM_LIB_Detector_t *Detector, uint16 RecordFlags, uint8 *EncodeBuf,
+                                SCI_FILE_BinRecordHdr_t *RecordHdr, uint32 *ImageCrc, uint32 *CodecUsec);
+static const uint8 *EncodeRow(SCI_FILE_Encoder_t *Encoder, uint16 Codec, const PL_SIM_LIB_Detector_t *Detector,
+                              const uint8 *RowData, uint32 RowLen, uint8 *EncodeBuf,
+                              SCI_FILE_BinRecordHdr_t *RecordHdr, uint32 *CodecUsec);
+static const SCI_FILE_BinRecord_t *GetRecord(SCI_FILE_Class_t *SciFile, const SCI_FILE_EncodedImage_t *EncodedImage,
+                                             uint16 RowIdx);
+static bool SelectRow(const PL_MGR_SciRoi_t *Roi, const PL_SIM_LIB_Detector_t *Detector, uint16 *RecordFlags);
+static bool ValidCodec(uint16 FileFormat, uint16 Codec);
+static bool ValidFileFormat(uint16 FileFormat);
+static bool ValidFilename(const char *BasePathFilename, const char *FileExtension);
+static bool ValidSync(uint16 SyncPolicy, uint16 SyncInterval);
+static bool WriteBinHeader(SCI_FILE_Class_t *SciFile, uint16 ImageId);
+static bool WriteBinTrailer(SCI_FILE_Class_t *SciFile);
+static bool WriteDetectorRow(SCI_FILE_Class_t *SciFile, const PL_SIM_LIB_Detector_t *Detector, SCI_FILE_Control_t Control,
+                             const SCI_FILE_BinRecord_t *Record, bool RowFault);
+static bool WriteFileData(SCI_FILE_Class_t *SciFile, const void *Data, uint32 DataLen);
+static bool WriteTextHeader(SCI_FILE_Class_t *SciFile, uint16 ImageId);
+static void WriteRow(SCI_FILE_Class_t *SciFile, const PL_SIM_LIB_Detector_t *Detector, SCI_FILE_Control_t Control,
+                     const SCI_FILE_EncodedImage_t *EncodedImage, uint16 RowIdx, bool RowFault);
 
 
 /******************************************************************************
 ** Function: SCI_FILE_Constructor
 **
 */
-void SCI_FILE_Constructor(SCI_FILE_Class_t *SciFilePtr, INITBL_Class_t *IniTbl)
+void SCI_FILE_Constructor(SCI_FILE_Class_t *SciFile, INITBL_Class_t *IniTbl, uint16 Channel)
 {
  
-   SciFile = SciFilePtr;
-
+   char MutexName[OS_MAX_API_NAME];
+   
    CFE_PSP_MemSet((void*)SciFile, 0, sizeof(SCI_FILE_Class_t));
+   
+   SCI_CRC_InitTables();
+   
+   SciFile->Channel = Channel;
     
    /* Load initialization configurations */
    
    SciFile->Config.ImagesPerFile = INITBL_GetIntConfig(IniTbl, CFG_SCI_FILE_IMAGE_CNT);
-   strncpy(SciFile->Config.BasePathFilename,
-           INITBL_GetStrConfig(IniTbl, CFG_SCI_FILE_PATH_BASE),
-           OS_MAX_PATH_LEN);
+   if (Channel == 0)
+   {
+      snprintf(SciFile->Config.BasePathFilename, OS_MAX_PATH_LEN, "%s",
+               INITBL_GetStrConfig(IniTbl, CFG_SCI_FILE_PATH_BASE));
+   }
+   else
+   {
+      snprintf(SciFile->Config.BasePathFilename, OS_MAX_PATH_LEN, "%sch%d_",
+               INITBL_GetStrConfig(IniTbl, CFG_SCI_FILE_PATH_BASE), Channel);
+   }
    strncpy(SciFile->Config.FileExtension,
            INITBL_GetStrConfig(IniTbl, CFG_SCI_FILE_EXTENSION),
            SCI_FILE_EXT_MAX_CHAR);
 
+   SciFile->Config.FileFormat = INITBL_GetIntConfig(IniTbl, CFG_SCI_FILE_FORMAT);
+   if (!ValidFileFormat(SciFile->Config.FileFormat))
+   {
+      CFE_EVS_SendEvent (SCI_FILE_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR, 
+                         "Invalid science file format %d. Using text format.",
+                         SciFile->Config.FileFormat);
+      SciFile->Config.FileFormat = PL_MGR_SciFileFormat_TEXT;
+   }
+
+   SciFile->Config.Codec = INITBL_GetIntConfig(IniTbl, CFG_SCI_FILE_CODEC);
+   if (!ValidCodec(SciFile->Config.FileFormat, SciFile->Config.Codec))
+   {
+      CFE_EVS_SendEvent (SCI_FILE_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR, 
+                         "Invalid science file codec %d for file format %d. Files will not be compressed.",
+                         SciFile->Config.Codec, SciFile->Config.FileFormat);
+      SciFile->Config.Codec = PL_MGR_SciFileCodec_NONE;
+   }
+
+   SciFile->Config.SyncPolicy   = INITBL_GetIntConfig(IniTbl, CFG_SCI_FILE_SYNC);
+   SciFile->Config.SyncInterval = INITBL_GetIntConfig(IniTbl, CFG_SCI_FILE_SYNC_INTERVAL);
+   if (!ValidSync(SciFile->Config.SyncPolicy, SciFile->Config.SyncInterval))
+   {
+      CFE_EVS_SendEvent (SCI_FILE_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR, 
+                         "Invalid or unsupported science file sync policy %d with interval %d. Files will not be synced.",
+                         SciFile->Config.SyncPolicy, SciFile->Config.SyncInterval);
+      SciFile->Config.SyncPolicy = PL_MGR_SciFileSync_NONE;
+   }
+
+   /* The region of interest is only set by command */
+   SCI_ROI_SetFull(&SciFile->Config.Roi);
+
+   SciFile->Sink = INITBL_GetIntConfig(IniTbl, CFG_SCI_FILE_SINK);
+   if (SciFile->Sink != SCI_FILE_SINK_OSAL && 
+       !(SciFile->Sink == SCI_FILE_SINK_MMAP && PL_MGR_SCI_FILE_MMAP))
+   {
+      CFE_EVS_SendEvent (SCI_FILE_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR, 
+                         "Invalid or unsupported science file sink %d. Using the OSAL sink.",
+                         SciFile->Sink);
+      SciFile->Sink = SCI_FILE_SINK_OSAL;
+   }
+
+   SciFile->FlushThreshold = INITBL_GetIntConfig(IniTbl, CFG_SCI_FILE_FLUSH_BYTES);
+   if (SciFile->FlushThreshold == 0 || SciFile->FlushThreshold > SCI_FILE_WRITE_BUF_LEN)
+   {
+      CFE_EVS_SendEvent (SCI_FILE_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR, 
+                         "Invalid flush threshold %d, must be between 1 and %d. Using %d.",
+                         SciFile->FlushThreshold, SCI_FILE_WRITE_BUF_LEN, SCI_FILE_WRITE_BUF_LEN);
+      SciFile->FlushThreshold = SCI_FILE_WRITE_BUF_LEN;
+   }
+   
+   snprintf(MutexName, OS_MAX_API_NAME, "PL_MGR_SCIFILE%d", Channel);
+   if (OS_MutSemCreate(&SciFile->MutexId, MutexName, 0) != OS_SUCCESS)
+   {
+      CFE_EVS_SendEvent (SCI_FILE_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR, 
+                         "Science file mutex creation failed");
+   }
+   
    /* Initialize to a known state. Call after config parameters in case they're used */
-   InitFileState();
+   InitFileState(SciFile);
+   
+   RestoreCheckpoint(SciFile);
+   
+   PublishStatus(SciFile);
 
 } /* End SCI_FILE_Constructor() */
 
 
 /******************************************************************************
-** Functions: SCI_FILE_ConfigCmd
+** Functions: SCI_FILE_Config
 **
 ** Set configuration parameters for managing science files 
 **
 ** Notes:
-**  1. This function must comply with the CMDMGR_CmdFuncPtr definition
-**  2. TODO: Add error checks
-**  3. TODO: PathBaseFilename max len must be less than OS_MAX_PATH_LEN
-**           rest of filename and extension.
+**  1. Called by the payload's configure science file command function
+**  2. The configuration is checked with SCI_FILE_ValidConfig().
+**  3. The configuration is always staged and it's applied immediately when
+**     science data isn't being collected. A configuration that's already
+**     staged is replaced. See prologue notes.
 **
 */
-bool SCI_FILE_ConfigCmd(void *DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+bool SCI_FILE_Config(SCI_FILE_Class_t *SciFile, const PL_MGR_ConfigSciFile_Payload_t *ConfigCmd)
 {
 
-   const PL_MGR_ConfigSciFile_Payload_t *ConfigCmd = CMDMGR_PAYLOAD_PTR(MsgPtr, PL_MGR_ConfigSciFile_t);
+   bool RetStatus = false;
    
-   SciFile->Config.ImagesPerFile = ConfigCmd->ImagesPerFile;
+   if (SCI_FILE_ValidConfig(ConfigCmd))
+   {
+      
+      OS_MutSemTake(SciFile->MutexId);
    
-   strncpy(SciFile->Config.BasePathFilename, ConfigCmd->BasePathFilename, OS_MAX_PATH_LEN);
-   SciFile->Config.BasePathFilename[OS_MAX_PATH_LEN-1] = '\0';
+      SciFile->PendingConfig.ImagesPerFile = ConfigCmd->ImagesPerFile;
    
-   strncpy(SciFile->Config.FileExtension, ConfigCmd->FileExtension, SCI_FILE_EXT_MAX_CHAR);
-   SciFile->Config.FileExtension[SCI_FILE_EXT_MAX_CHAR-1] = '\0';
+      strncpy(SciFile->PendingConfig.BasePathFilename, ConfigCmd->BasePathFilename, OS_MAX_PATH_LEN);
+      SciFile->PendingConfig.BasePathFilename[OS_MAX_PATH_LEN-1] = '\0';
+   
+      strncpy(SciFile->PendingConfig.FileExtension, ConfigCmd->FileExtension, SCI_FILE_EXT_MAX_CHAR);
+      SciFile->PendingConfig.FileExtension[SCI_FILE_EXT_MAX_CHAR-1] = '\0';
 
-   return true;
+      SciFile->PendingConfig.FileFormat   = ConfigCmd->FileFormat;
+      SciFile->PendingConfig.Codec        = ConfigCmd->Codec;
+      SciFile->PendingConfig.SyncPolicy   = ConfigCmd->SyncPolicy;
+      SciFile->PendingConfig.SyncInterval = ConfigCmd->SyncInterval;
+      SciFile->PendingConfig.Roi          = ConfigCmd->Roi;
+      SciFile->ConfigPending = true;
+      SciFile->InfoChangeCnt++;
+   
+      if (SciFile->State == SCI_FILE_ENABLED)
+      {
+         CFE_EVS_SendEvent (SCI_FILE_CONFIG_CMD_EID, CFE_EVS_EventType_INFORMATION, 
+                            "Science file configuration staged, it will be applied when the next file is created");
+      }
+      else
+      {
+         ApplyConfig(SciFile);
+      }
+   
+      SaveCheckpoint(SciFile, false);
+      PublishStatus(SciFile);
+   
+      OS_MutSemGive(SciFile->MutexId);
+   
+      RetStatus = true;
+   
+   }
+   
+   return RetStatus;
+   
+} /* End SCI_FILE_Config() */
+
+
+/******************************************************************************
+** Functions: SCI_FILE_ValidConfig
+**
+*/
+bool SCI_FILE_ValidConfig(const PL_MGR_ConfigSciFile_Payload_t *ConfigCmd)
+{
+
+   bool RetStatus = false;
+   
+   if (ConfigCmd->ImagesPerFile > 0 &&
+       ValidFilename(ConfigCmd->BasePathFilename, ConfigCmd->FileExtension))
+   {
+   
+      if (ValidFileFormat(ConfigCmd->FileFormat) && ValidCodec(ConfigCmd->FileFormat, ConfigCmd->Codec))
+      {
+      
+         if (ValidSync(ConfigCmd->SyncPolicy, ConfigCmd->SyncInterval))
+         {
+      
+            if (SCI_ROI_Valid(&ConfigCmd->Roi, SCI_FILE_ROW_LEN))
+            {
+      
+               RetStatus = true;
+         
+            }
+            else
+            {
+            
+               CFE_EVS_SendEvent (SCI_FILE_CONFIG_CMD_EID, CFE_EVS_EventType_ERROR, 
+                                  "Config science file command rejected, invalid region of interest first row %d, "
+                                  "row step %d, first column %d or column step %d",
+                                  ConfigCmd->Roi.FirstRow, ConfigCmd->Roi.RowStep,
+                                  ConfigCmd->Roi.FirstCol, ConfigCmd->Roi.ColStep);
+            }
+      
+         }
+         else
+         {
+         
+            CFE_EVS_SendEvent (SCI_FILE_CONFIG_CMD_EID, CFE_EVS_EventType_ERROR, 
+                               "Config science file command rejected, invalid or unsupported sync policy %d "
+                               "with interval %d",
+                               ConfigCmd->SyncPolicy, ConfigCmd->SyncInterval);
+         }
+   
+      }
+      else
+      {
+   
+         CFE_EVS_SendEvent (SCI_FILE_CONFIG_CMD_EID, CFE_EVS_EventType_ERROR, 
+                            "Config science file command rejected, invalid file format %d or codec %d. "
+                            "Codecs require the binary format.",
+                            ConfigCmd->FileFormat, ConfigCmd->Codec);
+      }
+   
+   }
+   else
+   {
+   
+      CFE_EVS_SendEvent (SCI_FILE_CONFIG_CMD_EID, CFE_EVS_EventType_ERROR, 
+                         "Config science file command rejected, images per file %d is zero or the base "
+                         "path/filename and extension are too long for OS_MAX_PATH_LEN %d",
+                         ConfigCmd->ImagesPerFile, OS_MAX_PATH_LEN);
+   }
+   
+   return RetStatus;
    
-} /* End SCI_FILE_ConfigCmd() */
+} /* End SCI_FILE_ValidConfig() */
 
 
 /******************************************************************************
 ** Function:  SCI_FILE_ResetStatus
 **
 */
-void SCI_FILE_ResetStatus(void)
+void SCI_FILE_ResetStatus(SCI_FILE_Class_t *SciFile)
 {
 
+   OS_MutSemTake(SciFile->MutexId);
+   
+   SciFile->SyncCnt = 0;
+   SciFile->RoiSavedByteCnt = 0;
+   
    /* For a state reset if it somehow is disabled with a non-disabled state */
    if (SciFile->State == SCI_FILE_DISABLED)
    {
-      InitFileState();
+      InitFileState(SciFile);
    }
    
+   PublishStatus(SciFile);
+   
+   OS_MutSemGive(SciFile->MutexId);
+   
 } /* End SCI_FILE_ResetStatus() */
 
 
+/******************************************************************************
+** Functions: SCI_FILE_GetStatus
+**
+** Notes:
+**   1. The copy is repeated if a snapshot was published while it was being
+**      made. The publisher never waits for the reader so a higher priority
+**      reader can't block it.
+**
+*/
+void SCI_FILE_GetStatus(SCI_FILE_Class_t *SciFile, SCI_FILE_Status_t *Status)
+{
+   
+   uint32 Seq;
+   
+   do
+   {
+      Seq = __atomic_load_n(&SciFile->SnapshotSeq, __ATOMIC_ACQUIRE);
+      *Status = SciFile->Snapshot[Seq & 1].Status;
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+   
+   } while (Seq != __atomic_load_n(&SciFile->SnapshotSeq, __ATOMIC_RELAXED));
+   
+} /* End SCI_FILE_GetStatus() */
+
+
+/******************************************************************************
+** Functions: SCI_FILE_GetFileInfo
+**
+** Notes:
+**   1. See SCI_FILE_GetStatus() notes.
+**
+*/
+uint16 SCI_FILE_GetFileInfo(SCI_FILE_Class_t *SciFile, PL_MGR_FileInfoTlm_Payload_t *FileInfo)
+{
+   
+   uint32 Seq;
+   
+   do
+   {
+      Seq = __atomic_load_n(&SciFile->SnapshotSeq, __ATOMIC_ACQUIRE);
+      *FileInfo = SciFile->Snapshot[Seq & 1].FileInfo;
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+   
+   } while (Seq != __atomic_load_n(&SciFile->SnapshotSeq, __ATOMIC_RELAXED));
+   
+   return FileInfo->ChangeCnt;
+
+} /* End SCI_FILE_GetFileInfo() */
+
+
 /******************************************************************************
 ** Functions: SCI_FILE_Start
 **
@@ -136,12 +418,19 @@ void SCI_FILE_ResetStatus(void)
 **      detector image synchronization.
 **
 */
-bool SCI_FILE_Start(void)
+bool SCI_FILE_Start(SCI_FILE_Class_t *SciFile)
 {
    
+   OS_MutSemTake(SciFile->MutexId);
+   
    SciFile->State = SCI_FILE_ENABLED;
    SciFile->CreateNewFile = true;
    
+   SaveCheckpoint(SciFile, false);
+   PublishStatus(SciFile);
+   
+   OS_MutSemGive(SciFile->MutexId);
+   
    return true;
 
 } /* End SciFile_Start() */
@@ -158,9 +447,11 @@ bool SCI_FILE_Start(void)
 **      generating errors.
 **
 */
-bool SCI_FILE_Stop(char *EventStr, uint16 MaxStrLen)
+bool SCI_FILE_Stop(SCI_FILE_Class_t *SciFile, char *EventStr, uint16 MaxStrLen)
 {
   
+   OS_MutSemTake(SciFile->MutexId);
+   
    if (SciFile->State == SCI_FILE_DISABLED)
    {
    
@@ -170,18 +461,85 @@ bool SCI_FILE_Stop(char *EventStr, uint16 MaxStrLen)
    else
    {
       
-      CloseFile();
+      CloseAllFiles(SciFile);
       strncpy(EventStr, "Sucessfully stopped science", MaxStrLen);
    
    } /* End if science enabled */
       
-   InitFileState();
-         
+   InitFileState(SciFile);
+   ApplyConfig(SciFile);
+   SaveCheckpoint(SciFile, true);
+   PublishStatus(SciFile);
+   
+   OS_MutSemGive(SciFile->MutexId);
+   
    return true;
    
 } /* End SciFile_Stop() */
 
 
+/******************************************************************************
+** Functions: SCI_FILE_ManageFiles
+**
+** Perform file management that has been deferred from the detector data path
+**
+** Notes:
+**   1. See prologue notes.
+**   2. The checkpoint is saved when a file is closed or pre-opened so it
+**      doesn't reference a file that's been renamed and the pre-opened
+**      file can be deleted after a restart.
+**
+*/
+void SCI_FILE_ManageFiles(SCI_FILE_Class_t *SciFile)
+{
+   
+   bool SaveState = false;
+   
+   OS_MutSemTake(SciFile->MutexId);
+   
+   if (SciFile->CreateEventPending)
+   {
+      CFE_EVS_SendEvent (SCI_FILE_CREATE_EID, CFE_EVS_EventType_INFORMATION, 
+                         "New science file created: %s", SciFile->File.Name);
+      SciFile->CreateEventPending = false;
+   }
+   
+   if (SciFile->ClosingFile.IsOpen)
+   {
+      CloseSlot(SciFile, &SciFile->ClosingFile);
+      SaveState = true;
+   }
+   
+   if (SciFile->SyncPending)
+   {
+      if (SciFile->File.IsOpen)
+      {
+         SyncFile(SciFile, &SciFile->File);
+         SciFile->SyncImageCnt = 0;
+         CFE_PSP_GetTime(&SciFile->SyncTime);
+      }
+      SciFile->SyncPending = false;
+   }
+   
+   if (SciFile->State == SCI_FILE_ENABLED && SciFile->File.IsOpen && !SciFile->ConfigPending &&
+       !SciFile->NextFile.IsOpen && !SciFile->NextFileAttempted)
+   {
+      SciFile->NextFileAttempted = true;
+      SaveState = OpenSlot(SciFile, &SciFile->NextFile, 0, true) || SaveState;
+   }
+   
+   if (SaveState)
+   {
+      SaveCheckpoint(SciFile, false);
+   }
+   
+   PublishStatus(SciFile);
+   
+   OS_MutSemGive(SciFile->MutexId);
+   
+} /* End SCI_FILE_ManageFiles() */
+
+
 /******************************************************************************
 ** Functions: SCI_FILE_WriteDetectorData
 **
@@ -197,220 +555,2132 @@ bool SCI_FILE_Stop(char *EventStr, uint16 MaxStrLen)
 **      started could have partial data. 
 **
 */
-void SCI_FILE_WriteDetectorData(PL_SIM_LIB_Detector_t *Detector, SCI_FILE_Control_t Control)
+void SCI_FILE_WriteDetectorData(SCI_FILE_Class_t *SciFile, const PL_SIM_LIB_Detector_t *Detector, SCI_FILE_Control_t Control,
+                                bool RowFault)
 {
 
-   bool SaveDetectorRow = true; 
+   OS_MutSemTake(SciFile->MutexId);
    
    if (Control == SCI_FILE_SHUTDOWN)
    {
-      CloseFile();
-      InitFileState();
+      CloseAllFiles(SciFile);
+      InitFileState(SciFile);
+      ApplyConfig(SciFile);
+      SaveCheckpoint(SciFile, true);
    }
    else
    {
-      if (SciFile->State == SCI_FILE_ENABLED)     
-      {
-
-         if (SciFile->CreateNewFile)
-         {
-         
-            /* Wait for first row before creating a file */
-            if (Control == SCI_FILE_FIRST_ROW)
-            {
-               CreateFile(Detector->ImageCnt);
-               SciFile->CreateNewFile = false;
-            }
-            else
-            {
-               SaveDetectorRow = false;
-            }
-         }
-
-         if (SaveDetectorRow) WriteDetectorRow(&Detector->Row);         
-         
-         if (Control == SCI_FILE_LAST_ROW)
-         {
-            SciFile->ImageCnt++;
-            if (SciFile->ImageCnt >= SciFile->Config.ImagesPerFile)
-            {
-               CloseFile();
-               SciFile->CreateNewFile = true;
-            }
-            
-         } /* End if SCI_FILE_SAVE_LAST_ROW */
-      } /* End if SCI_FILE_ENABLED */
+      WriteRow(SciFile, Detector, Control, NULL, 0, RowFault);
    }
    
+   PublishStatus(SciFile);
+   
+   OS_MutSemGive(SciFile->MutexId);
+   
 } /* End SciFile_WriteDetectorData() */
 
 
 /******************************************************************************
-** Functions: CloseFile
+** Functions: SCI_FILE_WriteImage
 **
-** Close the current science file.
+** Write an image's detector rows to a file
 **
 ** Notes:
-**   None
-*/
-static void CloseFile(void)
-{
- 
-   if (SciFile->IsOpen)
-   {
-      
-      OS_close(SciFile->Handle);
-      
-      CFE_EVS_SendEvent (SCI_FILE_CLOSE_EID, CFE_EVS_EventType_INFORMATION, 
-                         "Closed science file %s",SciFile->Name);         
-      
-      SciFile->IsOpen = false;
-      strcpy(SciFile->Name, SCI_FILE_UNDEF_FILE);
-
-   }
-
-} /* End SciFile_Close() */
-
-
-/******************************************************************************
-** Functions: CreateCntFilename
+**   1. Collection is only started and stopped by the SCI_WRITER child task
+**      that calls this function so an image is never split by a command.
 **
-** Create a filename using the table-defined base path/filename, current image
-** ID, and the table-defined extension. 
-**
-** Notes:
-**   1. No string buffer error checking performed
 */
-static void CreateCntFilename(uint16 ImageId)
+void SCI_FILE_WriteImage(SCI_FILE_Class_t *SciFile, const PL_SIM_LIB_Detector_t *Row, uint16 RowCnt,
+                         const SCI_FILE_EncodedImage_t *EncodedImage, bool ImageFault)
 {
+
+   uint16 i;
    
-   int i;
+   OS_MutSemTake(SciFile->MutexId);
    
-   char ImageIdStr[64];
-
-   sprintf(ImageIdStr,"%03d",ImageId);
-
-   strcpy (SciFile->Name, SciFile->Config.BasePathFilename);
-
-   i = strlen(SciFile->Name);  /* Starting position for image ID */
-   strcat (&(SciFile->Name[i]), ImageIdStr);
+   for (i=0; i < RowCnt; i++)
+   {
+      WriteRow(SciFile, &Row[i], SCI_FILE_GetRowControl(&Row[i]), EncodedImage, i, ImageFault);
+   }
    
-   i = strlen(SciFile->Name);  /* Starting position for extension */
-   strcat (&(SciFile->Name[i]), SciFile->Config.FileExtension);
+   PublishStatus(SciFile);
    
-} /* End CreateCntFilename() */
+   OS_MutSemGive(SciFile->MutexId);
+   
+} /* End SCI_FILE_WriteImage() */
 
 
 /******************************************************************************
-** Functions: CreateFile
+** Functions: SCI_FILE_EncodeImage
 **
-** Create a new science file using the ImageId in the filename
+** Build the binary records for an image's detector rows
 **
 ** Notes:
-**   None
+**   1. The mutex is only held while the file format, codec and ROI are
+**      read so encoding doesn't block the SCI_WRITER child task.
+**   2. Rows that the ROI doesn't keep don't have a record.
+**
 */
-static bool CreateFile(uint16 ImageId)
+void SCI_FILE_EncodeImage(SCI_FILE_Class_t *SciFile, SCI_FILE_Encoder_t *Encoder,
+                          const PL_SIM_LIB_Detector_t *Row, uint16 RowCnt,
+                          SCI_FILE_EncodedImage_t *EncodedImage)
 {
 
-   bool          RetStatus = false;
-   int32         SysStatus;
-   os_err_name_t OsErrStr; 
+   uint32 ImageCrc = SCI_CRC_INIT;
+   uint16 RecordFlags;
+   uint16 i;
+   SCI_FILE_BinRecord_t *Record;
    
-   if (SciFile->IsOpen)
-   {
-      
-      CFE_EVS_SendEvent (SCI_FILE_CREATE_ERR_EID, CFE_EVS_EventType_ERROR, 
-                         "Create science file failed due to a file already being open: %s", SciFile->Name);         
+   OS_MutSemTake(SciFile->MutexId);
    
+   if (SciFile->File.IsOpen)
+   {
+      EncodedImage->FileFormat = SciFile->File.Config.FileFormat;
+      EncodedImage->Codec      = SciFile->File.Config.Codec;
+      EncodedImage->Roi        = SciFile->File.Config.Roi;
    }
    else
    {
+      EncodedImage->FileFormat = SciFile->Config.FileFormat;
+      EncodedImage->Codec      = SciFile->Config.Codec;
+      EncodedImage->Roi        = SciFile->Config.Roi;
+   }
+   
+   OS_MutSemGive(SciFile->MutexId);
    
-      CreateCntFilename(ImageId);
+   EncodedImage->RecordCnt = 0;
+   
+   if (EncodedImage->FileFormat == PL_MGR_SciFileFormat_BINARY && RowCnt > 0 &&
+       SCI_FILE_GetRowControl(&Row[0]) == SCI_FILE_FIRST_ROW)
+   {
       
-      SysStatus = OS_OpenCreate(&SciFile->Handle, SciFile->Name, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_READ_WRITE);
+      Encoder->PrevRowValid = false;
       
-      if (SysStatus == OS_SUCCESS)
+      for (i=0; i < RowCnt; i++)
       {
-      
-         RetStatus = true;
-         SciFile->ImageCnt = 0;
-         SciFile->IsOpen = true;
-         CFE_EVS_SendEvent (SCI_FILE_CREATE_EID, CFE_EVS_EventType_INFORMATION, 
-                            "New science file created: %s",SciFile->Name);         
-
+         Record = &EncodedImage->Record[i];
+         Record->CodecUsec = 0;
+         Record->Data = NULL;
+         if (SelectRow(&EncodedImage->Roi, &Row[i], &RecordFlags))
+         {
+            Record->Data = BuildRecord(Encoder, EncodedImage->Codec, &EncodedImage->Roi, &Row[i], RecordFlags,
+                                       EncodedImage->EncodeBuf[i], &Record->Hdr, &ImageCrc, &Record->CodecUsec);
+         }
       }
-      else
-      {
-         
-         OS_GetErrorName(SysStatus, &OsErrStr);
-         CFE_EVS_SendEvent (SCI_FILE_CREATE_ERR_EID, CFE_EVS_EventType_ERROR, 
-                            "Error creating new science file %s. Return status %s",
-                            SciFile->Name, OsErrStr);         
       
-      }
-   } /* End if no file currently open */
-            
-   return RetStatus;
+      EncodedImage->RecordCnt = RowCnt;
    
-} /* End CreateFile() */
+   }
+   
+} /* End SCI_FILE_EncodeImage() */
 
 
 /******************************************************************************
-** Functions: InitFileState
+** Functions: SCI_FILE_GetRowControl
 **
-** Initialize the SciFile object to a known state.
+** Return the control for a detector row based on its readout row
 **
-** Notess:
-**   None
 */
-static void InitFileState(void)
+SCI_FILE_Control_t SCI_FILE_GetRowControl(const PL_SIM_LIB_Detector_t *Detector)
 {
 
-   SciFile->CreateNewFile = false;
-   SciFile->State    = SCI_FILE_DISABLED;
-   SciFile->Handle   = 0;
-   SciFile->IsOpen   = false;
-   SciFile->ImageCnt = 0;
-   strcpy(SciFile->Name, SCI_FILE_UNDEF_FILE);
+   SCI_FILE_Control_t Control = SCI_FILE_ROW;
    
-} /* End InitFileState() */
+   if (Detector->ReadoutRow == 0)
+      Control = SCI_FILE_FIRST_ROW;
+   else if (Detector->ReadoutRow >= (PL_SIM_LIB_DETECTOR_ROWS_PER_IMAGE-1))
+      Control = SCI_FILE_LAST_ROW;
+   
+   return Control;
+   
+} /* End SCI_FILE_GetRowControl() */
 
 
 /******************************************************************************
-** Functions: WriteDetectorRow
+** Functions: ApplyConfig
 **
-** Write a detector row to the current science file
+** Make the staged configuration the configuration used for new files
 **
 ** Notes:
-**   None
+**   1. Nothing is done if a configuration isn't staged.
 */
-static bool WriteDetectorRow(PL_SIM_LIB_DetectorRow_t *DetectorRow)
+static void ApplyConfig(SCI_FILE_Class_t *SciFile)
 {
-   
-   int32 WriteStatus = 0;
-   bool  RetStatus = false;
-   
-   if (SciFile->IsOpen)
+ 
+   if (SciFile->ConfigPending)
    {
-     
-      WriteStatus = OS_write(SciFile->Handle, DetectorRow->Data, strlen(DetectorRow->Data));
-      
-      RetStatus = (WriteStatus > 0);
+      SciFile->Config = SciFile->PendingConfig;
+      SciFile->ConfigPending = false;
+      SciFile->InfoChangeCnt++;
+   }
+
+} /* End ApplyConfig() */
+
+
+/******************************************************************************
+** Functions: CatalogRow
+**
+** Update the current file's catalog entry for a detector row
+**
+** Notes:
+**   1. Must be called before the row is staged so an image's first row
+**      offset is the file length. See prologue notes.
+**   2. An image is only indexed if the file's catalog entry has room for it.
+**
+*/
+static void CatalogRow(SCI_FILE_Class_t *SciFile, const PL_SIM_LIB_Detector_t *Detector, SCI_FILE_Control_t Control,
+                       bool RowFault)
+{
+ 
+   PL_MGR_CatalogEntry_t *Catalog = &SciFile->File.Catalog;
+   PL_MGR_CatalogImage_t *Image = NULL;
+   
+   if (Control == SCI_FILE_FIRST_ROW)
+   {
+      if (Catalog->ImageCnt < SCI_CATALOG_FILE_IMAGE_MAX)
+      {
+         Image = &Catalog->Image[Catalog->ImageCnt++];
+         Image->ImageId = Detector->ImageCnt;
+         Image->Flags   = SCI_CATALOG_IMAGE_PARTIAL;
+         Image->Offset  = Catalog->FileLen;
+      }
+      else
+      {
+         Catalog->Flags |= SCI_CATALOG_FILE_INDEX_FULL;
+      }
+   }
+   else if (Catalog->ImageCnt > 0)
+   {
+      if (Catalog->Image[Catalog->ImageCnt-1].ImageId == Detector->ImageCnt)
+      {
+         Image = &Catalog->Image[Catalog->ImageCnt-1];
+      }
+   }
+   
+   if (RowFault)
+   {
+      Catalog->Flags |= SCI_CATALOG_IMAGE_FAULT;
+   }
+
+   if (Image != NULL)
+   {
+      if (RowFault)
+      {
+         Image->Flags |= SCI_CATALOG_IMAGE_FAULT;
+      }
+      if (Control == SCI_FILE_LAST_ROW)
+      {
+         Image->Flags &= ~SCI_CATALOG_IMAGE_PARTIAL;
+      }
+   }
+
+} /* End CatalogRow() */
+
+
+/******************************************************************************
+** Functions: CloseAllFiles
+**
+** Close the current science file and any files being managed in the
+** background.
+**
+** Notes:
+**   1. The pre-opened next file doesn't contain any data so it's deleted.
+*/
+static void CloseAllFiles(SCI_FILE_Class_t *SciFile)
+{
+ 
+   CloseFile(SciFile);
+   
+   if (SciFile->ClosingFile.IsOpen)
+   {
+      CloseSlot(SciFile, &SciFile->ClosingFile);
+   }
+   
+   if (SciFile->NextFile.IsOpen)
+   {
+      DiscardSlot(SciFile, &SciFile->NextFile);
+   }
+
+} /* End CloseAllFiles() */
+
+
+/******************************************************************************
+** Functions: CloseFile
+**
+** Close the current science file.
+**
+** Notes:
+**   1. Staged data is written prior to closing the file.
+*/
+static void CloseFile(SCI_FILE_Class_t *SciFile)
+{
+ 
+   OS_time_t StageTime;
+   
+   if (SciFile->File.IsOpen)
+   {
+      
+      PERF_HIST_Start(&StageTime);
+      FinishFile(SciFile);
+      CloseSlot(SciFile, &SciFile->File);
+      PERF_HIST_Stop(PERF_HIST_CLOSE_FILE, &StageTime);
+
+   }
+
+} /* End CloseFile() */
+
+
+/******************************************************************************
+** Functions: CloseSlot
+**
+** Close a file slot's file
+**
+** Notes:
+**   1. A finished file is synced before it's closed unless its sync policy
+**      is NONE and it's committed after it's closed. A memory mapped file
+**      is unmapped first so its truncation is synced.
+**
+*/
+static void CloseSlot(SCI_FILE_Class_t *SciFile, SCI_FILE_Slot_t *Slot)
+{
+ 
+   if (Slot->IsOpen)
+   {
+      
+      if (Slot->Finished && Slot->Config.SyncPolicy != PL_MGR_SciFileSync_NONE)
+      {
+         if (SciFile->Sink == SCI_FILE_SINK_MMAP)
+         {
+            SCI_MMAP_Unmap(&Slot->MmapSink);
+         }
+         SyncFile(SciFile, Slot);
+      }
+      
+      if (SciFile->Sink == SCI_FILE_SINK_MMAP)
+      {
+         SCI_MMAP_Close(&Slot->MmapSink);
+      }
+      else
+      {
+         OS_close(Slot->Handle);
+         SCI_SYNC_Close(Slot->SyncFd);
+         Slot->SyncFd = SCI_SYNC_NO_FD;
+      }
+      
+      if (Slot->Finished)
+      {
+         CommitFile(Slot);
+      }
+      
+      CFE_EVS_SendEvent (SCI_FILE_CLOSE_EID, CFE_EVS_EventType_INFORMATION, 
+                         "Closed science file %s", Slot->Name);         
+      
+      Slot->IsOpen = false;
+      strcpy(Slot->Name, SCI_FILE_UNDEF_FILE);
+      strcpy(Slot->TmpName, SCI_FILE_UNDEF_FILE);
+      SciFile->InfoChangeCnt++;
+
+   }
+
+} /* End CloseSlot() */
+
+
+/******************************************************************************
+** Functions: CommitFile
+**
+** Make a finished file slot's file available using its final name
+**
+** Notes:
+**   1. The file must be closed and it's renamed from its temporary name.
+**      Unless its sync policy is NONE the file must already be synced and
+**      its directory is synced after the rename. See prologue notes.
+**   2. The file is added to the science file catalog and retained by
+**      SCI_RETAIN after it's renamed. The catalog entry is synced with the
+**      same policy as the file. If the rename fails the file is
+**      cataloged using its temporary name.
+**   3. If a file already has the final name the name is made unique so the
+**      existing file isn't replaced. See UniqueFilename().
+**
+*/
+static void CommitFile(SCI_FILE_Slot_t *Slot)
+{
+ 
+   if (UniqueFilename(Slot) && OS_rename(Slot->TmpName, Slot->Name) == OS_SUCCESS)
+   {
+      strcpy(Slot->Catalog.Filename, Slot->Name);
+      if (Slot->Config.SyncPolicy != PL_MGR_SciFileSync_NONE)
+      {
+         if (!SCI_SYNC_Dir(Slot->Name))
+         {
+            Slot->Catalog.Flags |= SCI_CATALOG_FILE_WRITE_ERR;
+         }
+      }
+   }
+   else
+   {
+      CFE_EVS_SendEvent (SCI_FILE_RENAME_ERR_EID, CFE_EVS_EventType_ERROR, 
+                         "Error renaming closed science file %s to %s",
+                         Slot->TmpName, Slot->Name);
+      strcpy(Slot->Catalog.Filename, Slot->TmpName);
+   }
+   
+   SCI_CATALOG_AddFile(&Slot->Catalog, (Slot->Config.SyncPolicy != PL_MGR_SciFileSync_NONE));
+   SCI_RETAIN_AddFile(&Slot->Catalog);
+   Slot->Finished = false;
+
+} /* End CommitFile() */
+
+
+/******************************************************************************
+** Functions: CreateCntFilename
+**
+** Create a filename using the table-defined base path/filename, current image
+** ID, and the table-defined extension. 
+**
+** Notes:
+**   1. Filename must be OS_MAX_PATH_LEN long. A configuration that passes
+**      SCI_FILE_ValidConfig() always fits. Otherwise the name is truncated
+**      and an error event is sent.
+*/
+static void CreateCntFilename(SCI_FILE_Class_t *SciFile, char *Filename, uint16 ImageId)
+{
+   
+   int FilenameLen;
+   
+   FilenameLen = snprintf(Filename, OS_MAX_PATH_LEN, "%s%03d%s", SciFile->Config.BasePathFilename,
+                          ImageId, SciFile->Config.FileExtension);
+   
+   if (FilenameLen >= OS_MAX_PATH_LEN)
+   {
+      CFE_EVS_SendEvent (SCI_FILE_CREATE_ERR_EID, CFE_EVS_EventType_ERROR, 
+                         "Science filename truncated to %s, the base path/filename and extension are too long",
+                         Filename);
+   }
+   
+} /* End CreateCntFilename() */
+
+
+/******************************************************************************
+** Functions: CreateNextFilename
+**
+** Create the temporary filename used by the pre-opened next file
+**
+** Notes:
+**   1. The name doesn't contain an image ID so it's never a science file's
+**      name. See prologue notes.
+*/
+static void CreateNextFilename(SCI_FILE_Class_t *SciFile, char *TmpFilename)
+{
+   
+   char Filename[OS_MAX_PATH_LEN + sizeof(SCI_FILE_NEXT_NAME)];
+
+   strcpy(Filename, SciFile->Config.BasePathFilename);
+   strcat(Filename, SCI_FILE_NEXT_NAME);
+   CreateTmpFilename(TmpFilename, Filename);
+   
+} /* End CreateNextFilename() */
+
+
+/******************************************************************************
+** Functions: CreateTmpFilename
+**
+** Create the temporary filename used while a file is being written
+**
+** Notes:
+**   1. Filename is truncated if necessary so SCI_FILE_TMP_EXT always fits.
+*/
+static void CreateTmpFilename(char *TmpFilename, const char *Filename)
+{
+   
+   size_t Len = strlen(Filename);
+   
+   if (Len > (OS_MAX_PATH_LEN - sizeof(SCI_FILE_TMP_EXT)))
+   {
+      Len = OS_MAX_PATH_LEN - sizeof(SCI_FILE_TMP_EXT);
+   }
+   
+   memcpy(TmpFilename, Filename, Len);
+   strcpy(&TmpFilename[Len], SCI_FILE_TMP_EXT);
+   
+} /* End CreateTmpFilename() */
+
+
+/******************************************************************************
+** Functions: CreateFile
+**
+** Create a new science file using the ImageId in the filename
+**
+** Notes:
+**   1. The pre-opened next file is used if it's available. Otherwise the
+**      file is created in the caller's context.
+**   2. The binary file header is staged after the file is created.
+**   3. A staged configuration is applied before the file is created. A
+**      pre-opened next file that doesn't match it is discarded.
+*/
+static bool CreateFile(SCI_FILE_Class_t *SciFile, uint16 ImageId)
+{
+
+   bool RetStatus = false;
+   OS_time_t StageTime;
+   
+   PERF_HIST_Start(&StageTime);
+   
+   if (SciFile->File.IsOpen)
+   {
+      
+      CFE_EVS_SendEvent (SCI_FILE_CREATE_ERR_EID, CFE_EVS_EventType_ERROR, 
+                         "Create science file failed due to a file already being open: %s", SciFile->File.Name);         
+   
+   }
+   else
+   {
+   
+      ApplyConfig(SciFile);
+      
+      if (UseNextFile(SciFile, ImageId))
+      {
+         RetStatus = true;
+         SciFile->CreateEventPending = true;
+      }
+      else
+      {
+         RetStatus = OpenSlot(SciFile, &SciFile->File, ImageId, false);
+         if (RetStatus)
+         {
+            CFE_EVS_SendEvent (SCI_FILE_CREATE_EID, CFE_EVS_EventType_INFORMATION, 
+                               "New science file created: %s", SciFile->File.Name);
+         }
+      }
+      
+      if (RetStatus)
+      {
+      
+         SciFile->ImageCnt    = 0;
+         SciFile->RecordCnt   = 0;
+         SciFile->WriteBufLen = 0;
+         SciFile->RawByteCnt     = 0;
+         SciFile->EncodedByteCnt = 0;
+         SciFile->CodecUsec      = 0;
+         SciFile->Encoder.PrevRowValid = false;
+         SciFile->NextFileAttempted = false;
+         SciFile->SyncPending  = false;
+         SciFile->SyncImageCnt = 0;
+         CFE_PSP_GetTime(&SciFile->SyncTime);
+         SciFile->InfoChangeCnt++;
+         
+         memset(&SciFile->File.Catalog, 0, sizeof(PL_MGR_CatalogEntry_t));
+         SciFile->File.Catalog.Channel    = SciFile->Channel;
+         SciFile->File.Catalog.FileFormat = SciFile->File.Config.FileFormat;
+         SciFile->File.Catalog.Codec      = SciFile->File.Config.Codec;
+         SciFile->File.Catalog.Priority   = SCI_RETAIN_DEF_PRIORITY;
+         
+         if (SciFile->File.Config.FileFormat == PL_MGR_SciFileFormat_BINARY)
+         {
+            WriteBinHeader(SciFile, ImageId);
+         }
+         else if (!SCI_ROI_Full(&SciFile->File.Config.Roi))
+         {
+            WriteTextHeader(SciFile, ImageId);
+         }
+         
+         SaveCheckpoint(SciFile, true);
+
+      }
+   } /* End if no file currently open */
+   
+   PERF_HIST_Stop(PERF_HIST_CREATE_FILE, &StageTime);
+            
+   return RetStatus;
+   
+} /* End CreateFile() */
+
+
+/******************************************************************************
+** Functions: DiscardSlot
+**
+** Close and delete a file slot's file
+**
+** Notes:
+**   1. A discarded file is never finished so it still has the temporary
+**      name that the slot created it with.
+**
+*/
+static void DiscardSlot(SCI_FILE_Class_t *SciFile, SCI_FILE_Slot_t *Slot)
+{
+ 
+   char Filename[OS_MAX_PATH_LEN];
+   
+   if (Slot->IsOpen)
+   {
+      
+      strcpy(Filename, Slot->TmpName);
+      CloseSlot(SciFile, Slot);
+      OS_remove(Filename);
+
+   }
+
+} /* End DiscardSlot() */
+
+
+/******************************************************************************
+** Functions: FinishFile
+**
+** Write the current file's trailer and any staged data
+**
+** Notes:
+**   1. The file's catalog entry flags include its images' flags.
+**
+*/
+static void FinishFile(SCI_FILE_Class_t *SciFile)
+{
+ 
+   uint16 i;
+   
+   if (SciFile->File.Config.FileFormat == PL_MGR_SciFileFormat_BINARY)
+   {
+      WriteBinTrailer(SciFile);
+   }
+   FlushWriteBuf(SciFile);
+   
+   for (i=0; i < SciFile->File.Catalog.ImageCnt; i++)
+   {
+      SciFile->File.Catalog.Flags |= SciFile->File.Catalog.Image[i].Flags;
+   }
+   SciFile->File.Finished = true;
+
+} /* End FinishFile() */
+
+
+/******************************************************************************
+** Functions: InitFileState
+**
+** Initialize the SciFile object to a known state.
+**
+** Notess:
+**   1. Files must be closed prior to calling this function.
+*/
+static void InitFileState(SCI_FILE_Class_t *SciFile)
+{
+
+   SciFile->CreateNewFile = false;
+   SciFile->CreateEventPending = false;
+   SciFile->NextFileAttempted  = false;
+   SciFile->WaitForImage       = false;
+   SciFile->State    = SCI_FILE_DISABLED;
+   SciFile->ImageCnt = 0;
+   SciFile->RecordCnt = 0;
+   SciFile->WriteBufLen = 0;
+   SciFile->RawByteCnt     = 0;
+   SciFile->EncodedByteCnt = 0;
+   SciFile->CodecUsec      = 0;
+   SciFile->Encoder.PrevRowValid = false;
+   SciFile->SyncPending  = false;
+   SciFile->SyncImageCnt = 0;
+   
+   SciFile->File.IsOpen        = false;
+   SciFile->NextFile.IsOpen    = false;
+   SciFile->ClosingFile.IsOpen = false;
+   strcpy(SciFile->File.Name, SCI_FILE_UNDEF_FILE);
+   strcpy(SciFile->NextFile.Name, SCI_FILE_UNDEF_FILE);
+   strcpy(SciFile->ClosingFile.Name, SCI_FILE_UNDEF_FILE);
+   strcpy(SciFile->File.TmpName, SCI_FILE_UNDEF_FILE);
+   strcpy(SciFile->NextFile.TmpName, SCI_FILE_UNDEF_FILE);
+   strcpy(SciFile->ClosingFile.TmpName, SCI_FILE_UNDEF_FILE);
+   SciFile->InfoChangeCnt++;
+   
+} /* End InitFileState() */
+
+
+/******************************************************************************
+** Functions: OpenSlot
+**
+** Create a file using the current configuration and ImageId in the filename
+**
+** Notes:
+**   1. The configuration is saved with the slot so configuration changes
+**      don't affect an open file.
+**   2. The file is created using its temporary name. See prologue notes.
+**   3. A pre-opened NextFile is created with the next file slot's name and
+**      ImageId is ignored. UseNextFile() names it.
+**   4. A file isn't created if a file that the slot didn't create already
+**      has its temporary name.
+*/
+static bool OpenSlot(SCI_FILE_Class_t *SciFile, SCI_FILE_Slot_t *Slot, uint16 ImageId, bool NextFile)
+{
+
+   int32         SysStatus = OS_ERROR;
+   os_err_name_t OsErrStr; 
+   
+   Slot->Config   = SciFile->Config;
+   Slot->ImageId  = ImageId;
+   Slot->Finished = false;
+   if (NextFile)
+   {
+      CreateNextFilename(SciFile, Slot->TmpName);
+      strcpy(Slot->Name, Slot->TmpName);
+   }
+   else
+   {
+      CreateCntFilename(SciFile, Slot->Name, ImageId);
+      CreateTmpFilename(Slot->TmpName, Slot->Name);
+   }
+   
+   if (!NextFile && !ReleaseTmpName(SciFile, Slot->TmpName))
+   {
+      
+      CFE_EVS_SendEvent (SCI_FILE_CREATE_ERR_EID, CFE_EVS_EventType_ERROR, 
+                         "Error creating new science file %s. An existing file has the same name",
+                         Slot->TmpName);         
+      strcpy(Slot->Name, SCI_FILE_UNDEF_FILE);
+      strcpy(Slot->TmpName, SCI_FILE_UNDEF_FILE);
+      
+   }
+   else
+   {
+   
+      if (SciFile->Sink == SCI_FILE_SINK_MMAP)
+      {
+         if (SCI_MMAP_Open(&Slot->MmapSink, Slot->TmpName, MaxFileLen(&Slot->Config)))
+         {
+            SysStatus = OS_SUCCESS;
+         }
+      }
+      else
+      {
+         SysStatus = OS_OpenCreate(&Slot->Handle, Slot->TmpName, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_READ_WRITE);
+         if (SysStatus == OS_SUCCESS)
+         {
+            OpenSyncFd(Slot);
+         }
+      }
+      
+      if (SysStatus == OS_SUCCESS)
+      {
+      
+         Slot->IsOpen = true;
+
+      }
+      else
+      {
+         
+         OS_GetErrorName(SysStatus, &OsErrStr);
+         CFE_EVS_SendEvent (SCI_FILE_CREATE_ERR_EID, CFE_EVS_EventType_ERROR, 
+                            "Error creating new science file %s. Return status %s",
+                            Slot->TmpName, OsErrStr);         
+         strcpy(Slot->Name, SCI_FILE_UNDEF_FILE);
+         strcpy(Slot->TmpName, SCI_FILE_UNDEF_FILE);
+      
+      }
+   }
+            
+   return Slot->IsOpen;
+   
+} /* End OpenSlot() */
+
+
+/******************************************************************************
+** Functions: OpenSyncFd
+**
+** Open the SCI_SYNC descriptor for a file slot's open OSAL file
+**
+** Notes:
+**   1. A descriptor isn't opened if the file's sync policy is NONE because
+**      the file is never synced.
+**   2. If the open fails the file's syncs fail and they're recorded as
+**      write errors.
+*/
+static void OpenSyncFd(SCI_FILE_Slot_t *Slot)
+{
+ 
+   Slot->SyncFd = SCI_SYNC_NO_FD;
+   
+   if (Slot->Config.SyncPolicy != PL_MGR_SciFileSync_NONE)
+   {
+      Slot->SyncFd = SCI_SYNC_Open(Slot->TmpName);
+   }
+
+} /* End OpenSyncFd() */
+
+
+/******************************************************************************
+** Functions: PublishStatus
+**
+** Update the status snapshot that isn't being read and make it current
+**
+** Notes:
+**   1. Must be called with the mutex held so there's only one publisher.
+**   2. The file information is only copied when it has changed since the
+**      snapshot was last updated.
+**
+*/
+static void PublishStatus(SCI_FILE_Class_t *SciFile)
+{
+
+   uint32 Seq = SciFile->SnapshotSeq + 1;
+   SCI_FILE_Snapshot_t *Snapshot = &SciFile->Snapshot[Seq & 1];
+   PL_MGR_FileInfoTlm_Payload_t *FileInfo = &Snapshot->FileInfo;
+   
+   Snapshot->Status.State           = SciFile->State;
+   Snapshot->Status.FileOpen        = SciFile->File.IsOpen;
+   Snapshot->Status.ConfigPending   = SciFile->ConfigPending;
+   Snapshot->Status.ImageCnt        = SciFile->ImageCnt;
+   Snapshot->Status.InfoChangeCnt   = SciFile->InfoChangeCnt;
+   Snapshot->Status.SyncCnt         = SciFile->SyncCnt;
+   Snapshot->Status.CodecUsec       = SciFile->CodecUsec;
+   Snapshot->Status.LastImageCrc    = SciFile->LastImageCrc;
+   Snapshot->Status.RoiSavedByteCnt = SciFile->RoiSavedByteCnt;
+   Snapshot->Status.CompRatio       = 100;
+   if (SciFile->EncodedByteCnt > 0)
+   {
+      Snapshot->Status.CompRatio = (uint16)(((uint64)SciFile->RawByteCnt * 100) / SciFile->EncodedByteCnt);
+   }
+   
+   FileInfo->FileOpen = SciFile->File.IsOpen;
+   if (FileInfo->ChangeCnt != SciFile->InfoChangeCnt)
+   {
+      FileInfo->ChangeCnt     = SciFile->InfoChangeCnt;
+      FileInfo->FileFormat    = SciFile->File.Config.FileFormat;
+      FileInfo->Codec         = SciFile->File.Config.Codec;
+      FileInfo->ImagesPerFile = SciFile->File.Config.ImagesPerFile;
+      strncpy(FileInfo->Filename, SciFile->File.Name, OS_MAX_PATH_LEN);
+      FileInfo->Config        = SciFile->Config;
+      FileInfo->ConfigPending = SciFile->ConfigPending;
+      FileInfo->PendingConfig = SciFile->PendingConfig;
+   }
+   
+   __atomic_store_n(&SciFile->SnapshotSeq, Seq, __ATOMIC_RELEASE);
+
+} /* End PublishStatus() */
+
+
+/******************************************************************************
+** Functions: RecoverFile
+**
+** Restore a checkpointed file slot's file to its checkpointed length
+**
+** Notes:
+**   1. Data written after the checkpoint is discarded. The file fails to
+**      recover if it's shorter than its checkpointed length.
+**   2. The file must not be open.
+*/
+static bool RecoverFile(SCI_FILE_Slot_t *Slot)
+{
+   
+   bool       RetStatus = false;
+   os_fstat_t FileStat;
+   uint32     FileLen = 0;
+   
+   if (OS_stat(Slot->TmpName, &FileStat) == OS_SUCCESS)
+   {
+      
+      FileLen = OS_FILESTAT_SIZE(FileStat);
+      
+      if (FileLen == Slot->Catalog.FileLen)
+      {
+         RetStatus = true;
+      }
+      else if (FileLen > Slot->Catalog.FileLen)
+      {
+         RetStatus = SCI_SYNC_Truncate(Slot->TmpName, Slot->Catalog.FileLen);
+      }
+   }
+   
+   if (RetStatus == false)
+   {
+      CFE_EVS_SendEvent (SCI_FILE_RESUME_ERR_EID, CFE_EVS_EventType_ERROR, 
+                         "Science file %s can't be recovered. Length %d, checkpointed length %d",
+                         Slot->TmpName, FileLen, Slot->Catalog.FileLen);
+   }
+   
+   return RetStatus;
+   
+} /* End RecoverFile() */
+
+
+/******************************************************************************
+** Functions: ReleaseTmpName
+**
+** Return true if no file has the temporary filename
+**
+** Notes:
+**   1. If the file waiting to be closed has the name it's closed so it's
+**      committed with its final name.
+**   2. Any other file with the name wasn't created by the caller's slot so
+**      it's left alone and false is returned. See prologue notes.
+*/
+static bool ReleaseTmpName(SCI_FILE_Class_t *SciFile, const char *TmpFilename)
+{
+   
+   os_fstat_t FileStat;
+   
+   if (SciFile->ClosingFile.IsOpen && strcmp(SciFile->ClosingFile.TmpName, TmpFilename) == 0)
+   {
+      CloseSlot(SciFile, &SciFile->ClosingFile);
+   }
+   
+   return (OS_stat(TmpFilename, &FileStat) != OS_SUCCESS);
+   
+} /* End ReleaseTmpName() */
+
+
+/******************************************************************************
+** Functions: RestoreCheckpoint
+**
+** Register the checkpoint's Critical Data Store block and resume science
+** data collection if the restored checkpoint was collecting
+**
+** Notes:
+**   1. The checkpoint is saved after it's restored so the block always
+**      describes the current state.
+**   2. Checkpoints aren't saved if the block can't be registered.
+*/
+static void RestoreCheckpoint(SCI_FILE_Class_t *SciFile)
+{
+   
+   char  CdsName[OS_MAX_API_NAME];
+   int32 CdsStatus;
+   
+   snprintf(CdsName, OS_MAX_API_NAME, "SCIFILE%d", SciFile->Channel);
+   CdsStatus = CFE_ES_RegisterCDS(&SciFile->CdsHandle, sizeof(SCI_FILE_Checkpoint_t), CdsName);
+   
+   if (CdsStatus == CFE_ES_CDS_ALREADY_EXISTS)
+   {
+      
+      SciFile->CdsValid = true;
+      
+      CdsStatus = CFE_ES_RestoreFromCDS(&SciFile->Checkpoint, SciFile->CdsHandle);
+      if (CdsStatus == CFE_SUCCESS)
+      {
+         if (SciFile->Checkpoint.State == SCI_FILE_ENABLED)
+         {
+            ResumeCollection(SciFile);
+         }
+      }
+      else
+      {
+         CFE_EVS_SendEvent (SCI_FILE_RESUME_ERR_EID, CFE_EVS_EventType_ERROR, 
+                            "Science file checkpoint restore failed, status 0x%08X. Science collection not resumed.",
+                            CdsStatus);
+      }
+   }
+   else if (CdsStatus == CFE_SUCCESS)
+   {
+      SciFile->CdsValid = true;
+   }
+   else
+   {
+      CFE_EVS_SendEvent (SCI_FILE_RESUME_ERR_EID, CFE_EVS_EventType_ERROR, 
+                         "Science file checkpoint registration failed, status 0x%08X. Science collection can't be resumed.",
+                         CdsStatus);
+   }
+   
+   SaveCheckpoint(SciFile, true);
+   
+} /* End RestoreCheckpoint() */
+
+
+/******************************************************************************
+** Functions: RestoreSlot
+**
+** Restore a file slot from its checkpoint
+**
+** Notes:
+**   1. The slot's file isn't opened.
+*/
+static void RestoreSlot(SCI_FILE_Slot_t *Slot, const SCI_FILE_SlotCheckpoint_t *SlotCheckpoint)
+{
+   
+   Slot->IsOpen   = false;
+   Slot->Finished = false;
+   Slot->SyncFd   = SCI_SYNC_NO_FD;
+   Slot->ImageId  = SlotCheckpoint->ImageId;
+   Slot->Config   = SlotCheckpoint->Config;
+   Slot->Catalog  = SlotCheckpoint->Catalog;
+   strncpy(Slot->Name, SlotCheckpoint->Name, OS_MAX_PATH_LEN);
+   Slot->Name[OS_MAX_PATH_LEN-1] = '\0';
+   strncpy(Slot->TmpName, SlotCheckpoint->TmpName, OS_MAX_PATH_LEN);
+   Slot->TmpName[OS_MAX_PATH_LEN-1] = '\0';
+   
+} /* End RestoreSlot() */
+
+
+/******************************************************************************
+** Functions: ResumeCollection
+**
+** Resume science data collection using the restored checkpoint
+**
+** Notes:
+**   1. The checkpointed configurations are only used if they're still valid.
+**   2. A finished file whose close was pending is committed. It isn't open
+**      so unless its sync policy is NONE it's synced by name. If the
+**      current file can't be resumed it's left with its temporary name and
+**      a new file is created with the next image. A current file without
+**      any images is deleted.
+*/
+static void ResumeCollection(SCI_FILE_Class_t *SciFile)
+{
+   
+   SCI_FILE_Checkpoint_t *Checkpoint = &SciFile->Checkpoint;
+   
+   if (ValidFileFormat(Checkpoint->Config.FileFormat) && 
+       ValidCodec(Checkpoint->Config.FileFormat, Checkpoint->Config.Codec) &&
+       ValidSync(Checkpoint->Config.SyncPolicy, Checkpoint->Config.SyncInterval) &&
+       SCI_ROI_Valid(&Checkpoint->Config.Roi, SCI_FILE_ROW_LEN))
+   {
+      SciFile->Config = Checkpoint->Config;
+   }
+   
+   if (Checkpoint->ConfigPending &&
+       ValidFileFormat(Checkpoint->PendingConfig.FileFormat) && 
+       ValidCodec(Checkpoint->PendingConfig.FileFormat, Checkpoint->PendingConfig.Codec) &&
+       ValidSync(Checkpoint->PendingConfig.SyncPolicy, Checkpoint->PendingConfig.SyncInterval) &&
+       SCI_ROI_Valid(&Checkpoint->PendingConfig.Roi, SCI_FILE_ROW_LEN))
+   {
+      SciFile->PendingConfig = Checkpoint->PendingConfig;
+      SciFile->ConfigPending = true;
+   }
+   
+   if (strcmp(Checkpoint->NextTmpName, SCI_FILE_UNDEF_FILE) != 0)
+   {
+      OS_remove(Checkpoint->NextTmpName);
+   }
+   
+   if (Checkpoint->ClosingFile.IsOpen)
+   {
+      RestoreSlot(&SciFile->ClosingFile, &Checkpoint->ClosingFile);
+      if (RecoverFile(&SciFile->ClosingFile))
+      {
+         if (SciFile->ClosingFile.Config.SyncPolicy != PL_MGR_SciFileSync_NONE)
+         {
+            if (!SCI_SYNC_File(SciFile->ClosingFile.TmpName))
+            {
+               SciFile->ClosingFile.Catalog.Flags |= SCI_CATALOG_FILE_WRITE_ERR;
+            }
+         }
+         CommitFile(&SciFile->ClosingFile);
+      }
+      strcpy(SciFile->ClosingFile.Name, SCI_FILE_UNDEF_FILE);
+      strcpy(SciFile->ClosingFile.TmpName, SCI_FILE_UNDEF_FILE);
+   }
+   
+   SciFile->State = SCI_FILE_ENABLED;
+   SciFile->CreateNewFile = true;
+   
+   if (Checkpoint->File.IsOpen)
+   {
+      
+      RestoreSlot(&SciFile->File, &Checkpoint->File);
+      
+      if (SciFile->File.Catalog.ImageCnt == 0)
+      {
+         OS_remove(SciFile->File.TmpName);
+      }
+      else if (ResumeFile(SciFile))
+      {
+         
+         SciFile->CreateNewFile = false;
+         SciFile->WaitForImage  = true;
+         
+         CFE_EVS_SendEvent (SCI_FILE_RESUME_EID, CFE_EVS_EventType_INFORMATION, 
+                            "Resumed science file %s after image %d at length %d",
+                            SciFile->File.Name, SciFile->ImageCnt, SciFile->File.Catalog.FileLen);
+      }
+      
+      if (!SciFile->File.IsOpen)
+      {
+         strcpy(SciFile->File.Name, SCI_FILE_UNDEF_FILE);
+         strcpy(SciFile->File.TmpName, SCI_FILE_UNDEF_FILE);
+      }
+   }
+   
+   if (SciFile->CreateNewFile)
+   {
+      CFE_EVS_SendEvent (SCI_FILE_RESUME_EID, CFE_EVS_EventType_INFORMATION, 
+                         "Resumed science collection, a new file will be created with the next image");
+   }
+   
+   SciFile->InfoChangeCnt++;
+   
+} /* End ResumeCollection() */
+
+
+/******************************************************************************
+** Functions: ResumeFile
+**
+** Reopen the restored current file and continue writing it after the
+** checkpointed image
+**
+** Notes:
+**   1. The restored file slot's name, configuration and catalog entry are
+**      used. The file's data isn't read so its CRC isn't verified.
+**   2. The encoder dictionary isn't restored so the next image is encoded
+**      without the previous row. See prologue notes.
+*/
+static bool ResumeFile(SCI_FILE_Class_t *SciFile)
+{
+   
+   SCI_FILE_Slot_t       *Slot = &SciFile->File;
+   SCI_FILE_Checkpoint_t *Checkpoint = &SciFile->Checkpoint;
+   int32 SysStatus = OS_ERROR;
+   
+   if (RecoverFile(Slot))
+   {
+      if (SciFile->Sink == SCI_FILE_SINK_MMAP)
+      {
+         if (SCI_MMAP_Resume(&Slot->MmapSink, Slot->TmpName, MaxFileLen(&Slot->Config), Slot->Catalog.FileLen))
+         {
+            SysStatus = OS_SUCCESS;
+         }
+      }
+      else
+      {
+         SysStatus = OS_OpenCreate(&Slot->Handle, Slot->TmpName, OS_FILE_FLAG_NONE, OS_READ_WRITE);
+         if (SysStatus == OS_SUCCESS)
+         {
+            if (OS_lseek(Slot->Handle, Slot->Catalog.FileLen, OS_SEEK_SET) == (int32)Slot->Catalog.FileLen)
+            {
+               OpenSyncFd(Slot);
+            }
+            else
+            {
+               OS_close(Slot->Handle);
+               SysStatus = OS_ERROR;
+            }
+         }
+      }
+      
+      if (SysStatus != OS_SUCCESS)
+      {
+         CFE_EVS_SendEvent (SCI_FILE_RESUME_ERR_EID, CFE_EVS_EventType_ERROR, 
+                            "Error reopening science file %s to resume it", Slot->TmpName);
+      }
+   }
+   
+   if (SysStatus == OS_SUCCESS)
+   {
+      
+      Slot->IsOpen = true;
+      
+      SciFile->ImageCnt       = Checkpoint->ImageCnt;
+      SciFile->RecordCnt      = Checkpoint->RecordCnt;
+      SciFile->LastImageCrc   = Checkpoint->LastImageCrc;
+      SciFile->RawByteCnt     = Checkpoint->RawByteCnt;
+      SciFile->EncodedByteCnt = Checkpoint->EncodedByteCnt;
+      SciFile->CodecUsec      = Checkpoint->CodecUsec;
+      SciFile->SyncImageCnt   = Checkpoint->SyncImageCnt;
+      CFE_PSP_GetTime(&SciFile->SyncTime);
+      
+   }
+   
+   return Slot->IsOpen;
+   
+} /* End ResumeFile() */
+
+
+/******************************************************************************
+** Functions: RotateFile
+**
+** Finish the current file and defer closing it to SCI_FILE_ManageFiles()
+**
+** Notes:
+**   1. If the previous file's close is still pending it's closed now.
+*/
+static void RotateFile(SCI_FILE_Class_t *SciFile)
+{
+ 
+   if (SciFile->File.IsOpen)
+   {
+      
+      FinishFile(SciFile);
+      
+      if (SciFile->ClosingFile.IsOpen)
+      {
+         CloseSlot(SciFile, &SciFile->ClosingFile);
+      }
+      
+      SciFile->ClosingFile = SciFile->File;
+      SciFile->File.IsOpen = false;
+      strcpy(SciFile->File.Name, SCI_FILE_UNDEF_FILE);
+      SciFile->InfoChangeCnt++;
+
+   }
+
+} /* End RotateFile() */
+
+
+/******************************************************************************
+** Functions: SaveCheckpoint
+**
+** Save the science data collection state to the Critical Data Store
+**
+** Notes:
+**   1. The caller must hold the mutex unless it's the constructor.
+**   2. The current file's checkpoint is only consistent with the file at
+**      image boundaries so the current file and its counters are only
+**      saved when ImageBoundary is true. The previous image boundary's
+**      values are saved otherwise. See prologue notes.
+**   3. Checkpoints are no longer saved after a Critical Data Store error.
+*/
+static void SaveCheckpoint(SCI_FILE_Class_t *SciFile, bool ImageBoundary)
+{
+   
+   SCI_FILE_Checkpoint_t *Checkpoint = &SciFile->Checkpoint;
+   int32 CdsStatus;
+   
+   if (SciFile->CdsValid)
+   {
+      
+      if (ImageBoundary)
+      {
+         Checkpoint->ImageCnt       = SciFile->ImageCnt;
+         Checkpoint->RecordCnt      = SciFile->RecordCnt;
+         Checkpoint->LastImageCrc   = SciFile->LastImageCrc;
+         Checkpoint->RawByteCnt     = SciFile->RawByteCnt;
+         Checkpoint->EncodedByteCnt = SciFile->EncodedByteCnt;
+         Checkpoint->CodecUsec      = SciFile->CodecUsec;
+         Checkpoint->SyncImageCnt   = SciFile->SyncImageCnt;
+         SaveSlot(&Checkpoint->File, &SciFile->File);
+      }
+      
+      Checkpoint->State  = SciFile->State;
+      Checkpoint->Config = SciFile->Config;
+      Checkpoint->ConfigPending = SciFile->ConfigPending;
+      Checkpoint->PendingConfig = SciFile->PendingConfig;
+      SaveSlot(&Checkpoint->ClosingFile, &SciFile->ClosingFile);
+      if (SciFile->NextFile.IsOpen)
+      {
+         strcpy(Checkpoint->NextTmpName, SciFile->NextFile.TmpName);
+      }
+      else
+      {
+         strcpy(Checkpoint->NextTmpName, SCI_FILE_UNDEF_FILE);
+      }
+      
+      CdsStatus = CFE_ES_CopyToCDS(SciFile->CdsHandle, Checkpoint);
+      if (CdsStatus != CFE_SUCCESS)
+      {
+         SciFile->CdsValid = false;
+         CFE_EVS_SendEvent (SCI_FILE_RESUME_ERR_EID, CFE_EVS_EventType_ERROR, 
+                            "Science file checkpoint save failed, status 0x%08X. Checkpoints disabled.",
+                            CdsStatus);
+      }
+   }
+   
+} /* End SaveCheckpoint() */
+
+
+/******************************************************************************
+** Functions: SaveSlot
+**
+** Save a file slot to its checkpoint
+**
+*/
+static void SaveSlot(SCI_FILE_SlotCheckpoint_t *SlotCheckpoint, const SCI_FILE_Slot_t *Slot)
+{
+   
+   SlotCheckpoint->IsOpen = Slot->IsOpen;
+   
+   if (Slot->IsOpen)
+   {
+      SlotCheckpoint->ImageId = Slot->ImageId;
+      SlotCheckpoint->Config  = Slot->Config;
+      SlotCheckpoint->Catalog = Slot->Catalog;
+      strcpy(SlotCheckpoint->Name, Slot->Name);
+      strcpy(SlotCheckpoint->TmpName, Slot->TmpName);
+   }
+   
+} /* End SaveSlot() */
+
+
+/******************************************************************************
+** Functions: ScheduleSync
+**
+** Request a sync of the current file when the file's sync policy is met
+**
+** Notes:
+**   1. Called when an image is complete. The sync is performed by
+**      SCI_FILE_ManageFiles(), see prologue notes.
+**   2. The SECONDS policy is only checked at image boundaries so the sync
+**      interval is the first image boundary after the interval expires.
+*/
+static void ScheduleSync(SCI_FILE_Class_t *SciFile)
+{
+ 
+   OS_time_t CurrentTime;
+   
+   switch (SciFile->File.Config.SyncPolicy)
+   {
+      case PL_MGR_SciFileSync_IMAGE:
+         SciFile->SyncPending = true;
+         break;
+      case PL_MGR_SciFileSync_IMAGES:
+         SciFile->SyncImageCnt++;
+         if (SciFile->SyncImageCnt >= SciFile->File.Config.SyncInterval)
+         {
+            SciFile->SyncPending = true;
+         }
+         break;
+      case PL_MGR_SciFileSync_SECONDS:
+         CFE_PSP_GetTime(&CurrentTime);
+         if (OS_TimeGetTotalMilliseconds(OS_TimeSubtract(CurrentTime, SciFile->SyncTime)) >=
+             ((int64)SciFile->File.Config.SyncInterval * 1000))
+         {
+            SciFile->SyncPending = true;
+         }
+         break;
+      default:
+         break;
+   }
+
+} /* End ScheduleSync() */
+
+
+/******************************************************************************
+** Functions: SyncFile
+**
+** Write a file slot's data to storage
+**
+** Notes:
+**   1. The file must be open. It's synced through its memory mapped sink's
+**      descriptor or its SCI_SYNC descriptor. See prologue notes.
+**   2. The sync time is recorded in the SYNC_FILE performance stage.
+**   3. A failed sync is recorded in the file's catalog entry as a write
+**      error because the file's data may not be in storage.
+*/
+static bool SyncFile(SCI_FILE_Class_t *SciFile, SCI_FILE_Slot_t *Slot)
+{
+ 
+   bool      RetStatus;
+   OS_time_t StageTime;
+   
+   PERF_HIST_Start(&StageTime);
+   if (SciFile->Sink == SCI_FILE_SINK_MMAP)
+   {
+      RetStatus = SCI_SYNC_Descriptor(Slot->MmapSink.Fd);
+   }
+   else
+   {
+      RetStatus = SCI_SYNC_Descriptor(Slot->SyncFd);
+   }
+   PERF_HIST_Stop(PERF_HIST_SYNC_FILE, &StageTime);
+   
+   SciFile->SyncCnt++;
+   if (RetStatus == false)
+   {
+      Slot->Catalog.Flags |= SCI_CATALOG_FILE_WRITE_ERR;
+   }
+   
+   return RetStatus;
+
+} /* End SyncFile() */
+
+
+/******************************************************************************
+** Functions: UniqueFilename
+**
+** Make a finished file slot's final name unique and return true if it is
+**
+** Notes:
+**   1. If a file already has the slot's name a "_N" suffix is inserted
+**      before the extension using the lowest N that isn't used. False is
+**      returned if every suffix up to SCI_FILE_NAME_SUFFIX_MAX is used or
+**      doesn't fit in OS_MAX_PATH_LEN.
+*/
+static bool UniqueFilename(SCI_FILE_Slot_t *Slot)
+{
+ 
+   bool       RetStatus = true;
+   uint16     Suffix;
+   int        BaseLen;
+   char       Filename[OS_MAX_PATH_LEN];
+   os_fstat_t FileStat;
+   
+   if (OS_stat(Slot->Name, &FileStat) == OS_SUCCESS)
+   {
+      
+      RetStatus = false;
+      BaseLen   = strlen(Slot->Name) - strlen(Slot->Config.FileExtension);
+      
+      for (Suffix=1; !RetStatus && Suffix <= SCI_FILE_NAME_SUFFIX_MAX; Suffix++)
+      {
+         if (snprintf(Filename, OS_MAX_PATH_LEN, "%.*s_%u%s", BaseLen, Slot->Name,
+                      Suffix, Slot->Config.FileExtension) < OS_MAX_PATH_LEN)
+         {
+            if (OS_stat(Filename, &FileStat) != OS_SUCCESS)
+            {
+               strcpy(Slot->Name, Filename);
+               RetStatus = true;
+            }
+         }
+      }
+      
+   }
+   
+   return RetStatus;
+   
+} /* End UniqueFilename() */
+
+
+/******************************************************************************
+** Functions: UseNextFile
+**
+** Make the pre-opened next file the current file
+**
+** Notes:
+**   1. The next file is renamed from the next file slot's name to the
+**      temporary name for ImageId. It's discarded and false is returned if
+**      the configuration changed after the file was pre-opened or if the
+**      temporary name is used by a file that the slot didn't create.
+*/
+static bool UseNextFile(SCI_FILE_Class_t *SciFile, uint16 ImageId)
+{
+ 
+   bool RetStatus = false;
+   char Filename[OS_MAX_PATH_LEN];
+   char TmpFilename[OS_MAX_PATH_LEN];
+   
+   if (SciFile->NextFile.IsOpen)
+   {
+      
+      if (memcmp(&SciFile->NextFile.Config, &SciFile->Config, sizeof(PL_MGR_ConfigSciFile_Payload_t)) == 0)
+      {
+         
+         CreateCntFilename(SciFile, Filename, ImageId);
+         CreateTmpFilename(TmpFilename, Filename);
+         if (ReleaseTmpName(SciFile, TmpFilename))
+         {
+            if (OS_rename(SciFile->NextFile.TmpName, TmpFilename) == OS_SUCCESS)
+            {
+               strcpy(SciFile->NextFile.Name, Filename);
+               strcpy(SciFile->NextFile.TmpName, TmpFilename);
+               SciFile->NextFile.ImageId = ImageId;
+               RetStatus = true;
+            }
+         }
+      }
+      
+      if (RetStatus)
+      {
+         SciFile->File = SciFile->NextFile;
+         SciFile->NextFile.IsOpen = false;
+         strcpy(SciFile->NextFile.Name, SCI_FILE_UNDEF_FILE);
+         strcpy(SciFile->NextFile.TmpName, SCI_FILE_UNDEF_FILE);
+      }
+      else
+      {
+         DiscardSlot(SciFile, &SciFile->NextFile);
+      }
+      
+   }
+
+   return RetStatus;
+   
+} /* End UseNextFile() */
+
+
+/******************************************************************************
+** Functions: FlushWriteBuf
+**
+** Write the staged detector data to the current science file
+**
+** Notes:
+**   1. The staged data is discarded regardless of the write status so a
+**      file system error doesn't stall the staging buffer.
+**   2. The memory mapped sink doesn't use the staging buffer. Its data is
+**      already in the file so the update to storage is scheduled.
+*/
+static bool FlushWriteBuf(SCI_FILE_Class_t *SciFile)
+{
+   
+   bool  RetStatus = true;
+   
+   if (SciFile->Sink == SCI_FILE_SINK_MMAP)
+   {
+      RetStatus = SCI_MMAP_Sync(&SciFile->File.MmapSink);
+      if (RetStatus == false)
+      {
+         SciFile->File.Catalog.Flags |= SCI_CATALOG_FILE_WRITE_ERR;
+      }
+   }
+   else if (SciFile->WriteBufLen > 0)
+   {
+   
+      RetStatus = WriteFileData(SciFile, SciFile->WriteBuf, SciFile->WriteBufLen);
+      SciFile->WriteBufLen = 0;
+  
+   } /* End if data staged */
+   
+   return RetStatus;
+   
+} /* End FlushWriteBuf() */
+
+
+/******************************************************************************
+** Functions: MaxFileLen
+**
+** Return the maximum number of bytes in a file using a file configuration. 
+**
+** Notes:
+**   1. A text row can't be longer than the detector's row buffer.
+**   2. A file's header is included.
+*/
+static uint32 MaxFileLen(const PL_MGR_ConfigSciFile_Payload_t *Config)
+{
+   
+   uint32 ImagesPerFile = (Config->ImagesPerFile > 0) ? Config->ImagesPerFile : 1;
+   uint32 FileLen;
+   
+   if (Config->FileFormat == PL_MGR_SciFileFormat_BINARY)
+   {
+      FileLen = sizeof(SCI_FILE_BinHeader_t) + sizeof(SCI_FILE_BinTrailer_t) +
+                ImagesPerFile * PL_SIM_LIB_DETECTOR_ROWS_PER_IMAGE * SCI_FILE_BIN_REC_LEN;
+   }
+   else
+   {
+      FileLen = SCI_FILE_TEXT_HDR_LEN +
+                ImagesPerFile * PL_SIM_LIB_DETECTOR_ROWS_PER_IMAGE * SCI_FILE_ROW_LEN;
+   }
+   
+   return FileLen;
+   
+} /* End MaxFileLen() */
+
+
+/******************************************************************************
+** Functions: StageData
+**
+** Copy data into the staging buffer
+**
+** Notes:
+**   1. The staging buffer is flushed when the data won't fit in the remaining
+**      space and when the staged data reaches the flush threshold. Data that
+**      is longer than the staging buffer is written directly to the file
+**      after the staged data is flushed.
+**   2. The memory mapped sink copies the data directly to the file.
+**   3. The file's catalog length and CRC include all staged data.
+**   4. False is returned if any write fails.
+*/
+static bool StageData(SCI_FILE_Class_t *SciFile, const void *Data, uint32 DataLen)
+{
+   
+   bool RetStatus = true;
+   
+   SciFile->File.Catalog.FileLen += DataLen;
+   SciFile->File.Catalog.FileCrc  = SCI_CRC_Update(SciFile->File.Catalog.FileCrc, Data, DataLen);
+   
+   if (SciFile->Sink == SCI_FILE_SINK_MMAP)
+   {
+      RetStatus = SCI_MMAP_Write(&SciFile->File.MmapSink, Data, DataLen);
+      if (RetStatus == false)
+      {
+         SciFile->File.Catalog.Flags |= SCI_CATALOG_FILE_WRITE_ERR;
+      }
+   }
+   else
+   {
+      
+      if ((SciFile->WriteBufLen + DataLen) > SCI_FILE_WRITE_BUF_LEN)
+      {
+         RetStatus = FlushWriteBuf(SciFile);
+      }
+      
+      if (DataLen > SCI_FILE_WRITE_BUF_LEN)
+      {
+         RetStatus = WriteFileData(SciFile, Data, DataLen) && RetStatus;
+      }
+      else
+      {
+         
+         memcpy(&SciFile->WriteBuf[SciFile->WriteBufLen], Data, DataLen);
+         SciFile->WriteBufLen += DataLen;
+         
+         if (SciFile->WriteBufLen >= SciFile->FlushThreshold)
+         {
+            RetStatus = FlushWriteBuf(SciFile) && RetStatus;
+         }
+      }
+   }
+   
+   return RetStatus;
+   
+} /* End StageData() */
+
+
+/******************************************************************************
+** Functions: BuildRecord
+**
+** Build a detector row's binary record header and return a pointer to the
+** record's data
+**
+** Notes:
+**   1. The row is cropped by the ROI into EncodeBuf and then it's encoded
+**      when Codec isn't NONE.
+**   2. ImageCrc is the image's rolling CRC and it's restarted by the image's
+**      first record. Record CRCs are computed over the stored data bytes.
+**
+*/
+static const uint8 *BuildRecord(SCI_FILE_Encoder_t *Encoder, uint16 Codec, const PL_MGR_SciRoi_t *Roi,
+                                const PL_SIM_LIB_Detector_t *Detector, uint16 RecordFlags, uint8 *EncodeBuf,
+                                SCI_FILE_BinRecordHdr_t *RecordHdr, uint32 *ImageCrc, uint32 *CodecUsec)
+{
+   
+   const uint8 *RecordData = (const uint8 *)Detector->Row.Data;
+   uint32       RowLen     = SCI_FILE_ROW_LEN;
+   
+   if (!SCI_ROI_FullRow(Roi))
+   {
+      RowLen = SCI_ROI_CropRow(Roi, RecordData, SCI_FILE_ROW_LEN, EncodeBuf);
+      RecordData = EncodeBuf;
+   }
+   
+   RecordHdr->Sync    = SCI_FILE_BIN_REC_SYNC;
+   RecordHdr->ImageId = Detector->ImageCnt;
+   RecordHdr->RowIdx  = Detector->ReadoutRow;
+   RecordHdr->Length  = RowLen;
+   RecordHdr->Flags   = RecordFlags;
+   
+   if (Codec != PL_MGR_SciFileCodec_NONE && RowLen > 1)
+   {
+      RecordData = EncodeRow(Encoder, Codec, Detector, RecordData, RowLen, EncodeBuf, RecordHdr, CodecUsec);
+   }
+   
+   if (RecordFlags & SCI_FILE_BIN_REC_FIRST_ROW)
+   {
+      *ImageCrc = SCI_CRC_INIT;
+   }
+   RecordHdr->Crc      = SCI_CRC_Update(SCI_CRC_INIT, RecordData, RecordHdr->Length);
+   RecordHdr->ImageCrc = SCI_CRC_Update(*ImageCrc, RecordData, RecordHdr->Length);
+   *ImageCrc = RecordHdr->ImageCrc;
+   
+   return RecordData;
+   
+} /* End BuildRecord() */
+
+
+/******************************************************************************
+** Functions: EncodeRow
+**
+** Encode a detector row's RowLen bytes of data and return a pointer to the
+** record's data
+**
+** Notes:
+**   1. RecordHdr's Length and Flags are updated for the returned data.
+**   2. RowData is returned if the encoding isn't smaller. RowData may be
+**      EncodeBuf and it's restored from CodecBuf if it was overwritten.
+**   3. See prologue notes for the LZ dictionary. The previous row is kept
+**      at the end of the first half of CodecBuf so it immediately precedes
+**      the row being encoded.
+*/
+static const uint8 *EncodeRow(SCI_FILE_Encoder_t *Encoder, uint16 Codec, const PL_SIM_LIB_Detector_t *Detector,
+                              const uint8 *RowData, uint32 RowLen, uint8 *EncodeBuf,
+                              SCI_FILE_BinRecordHdr_t *RecordHdr, uint32 *CodecUsec)
+{
+   
+   uint32       DictLen = 0;
+   uint32       EncodedLen;
+   OS_time_t    StartTime;
+   OS_time_t    StopTime;
+   
+   CFE_PSP_GetTime(&StartTime);
+   
+   if (Encoder->PrevRowValid && Encoder->PrevImageId == Detector->ImageCnt &&
+       (Encoder->PrevRowIdx + 1) == Detector->ReadoutRow && Encoder->PrevRowLen == RowLen)
+   {
+      DictLen = RowLen;
+   }
+   
+   memcpy(&Encoder->CodecBuf[SCI_FILE_ROW_LEN], RowData, RowLen);
+   EncodedLen = SCI_CODEC_Encode(Codec, &Encoder->CodecBuf[SCI_FILE_ROW_LEN - DictLen],
+                                 DictLen, RowLen, EncodeBuf, RowLen - 1);
+   
+   /* Save the unencoded row for the next row's dictionary */
+   memcpy(&Encoder->CodecBuf[SCI_FILE_ROW_LEN - RowLen], &Encoder->CodecBuf[SCI_FILE_ROW_LEN], RowLen);
+   Encoder->PrevRowValid = true;
+   Encoder->PrevImageId  = Detector->ImageCnt;
+   Encoder->PrevRowIdx   = Detector->ReadoutRow;
+   Encoder->PrevRowLen   = RowLen;
+   
+   if (EncodedLen > 0)
+   {
+      RecordHdr->Length = EncodedLen;
+      RecordHdr->Flags |= SCI_FILE_BIN_REC_ENCODED;
+      RowData = EncodeBuf;
+   }
+   else if (RowData == EncodeBuf)
+   {
+      memcpy(EncodeBuf, &Encoder->CodecBuf[SCI_FILE_ROW_LEN - RowLen], RowLen);
+   }
+   
+   CFE_PSP_GetTime(&StopTime);
+   *CodecUsec += (uint32)OS_TimeGetTotalMicroseconds(OS_TimeSubtract(StopTime, StartTime));
+   
+   return RowData;
+   
+} /* End EncodeRow() */
+
+
+/******************************************************************************
+** Functions: GetRecord
+**
+** Return a pointer to a row's prebuilt record or NULL if the row must be
+** encoded as it's written
+**
+** Notes:
+**   1. The record can only be used if it was built for the current file's
+**      format, codec and ROI. See prologue notes.
+**
+*/
+static const SCI_FILE_BinRecord_t *GetRecord(SCI_FILE_Class_t *SciFile, const SCI_FILE_EncodedImage_t *EncodedImage,
+                                             uint16 RowIdx)
+{
+   
+   const SCI_FILE_BinRecord_t *Record = NULL;
+   
+   if (EncodedImage != NULL)
+   {
+      if (RowIdx < EncodedImage->RecordCnt &&
+          EncodedImage->FileFormat == SciFile->File.Config.FileFormat &&
+          EncodedImage->Codec == SciFile->File.Config.Codec &&
+          memcmp(&EncodedImage->Roi, &SciFile->File.Config.Roi, sizeof(PL_MGR_SciRoi_t)) == 0)
+      {
+         Record = &EncodedImage->Record[RowIdx];
+      }
+   }
+   
+   return Record;
+   
+} /* End GetRecord() */
+
+
+/******************************************************************************
+** Functions: SelectRow
+**
+** Return true if the ROI keeps a detector row and set its binary record
+** flags
+**
+*/
+static bool SelectRow(const PL_MGR_SciRoi_t *Roi, const PL_SIM_LIB_Detector_t *Detector, uint16 *RecordFlags)
+{
+   
+   bool RetStatus;
+   bool FirstRow;
+   bool LastRow;
+   
+   *RecordFlags = 0;
+   
+   RetStatus = SCI_ROI_SelectRow(Roi, Detector->ReadoutRow, &FirstRow, &LastRow);
+   if (FirstRow) *RecordFlags |= SCI_FILE_BIN_REC_FIRST_ROW;
+   if (LastRow)  *RecordFlags |= SCI_FILE_BIN_REC_LAST_ROW;
+   
+   return RetStatus;
+   
+} /* End SelectRow() */
+
+
+/******************************************************************************
+** Functions: ValidCodec
+**
+** Notes:
+**   1. Text files can't be compressed.
+*/
+static bool ValidCodec(uint16 FileFormat, uint16 Codec)
+{
+   
+   return (SCI_CODEC_Valid(Codec) &&
+           (Codec == PL_MGR_SciFileCodec_NONE || FileFormat == PL_MGR_SciFileFormat_BINARY));
+   
+} /* End ValidCodec() */
+
+
+/******************************************************************************
+** Functions: ValidFileFormat
+**
+*/
+static bool ValidFileFormat(uint16 FileFormat)
+{
+   
+   return (FileFormat == PL_MGR_SciFileFormat_TEXT ||
+           FileFormat == PL_MGR_SciFileFormat_BINARY);
+   
+} /* End ValidFileFormat() */
+
+
+/******************************************************************************
+** Functions: ValidFilename
+**
+** Return true if every science file name fits in OS_MAX_PATH_LEN
+**
+** Notes:
+**   1. The longest name has the longest image ID, the longest unique name
+**      suffix and the temporary file extension. See CreateCntFilename()
+**      and UniqueFilename().
+*/
+static bool ValidFilename(const char *BasePathFilename, const char *FileExtension)
+{
+   
+   size_t NameLen;
+   
+   NameLen = strnlen(BasePathFilename, OS_MAX_PATH_LEN) +
+             snprintf(NULL, 0, "%03d_%d", UINT16_MAX, SCI_FILE_NAME_SUFFIX_MAX) +
+             strnlen(FileExtension, SCI_FILE_EXT_MAX_CHAR) + strlen(SCI_FILE_TMP_EXT);
+   
+   return (NameLen < OS_MAX_PATH_LEN);
+   
+} /* End ValidFilename() */
+
+
+/******************************************************************************
+** Functions: ValidSync
+**
+** Notes:
+**   1. Policies other than NONE require the platform's file sync service.
+**   2. The IMAGES and SECONDS policies require a non-zero interval.
+*/
+static bool ValidSync(uint16 SyncPolicy, uint16 SyncInterval)
+{
+   
+   bool RetStatus = false;
+   
+   if (SyncPolicy == PL_MGR_SciFileSync_NONE)
+   {
+      RetStatus = true;
+   }
+   else if (PL_MGR_SCI_FILE_FSYNC)
+   {
+      if (SyncPolicy == PL_MGR_SciFileSync_IMAGE)
+      {
+         RetStatus = true;
+      }
+      else if (SyncPolicy == PL_MGR_SciFileSync_IMAGES || SyncPolicy == PL_MGR_SciFileSync_SECONDS)
+      {
+         RetStatus = (SyncInterval > 0);
+      }
+   }
+   
+   return RetStatus;
+   
+} /* End ValidSync() */
+
+
+/******************************************************************************
+** Functions: WriteBinHeader
+**
+** Stage the binary file header
+**
+*/
+static bool WriteBinHeader(SCI_FILE_Class_t *SciFile, uint16 ImageId)
+{
+   
+   SCI_FILE_BinHeader_t Header;
+   CFE_TIME_SysTime_t   StartTime = CFE_TIME_GetTime();
+   
+   memset(&Header, 0, sizeof(Header));
+   
+   Header.Sync            = SCI_FILE_BIN_HDR_SYNC;
+   Header.Version         = SCI_FILE_BIN_VERSION;
+   Header.HeaderLen       = sizeof(SCI_FILE_BinHeader_t);
+   Header.RecordLen       = SCI_FILE_BIN_REC_LEN;
+   Header.RowLen          = SCI_FILE_ROW_LEN;
+   Header.RowsPerImage    = PL_SIM_LIB_DETECTOR_ROWS_PER_IMAGE;
+   Header.ImagesPerFile   = SciFile->File.Config.ImagesPerFile;
+   Header.FirstImageId    = ImageId;
+   Header.Codec           = SciFile->File.Config.Codec;
+   Header.StartSeconds    = StartTime.Seconds;
+   Header.StartSubseconds = StartTime.Subseconds;
+   Header.RoiFirstRow     = SciFile->File.Config.Roi.FirstRow;
+   Header.RoiRowCnt       = SciFile->File.Config.Roi.RowCnt;
+   Header.RoiRowStep      = SciFile->File.Config.Roi.RowStep;
+   Header.RoiFirstCol     = SciFile->File.Config.Roi.FirstCol;
+   Header.RoiColCnt       = SciFile->File.Config.Roi.ColCnt;
+   Header.RoiColStep      = SciFile->File.Config.Roi.ColStep;
+   Header.RoiColBin       = SciFile->File.Config.Roi.ColBin;
+   
+   return StageData(SciFile, &Header, sizeof(Header));
+   
+} /* End WriteBinHeader() */
+
+
+/******************************************************************************
+** Functions: WriteBinTrailer
+**
+** Stage the binary file trailer
+**
+*/
+static bool WriteBinTrailer(SCI_FILE_Class_t *SciFile)
+{
+   
+   SCI_FILE_BinTrailer_t Trailer;
+   CFE_TIME_SysTime_t    StopTime = CFE_TIME_GetTime();
+   
+   memset(&Trailer, 0, sizeof(Trailer));
+   
+   Trailer.Sync           = SCI_FILE_BIN_TRL_SYNC;
+   Trailer.RecordCnt      = SciFile->RecordCnt;
+   Trailer.ImageCnt       = SciFile->ImageCnt;
+   Trailer.StopSeconds    = StopTime.Seconds;
+   Trailer.StopSubseconds = StopTime.Subseconds;
+   
+   return StageData(SciFile, &Trailer, sizeof(Trailer));
+   
+} /* End WriteBinTrailer() */
+
+
+/******************************************************************************
+** Functions: WriteDetectorRow
+**
+** Stage a detector row to be written to the current science file
+**
+** Notes:
+**   1. The text format writes the row's string. The binary format writes a
+**      record header followed by the row's fixed length data buffer so no
+**      string length scan is required.
+**   2. Binary rows are encoded when the file has a codec. See prologue notes.
+**   3. Binary record CRCs are computed over the stored data bytes.
+**   4. Record is a prebuilt binary record or NULL if the record must be
+**      built. The encoder's dictionary isn't valid after a prebuilt record.
+**   5. Every row is added to the file's catalog entry before it's staged,
+**      including rows that the file's ROI doesn't keep.
+*/
+static bool WriteDetectorRow(SCI_FILE_Class_t *SciFile, const PL_SIM_LIB_Detector_t *Detector, SCI_FILE_Control_t Control,
+                             const SCI_FILE_BinRecord_t *Record, bool RowFault)
+{
+   
+   bool RetStatus = false;
+   const PL_MGR_SciRoi_t *Roi = &SciFile->File.Config.Roi;
+   SCI_FILE_BinRecordHdr_t RecordHdr;
+   const uint8 *RecordData;
+   uint16 RecordFlags;
+   uint32 RowLen;
+   uint32 RoiRowLen;
+   uint8  RoiRow[SCI_FILE_ROW_LEN];
+   
+   if (SciFile->File.IsOpen)
+   {
+     
+      CatalogRow(SciFile, Detector, Control, RowFault);
+     
+      if (SciFile->File.Config.FileFormat == PL_MGR_SciFileFormat_BINARY)
+      {
+         RowLen = SCI_FILE_ROW_LEN;
+      }
+      else
+      {
+         RowLen = strlen(Detector->Row.Data);
+      }
+      
+      if (SelectRow(Roi, Detector, &RecordFlags))
+      {
+      
+         if (SciFile->File.Config.FileFormat == PL_MGR_SciFileFormat_BINARY)
+         {
+         
+            if (Record != NULL)
+            {
+               RecordHdr  = Record->Hdr;
+               RecordData = Record->Data;
+               SciFile->ImageCrc   = RecordHdr.ImageCrc;
+               SciFile->CodecUsec += Record->CodecUsec;
+               SciFile->Encoder.PrevRowValid = false;
+            }
+            else
+            {
+               RecordData = BuildRecord(&SciFile->Encoder, SciFile->File.Config.Codec, Roi, Detector, RecordFlags,
+                                        SciFile->EncodeBuf, &RecordHdr, &SciFile->ImageCrc, &SciFile->CodecUsec);
+            }
+            RoiRowLen = SCI_ROI_CropLen(Roi, RowLen);
+            SciFile->RawByteCnt     += RoiRowLen;
+            SciFile->EncodedByteCnt += RecordHdr.Length;
+            
+            RetStatus = StageData(SciFile, &RecordHdr, sizeof(RecordHdr));
+            RetStatus = StageData(SciFile, RecordData, RecordHdr.Length) && RetStatus;
+         
+         }
+         else
+         {
+            
+            if (SCI_ROI_FullRow(Roi))
+            {
+               RoiRowLen = RowLen;
+               RetStatus = StageData(SciFile, Detector->Row.Data, RowLen);
+            }
+            else
+            {
+               RoiRowLen = SCI_ROI_CropRow(Roi, (const uint8 *)Detector->Row.Data, RowLen, RoiRow);
+               RetStatus = StageData(SciFile, RoiRow, RoiRowLen);
+            }
+         
+         }
+         
+         SciFile->RoiSavedByteCnt += RowLen - RoiRowLen;
+         SciFile->RecordCnt++;
+      
+      }
+      else
+      {
+         
+         SciFile->RoiSavedByteCnt += RowLen;
+         RetStatus = true;
+      
+      }
+      
+      if (Control == SCI_FILE_LAST_ROW)
+      {
+         SciFile->LastImageCrc = SciFile->ImageCrc;
+      }
         
    } /* End file open */
+   else
+   {
+   
+      CFE_EVS_SendEvent (SCI_FILE_WRITE_ERR_EID, CFE_EVS_EventType_ERROR, 
+                         "Error writing to science file %s. IsOpen=%d",
+                         SciFile->File.Name, SciFile->File.IsOpen);
 
+   }
+   
+   return RetStatus;
+   
+} /* End WriteDetectorRow() */
+
+
+/******************************************************************************
+** Functions: WriteFileData
+**
+** Write data to the current science file using the OSAL sink
+**
+** Notes:
+**   1. A failed write sets the file's catalog write error flag.
+*/
+static bool WriteFileData(SCI_FILE_Class_t *SciFile, const void *Data, uint32 DataLen)
+{
+   
+   int32 WriteStatus = 0;
+   bool  RetStatus = false;
+   
+   if (SciFile->File.IsOpen)
+   {
+      WriteStatus = OS_write(SciFile->File.Handle, Data, DataLen);
+      RetStatus   = (WriteStatus == (int32)DataLen);
+   }
+   
    if (RetStatus == false)
    {
    
+      SciFile->File.Catalog.Flags |= SCI_CATALOG_FILE_WRITE_ERR;
       CFE_EVS_SendEvent (SCI_FILE_WRITE_ERR_EID, CFE_EVS_EventType_ERROR, 
-                         "Error writing to science file %s. IsOpen=%d, WriteStatus=%d",
-                         SciFile->Name, SciFile->IsOpen, WriteStatus);
+                         "Error writing %d bytes to science file %s. IsOpen=%d, WriteStatus=%d",
+                         DataLen, SciFile->File.Name, SciFile->File.IsOpen, WriteStatus);
 
    }
    
    return RetStatus;
    
-} /* End WriteDetectorRow() */
+} /* End WriteFileData() */
+
+
+/******************************************************************************
+** Functions: WriteRow
+**
+** Manage the science files for a detector row and write it
+**
+** Notes:
+**   1. The caller must hold the mutex.
+**   2. EncodedImage is NULL or the image's prebuilt records and RowIdx is
+**      the row's index in the image. See GetRecord().
+**   3. A resumed file drops rows until an image's first row so the image
+**      that was interrupted by the restart isn't counted.
+**
+*/
+static void WriteRow(SCI_FILE_Class_t *SciFile, const PL_SIM_LIB_Detector_t *Detector, SCI_FILE_Control_t Control,
+                     const SCI_FILE_EncodedImage_t *EncodedImage, uint16 RowIdx, bool RowFault)
+{
+
+   bool SaveDetectorRow = true; 
+   
+   if (SciFile->State == SCI_FILE_ENABLED)     
+   {
+
+      if (SciFile->CreateNewFile)
+      {
+      
+         /* Wait for first row before creating a file */
+         if (Control == SCI_FILE_FIRST_ROW)
+         {
+            CreateFile(SciFile, Detector->ImageCnt);
+            SciFile->CreateNewFile = false;
+         }
+         else
+         {
+            SaveDetectorRow = false;
+         }
+      }
+      else if (SciFile->WaitForImage)
+      {
+         if (Control == SCI_FILE_FIRST_ROW)
+         {
+            SciFile->WaitForImage = false;
+         }
+         else
+         {
+            SaveDetectorRow = false;
+         }
+      }
+
+      if (SaveDetectorRow)
+      {
+         WriteDetectorRow(SciFile, Detector, Control, GetRecord(SciFile, EncodedImage, RowIdx), RowFault);
+      }
+      
+      if (Control == SCI_FILE_LAST_ROW && !SciFile->WaitForImage)
+      {
+         FlushWriteBuf(SciFile);
+         if (SciFile->File.IsOpen)
+         {
+            ScheduleSync(SciFile);
+         }
+         SciFile->ImageCnt++;
+         if (SciFile->ImageCnt >= SciFile->File.Config.ImagesPerFile)
+         {
+            RotateFile(SciFile);
+            SciFile->CreateNewFile = true;
+         }
+         SaveCheckpoint(SciFile, true);
+         
+      } /* End if SCI_FILE_SAVE_LAST_ROW */
+   } /* End if SCI_FILE_ENABLED */
+
+} /* End WriteRow() */
+
 
+/******************************************************************************
+** Functions: WriteTextHeader
+**
+** Stage the text file header
+**
+** Notes:
+**   1. Only written when the file's ROI isn't full. See prologue notes for
+**      the header's format.
+*/
+static bool WriteTextHeader(SCI_FILE_Class_t *SciFile, uint16 ImageId)
+{
+   
+   const PL_MGR_SciRoi_t *Roi = &SciFile->File.Config.Roi;
+   char   Header[SCI_FILE_TEXT_HDR_LEN];
+   int    HeaderLen;
+   
+   HeaderLen = snprintf(Header, sizeof(Header),
+                        "%s first_image=%d rows_per_image=%d row_len=%d "
+                        "roi_first_row=%d roi_row_cnt=%d roi_row_step=%d "
+                        "roi_first_col=%d roi_col_cnt=%d roi_col_step=%d roi_col_bin=%d\n",
+                        SCI_FILE_TEXT_HDR_ID, ImageId, PL_SIM_LIB_DETECTOR_ROWS_PER_IMAGE,
+                        (int)(SCI_FILE_ROW_LEN - 1), Roi->FirstRow, Roi->RowCnt, Roi->RowStep,
+                        Roi->FirstCol, Roi->ColCnt, Roi->ColStep, Roi->ColBin);
+   
+   if (HeaderLen >= (int)sizeof(Header))
+   {
+      HeaderLen = sizeof(Header) - 1;
+   }
+   
+   return StageData(SciFile, Header, HeaderLen);
 
+} /* End WriteTextHeader() */
@@ -20,6 +20,116 @@
 **       and the payload. Science files only need to know the data being
 **       written. Logic about the payload state and whether or not science
 **       files can be created is maintained by this object's owner.  
+**    2. Detector rows are staged in WriteBuf and written to the file when
+**       an image is complete, when the staged byte count reaches the flush
+**       threshold, or when the file is closed. This minimizes the number of
+**       small writes to the file system.
+**    3. Science files are written by the SCI_WRITER child task and commands
+**       that change the collection state are passed to the child task by
+**       SCI_WRITER so the PL_MGR main task never waits for file I/O. The
+**       exported functions use a mutex to serialize access to the object's
+**       data between the child task and IMG_POOL workers. Each function
+**       that changes the object's data publishes a status snapshot before
+**       it releases the mutex and telemetry is read from the snapshot
+**       without the mutex. See SCI_FILE_GetStatus().
+**    4. Two file formats are supported. The text format writes each row's
+**       string without a terminator. The binary format writes a file header,
+**       a fixed length record for each row and a trailer when the file is
+**       closed. Each record has the same length so a record can be located
+**       using its image and row indices without parsing the file. Binary
+**       fields use the processor's native byte order and readers can use
+**       the sync words to detect the byte order.
+**    5. The SCI_FILE_SINK init file parameter selects how data is written
+**       to the file system. The OSAL sink stages data as described in note 2.
+**       The memory mapped sink preallocates each file to its maximum size
+**       when it's created, copies data directly into the mapped file and
+**       schedules the file's update at each image boundary.
+**    6. File rotation is kept off the detector data path. While a file is
+**       being filled SCI_FILE_ManageFiles() pre-opens the next file so
+**       starting a new file is a file slot swap. A completed file's close
+**       is also deferred to SCI_FILE_ManageFiles(). SCI_WRITER calls
+**       SCI_FILE_ManageFiles() whenever its queue is empty. The next file
+**       is pre-opened with a name that's only used by the next file slot
+**       and it's renamed when its first image ID is known. A file is never
+**       created or renamed over an existing file that wasn't created by the
+**       slot. Image IDs repeat after a detector reset or when they wrap so
+**       a closed file whose name is already used is renamed with a unique
+**       suffix, see app_cfg.h. Existing files are only removed by
+**       SCI_RETAIN.
+**    7. Binary files can be compressed with a lossless SCI_CODEC codec.
+**       Encoding is performed by the SCI_WRITER child task as each row is
+**       written or by an IMG_POOL worker, see note 11. A record's Length is the number of encoded data bytes
+**       that follow the record header and SCI_FILE_BIN_REC_ENCODED is set.
+**       If a row doesn't compress it's written unencoded. Records aren't a
+**       fixed length when a codec is used so the header's RecordLen is the
+**       maximum record length. The LZ codec uses the previous record's
+**       unencoded row as its dictionary if that record is the preceding
+**       row of the same image.
+**    8. InfoChangeCnt is incremented whenever the current file or the
+**       configuration changes so the owner can send file information
+**       telemetry only when it changes.
+**    9. Each binary record header has a CRC32C of the record's data bytes
+**       as they're stored and a rolling CRC32C of the image's stored data
+**       bytes from its first record through the record. The last record's
+**       image CRC covers the whole image. See sci_crc.h for the CRC
+**       definition.
+**   10. There is one instance per detector channel and each instance has
+**       its own mutex and SCI_WRITER. Channel 0 uses the SCI_FILE_PATH_BASE
+**       init file parameter and other channels append "ch<channel>_" to it.
+**   11. When the IMG_POOL worker pool is used a whole image's binary records
+**       are built by a worker with SCI_FILE_EncodeImage() and written by
+**       SCI_WRITER with SCI_FILE_WriteImage(). Record encoding and CRCs
+**       only depend on the image's own rows so the records are identical
+**       to the ones SCI_FILE_WriteDetectorData() builds. If the file the
+**       image is written to doesn't use the format, codec and ROI the
+**       records were built for, or the image doesn't start with its first row, the
+**       rows are encoded as they're written.
+**   12. Each file slot has the file's SCI_CATALOG entry. It's built as the
+**       file is written and it's added to the catalog when the file is
+**       closed. FileLen and FileCrc cover every staged byte and an image's
+**       Offset is the file length when its first row was staged. A row
+**       fault reported by the caller sets the image's FAULT flag.
+**   13. A file is written using its name followed by SCI_FILE_TMP_EXT and
+**       it's renamed to its name when it's closed so a partially written
+**       file is never mistaken for a complete file. The file's SyncPolicy
+**       controls when its data is written to storage with SCI_SYNC. Syncs
+**       are requested at image boundaries and performed by
+**       SCI_FILE_ManageFiles() so they're kept off the detector data path.
+**       Unless the policy is NONE a file is also synced before it's
+**       closed and its directory is synced after it's renamed. Open files
+**       are synced through their memory mapped sink's descriptor or
+**       through the SCI_SYNC descriptor that's opened with their OSAL file.
+**   14. The collection state and the open files are checkpointed to a
+**       Critical Data Store block at each image boundary and whenever
+**       collection is started, stopped or configured. When PL_MGR restarts
+**       with a valid checkpoint collection resumes: the current file is
+**       truncated to its checkpointed length and reopened, rows are dropped
+**       until the next image's first row, and a file whose close was
+**       pending is renamed and cataloged. If the current file can't be
+**       resumed it keeps its temporary name and a new file is created.
+**       The file's data isn't verified so recovery only takes a few file
+**       system calls.
+**   15. While science data is being collected a configuration change is
+**       staged in PendingConfig and applied when the next file is created
+**       so the current file keeps the configuration it was created with,
+**       including its images per file, and no images are lost. The next
+**       file isn't pre-opened while a configuration is pending. A staged
+**       configuration is applied immediately when collection stops.
+**   16. The configuration's SCI_ROI region of interest selects the rows and
+**       pixels that are stored. It's applied before a row is encoded so
+**       record CRCs, codec statistics and the catalog cover the stored
+**       data. A record's Length is the stored row length, its RowIdx is
+**       the detector's readout row, and the first and last row flags mark
+**       the first and last rows that the ROI keeps. The binary header
+**       records the ROI and so does the text header, see note 17. The
+**       bytes that aren't stored are counted in RoiSavedByteCnt.
+**   17. A text file with a full ROI only contains rows so its layout is
+**       unchanged. Any other ROI starts the file with a one line header
+**       that records the file's first image ID, the detector geometry and
+**       the ROI's window, step and binning parameters as key=value pairs
+**       so a reader can place the stored pixels. The line starts with
+**       SCI_FILE_TEXT_HDR_ID which can't be mistaken for a row because
+**       rows are pixel digits.
 **
 **  References:
 **    1. OpenSatKit Object-based Application Developer's Guide
@@ -35,6 +145,12 @@
 
 #include "app_cfg.h"
 #include "pl_sim_lib.h"  /* See prologue notes */
+#include "sci_codec.h"
+#include "sci_catalog.h"
+#include "sci_crc.h"
+#include "sci_mmap.h"
+#include "sci_roi.h"
+#include "sci_sync.h"
 
 /***********************/
 /** Macro Definitions **/
@@ -49,6 +165,36 @@
 #define SCI_FILE_WRITE_ERR_EID   (SCI_FILE_BASE_EID + 2)
 #define SCI_FILE_CLOSE_EID       (SCI_FILE_BASE_EID + 3)
 #define SCI_FILE_STOP_SCI_EID    (SCI_FILE_BASE_EID + 4)
+#define SCI_FILE_CONSTRUCTOR_EID (SCI_FILE_BASE_EID + 5)
+#define SCI_FILE_CONFIG_CMD_EID  (SCI_FILE_BASE_EID + 6)
+#define SCI_FILE_RENAME_ERR_EID  (SCI_FILE_BASE_EID + 7)
+#define SCI_FILE_RESUME_EID      (SCI_FILE_BASE_EID + 8)
+#define SCI_FILE_RESUME_ERR_EID  (SCI_FILE_BASE_EID + 9)
+
+/*
+** Binary file format definitions. See prologue notes.
+*/
+
+#define SCI_FILE_ROW_LEN  (sizeof(((PL_SIM_LIB_DetectorRow_t *)0)->Data))
+
+#define SCI_FILE_BIN_VERSION       4
+#define SCI_FILE_BIN_HDR_SYNC      0x504C5348  /* "PLSH" */
+#define SCI_FILE_BIN_REC_SYNC      0x504C5352  /* "PLSR" */
+#define SCI_FILE_BIN_TRL_SYNC      0x504C5354  /* "PLST" */
+
+#define SCI_FILE_BIN_REC_FIRST_ROW 0x0001
+#define SCI_FILE_BIN_REC_LAST_ROW  0x0002
+#define SCI_FILE_BIN_REC_ENCODED   0x0004
+
+#define SCI_FILE_BIN_REC_LEN  (sizeof(SCI_FILE_BinRecordHdr_t) + SCI_FILE_ROW_LEN)
+
+/*
+** Text file format definitions. SCI_FILE_TEXT_HDR_LEN is the maximum header
+** line length. See prologue notes.
+*/
+
+#define SCI_FILE_TEXT_HDR_ID   "#PL_MGR"
+#define SCI_FILE_TEXT_HDR_LEN  256
 
 /**********************/
 /** Type Definitions **/
@@ -68,6 +214,15 @@ typedef enum
 } SCI_FILE_State_t;
 
 
+typedef enum
+{
+
+   SCI_FILE_SINK_OSAL  = 1,
+   SCI_FILE_SINK_MMAP  = 2
+
+} SCI_FILE_Sink_t;
+
+
 typedef enum
 {
 
@@ -79,6 +234,208 @@ typedef enum
 } SCI_FILE_Control_t;
 
 
+/*
+** Binary file format structures. Each record header is followed by
+** Length bytes of detector data. The Roi fields are the file's
+** region of interest, see sci_roi.h.
+*/
+
+typedef struct
+{
+
+   uint32  Sync;
+   uint16  Version;
+   uint16  HeaderLen;
+   uint16  RecordLen;
+   uint16  RowLen;
+   uint16  RowsPerImage;
+   uint16  ImagesPerFile;
+   uint16  FirstImageId;
+   uint16  Codec;
+   uint32  StartSeconds;
+   uint32  StartSubseconds;
+   uint16  RoiFirstRow;
+   uint16  RoiRowCnt;
+   uint16  RoiRowStep;
+   uint16  RoiFirstCol;
+   uint16  RoiColCnt;
+   uint16  RoiColStep;
+   uint16  RoiColBin;
+   uint16  Spare;
+
+} SCI_FILE_BinHeader_t;
+
+typedef struct
+{
+
+   uint32  Sync;
+   uint16  ImageId;
+   uint16  RowIdx;
+   uint16  Length;
+   uint16  Flags;
+   uint32  Crc;        /* CRC of this record's data         */
+   uint32  ImageCrc;   /* Rolling CRC of the image's records */
+
+} SCI_FILE_BinRecordHdr_t;
+
+typedef struct
+{
+
+   uint32  Sync;
+   uint32  RecordCnt;
+   uint16  ImageCnt;
+   uint16  Spare;
+   uint32  StopSeconds;
+   uint32  StopSubseconds;
+
+} SCI_FILE_BinTrailer_t;
+
+
+/*
+** A binary record header, a pointer to its data bytes and the time taken
+** to encode them. See prologue notes.
+*/
+
+typedef struct
+{
+
+   SCI_FILE_BinRecordHdr_t  Hdr;
+   const uint8             *Data;
+   uint32                   CodecUsec;
+
+} SCI_FILE_BinRecord_t;
+
+
+/*
+** Codec state used to encode consecutive rows. CodecBuf holds the previous
+** row followed by the row being encoded.
+*/
+
+typedef struct
+{
+
+   bool    PrevRowValid;
+   uint16  PrevImageId;
+   uint16  PrevRowIdx;
+   uint32  PrevRowLen;
+   uint8   CodecBuf[2*SCI_FILE_ROW_LEN];
+
+} SCI_FILE_Encoder_t;
+
+
+/*
+** An image's binary records built by SCI_FILE_EncodeImage(). Record data
+** points to EncodeBuf or to the caller's unencoded row and it's NULL for
+** rows that Roi doesn't keep. RecordCnt is zero if no records were built.
+*/
+
+typedef struct
+{
+
+   uint16  FileFormat;
+   uint16  Codec;
+   uint16  RecordCnt;
+   PL_MGR_SciRoi_t  Roi;
+
+   SCI_FILE_BinRecord_t  Record[PL_SIM_LIB_DETECTOR_ROWS_PER_IMAGE];
+   uint8                 EncodeBuf[PL_SIM_LIB_DETECTOR_ROWS_PER_IMAGE][SCI_FILE_ROW_LEN];
+
+} SCI_FILE_EncodedImage_t;
+
+
+/*
+** A file slot holds an open file and the configuration that was used to
+** create it. See prologue notes.
+*/
+
+typedef struct
+{
+
+   bool              IsOpen;
+   bool              Finished;  /* File complete, add it to the catalog when closed */
+   uint16            ImageId;   /* ID of the first image, used in the filename */
+   osal_id_t         Handle;
+   int               SyncFd;    /* SCI_SYNC descriptor for Handle's file */
+   SCI_MMAP_Class_t  MmapSink;
+   char              Name[OS_MAX_PATH_LEN];
+   char              TmpName[OS_MAX_PATH_LEN];   /* Name used until the file is closed */
+
+   PL_MGR_ConfigSciFile_Payload_t Config;
+   PL_MGR_CatalogEntry_t          Catalog;   /* See prologue notes */
+
+} SCI_FILE_Slot_t;
+
+
+/*
+** Checkpoints are saved in a Critical Data Store block. See prologue notes.
+** A slot's Catalog entry holds the file's length and CRC.
+*/
+
+typedef struct
+{
+
+   bool    IsOpen;
+   uint16  ImageId;
+   char    Name[OS_MAX_PATH_LEN];
+   char    TmpName[OS_MAX_PATH_LEN];
+
+   PL_MGR_ConfigSciFile_Payload_t Config;
+   PL_MGR_CatalogEntry_t          Catalog;
+
+} SCI_FILE_SlotCheckpoint_t;
+
+typedef struct
+{
+
+   uint16  State;
+   uint16  ImageCnt;
+   uint32  RecordCnt;
+   uint32  LastImageCrc;
+   uint32  RawByteCnt;
+   uint32  EncodedByteCnt;
+   uint32  CodecUsec;
+   uint16  SyncImageCnt;
+   uint16  ConfigPending;
+
+   SCI_FILE_SlotCheckpoint_t  File;
+   SCI_FILE_SlotCheckpoint_t  ClosingFile;   /* Finished file waiting for close */
+   char                       NextTmpName[OS_MAX_PATH_LEN];  /* Pre-opened file, deleted on restore */
+
+   PL_MGR_ConfigSciFile_Payload_t Config;
+   PL_MGR_ConfigSciFile_Payload_t PendingConfig;
+
+} SCI_FILE_Checkpoint_t;
+
+
+/*
+** Status snapshot read by the PL_MGR main task. See prologue notes.
+*/
+
+typedef struct
+{
+
+   SCI_FILE_State_t  State;
+   bool              FileOpen;
+   bool              ConfigPending;
+   uint16            ImageCnt;
+   uint16            InfoChangeCnt;
+   uint16            CompRatio;       /* Current file's compression ratio times 100 */
+   uint16            SyncCnt;
+   uint32            CodecUsec;
+   uint32            LastImageCrc;
+   uint32            RoiSavedByteCnt;
+
+} SCI_FILE_Status_t;
+
+typedef struct
+{
+
+   SCI_FILE_Status_t             Status;
+   PL_MGR_FileInfoTlm_Payload_t  FileInfo;
+
+} SCI_FILE_Snapshot_t;
+
+
 /******************************************************************************
 ** Command Packets
 ** - See EDS command definitions in pl_mgr.xml
@@ -91,14 +448,78 @@ typedef enum
 typedef struct
 {
 
+   osal_id_t         MutexId;
+   SCI_FILE_Sink_t   Sink;
+   uint16            Channel;
+   
    bool              CreateNewFile;
-   uint32            Handle;
-   bool              IsOpen;
+   bool              CreateEventPending;
+   bool              NextFileAttempted;
+   bool              WaitForImage;    /* Drop rows until an image's first row */
    SCI_FILE_State_t  State;
    uint16            ImageCnt;
-   char Name[OS_MAX_PATH_LEN];
-
+   uint16            InfoChangeCnt;   /* See prologue notes */
+   uint32            RecordCnt;
+   uint32            ImageCrc;       /* Rolling CRC of the current image   */
+   uint32            LastImageCrc;   /* CRC of the last completed image    */
+   
+   /*
+   ** Current file's sync state. See prologue notes.
+   */
+   
+   bool              SyncPending;
+   uint16            SyncImageCnt;   /* Images since the last sync */
+   OS_time_t         SyncTime;       /* Time of the last sync      */
+   uint16            SyncCnt;        /* Syncs of all files         */
+   
+   uint32            RoiSavedByteCnt; /* Row bytes not stored due to the ROI, see prologue notes */
+   
+   /*
+   ** Current file's codec statistics
+   */
+   
+   uint32            RawByteCnt;
+   uint32            EncodedByteCnt;
+   uint32            CodecUsec;
+
+   SCI_FILE_Slot_t   File;          /* Current file                    */
+   SCI_FILE_Slot_t   NextFile;      /* Pre-opened next file            */
+   SCI_FILE_Slot_t   ClosingFile;   /* Previous file waiting for close */
+
+   bool                           ConfigPending;
    PL_MGR_ConfigSciFile_Payload_t Config;
+   PL_MGR_ConfigSciFile_Payload_t PendingConfig;   /* See prologue notes */
+
+   /*
+   ** Critical Data Store checkpoint. See prologue notes.
+   */
+   
+   bool                   CdsValid;
+   CFE_ES_CDSHandle_t     CdsHandle;
+   SCI_FILE_Checkpoint_t  Checkpoint;
+
+   /*
+   ** Write staging buffer. See prologue notes.
+   */
+   
+   uint32  FlushThreshold;
+   uint32  WriteBufLen;
+   uint8   WriteBuf[SCI_FILE_WRITE_BUF_LEN];
+
+   /*
+   ** Codec buffers. See prologue notes.
+   */
+   
+   SCI_FILE_Encoder_t  Encoder;
+   uint8               EncodeBuf[SCI_FILE_ROW_LEN];
+
+   /*
+   ** Published status. Snapshot[SnapshotSeq & 1] is the current snapshot
+   ** and the other one is updated by the next publish. See prologue notes.
+   */
+   
+   uint32               SnapshotSeq;
+   SCI_FILE_Snapshot_t  Snapshot[2];
 
 } SCI_FILE_Class_t;
 
@@ -116,9 +537,12 @@ typedef struct
 **   1. This must be called prior to any other function.
 **   2. The table values are not populated. This is done when the table is 
 **      registered with the table manager.
+**   3. Collection is resumed if a checkpoint is restored from the Critical
+**      Data Store. The SCI_CATALOG and SCI_RETAIN objects must be
+**      constructed prior to this call. See prologue notes.
 **
 */
-void SCI_FILE_Constructor(SCI_FILE_Class_t *SciFilePtr, INITBL_Class_t *IniTbl);
+void SCI_FILE_Constructor(SCI_FILE_Class_t *SciFile, INITBL_Class_t *IniTbl, uint16 Channel);
 
 
 /******************************************************************************
@@ -131,7 +555,20 @@ void SCI_FILE_Constructor(SCI_FILE_Class_t *SciFilePtr, INITBL_Class_t *IniTbl);
 **      change the functional behavior should be reset.
 **
 */
-void SCI_FILE_ResetStatus(void);
+void SCI_FILE_ResetStatus(SCI_FILE_Class_t *SciFile);
+
+
+/******************************************************************************
+** Function: SCI_FILE_ManageFiles
+**
+** Perform file management that has been deferred from the detector data path
+**
+** Notes:
+**   1. This should be called when there's no detector data waiting to be
+**      written. See prologue notes.
+**
+*/
+void SCI_FILE_ManageFiles(SCI_FILE_Class_t *SciFile);
 
 
 /******************************************************************************
@@ -139,20 +576,117 @@ void SCI_FILE_ResetStatus(void);
 **
 ** Write detector data to a file
 **
+** Notes:
+**   1. RowFault is true if the row failed the detector data check. It's
+**      recorded in the file's catalog entry.
+**
+*/
+void SCI_FILE_WriteDetectorData(SCI_FILE_Class_t *SciFile, const PL_SIM_LIB_Detector_t *Detector, SCI_FILE_Control_t Control,
+                                bool RowFault);
+
+
+/******************************************************************************
+** Function: SCI_FILE_WriteImage
+**
+** Write an image's detector rows to a file
+**
+** Notes:
+**   1. EncodedImage holds the records built by SCI_FILE_EncodeImage() for
+**      Row. See prologue notes for when they're used.
+**   2. Each row is written as if it were passed to
+**      SCI_FILE_WriteDetectorData() with SCI_FILE_GetRowControl()'s control.
+**   3. ImageFault is true if any of the image's rows failed the detector
+**      data check.
+**
 */
-void SCI_FILE_WriteDetectorData(PL_SIM_LIB_Detector_t *Detector, SCI_FILE_Control_t Control);
+void SCI_FILE_WriteImage(SCI_FILE_Class_t *SciFile, const PL_SIM_LIB_Detector_t *Row, uint16 RowCnt,
+                         const SCI_FILE_EncodedImage_t *EncodedImage, bool ImageFault);
 
 
 /******************************************************************************
-** Functions: SCI_FILE_ConfigCmd
+** Function: SCI_FILE_EncodeImage
+**
+** Build the binary records for an image's detector rows
+**
+** Notes:
+**   1. Only reads SciFile's configuration so it can be called from any
+**      task. Encoder is owned by the caller.
+**   2. No records are built if the current file, or the next file when no
+**      file is open, isn't binary or Row doesn't start with the image's
+**      first row. See prologue notes.
+**
+*/
+void SCI_FILE_EncodeImage(SCI_FILE_Class_t *SciFile, SCI_FILE_Encoder_t *Encoder,
+                          const PL_SIM_LIB_Detector_t *Row, uint16 RowCnt,
+                          SCI_FILE_EncodedImage_t *EncodedImage);
+
+
+/******************************************************************************
+** Function: SCI_FILE_GetRowControl
+**
+** Return the control for a detector row based on its readout row
+**
+*/
+SCI_FILE_Control_t SCI_FILE_GetRowControl(const PL_SIM_LIB_Detector_t *Detector);
+
+
+/******************************************************************************
+** Functions: SCI_FILE_Config
 **
 ** Set configuration parameters for managing science files 
 **
 ** Notes:
-**  1. This function must comply with the CMDMGR_CmdFuncPtr definition
+**  1. Returns false if the file format, codec or sync policy is invalid.
+**  2. The configuration is staged while science data is being collected
+**     and applied when the next file is created. See prologue notes.
+**
+*/
+bool SCI_FILE_Config(SCI_FILE_Class_t *SciFile, const PL_MGR_ConfigSciFile_Payload_t *ConfigCmd);
+
+
+/******************************************************************************
+** Functions: SCI_FILE_ValidConfig
+**
+** Return true if a configuration can be passed to SCI_FILE_Config()
+**
+** Notes:
+**   1. An error event is sent for an invalid configuration. It only reads
+**      the configuration so it can be called from any task.
+**   2. ImagesPerFile must be non-zero and a file's name must fit in
+**      OS_MAX_PATH_LEN with its longest image ID, unique name suffix and
+**      temporary extension.
+**
+*/
+bool SCI_FILE_ValidConfig(const PL_MGR_ConfigSciFile_Payload_t *ConfigCmd);
+
+
+/******************************************************************************
+** Functions: SCI_FILE_GetStatus
+**
+** Copy the last published status snapshot
+**
+** Notes:
+**   1. The mutex isn't used so it can be called from any task without
+**      waiting for file I/O. See prologue notes.
+**   2. CompRatio is unencoded bytes divided by file bytes for the rows
+**      that have been written. It's 100 if no rows have been written.
+**
+*/
+void SCI_FILE_GetStatus(SCI_FILE_Class_t *SciFile, SCI_FILE_Status_t *Status);
+
+
+/******************************************************************************
+** Functions: SCI_FILE_GetFileInfo
+**
+** Load the file information telemetry payload from the last published
+** snapshot
+**
+** Notes:
+**   1. Returns the InfoChangeCnt that the payload represents.
+**   2. The mutex isn't used, see SCI_FILE_GetStatus().
 **
 */
-bool SCI_FILE_ConfigCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
+uint16 SCI_FILE_GetFileInfo(SCI_FILE_Class_t *SciFile, PL_MGR_FileInfoTlm_Payload_t *FileInfo);
 
 
 /******************************************************************************
@@ -164,7 +698,7 @@ bool SCI_FILE_ConfigCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
 **   None
 **
 */
-bool SCI_FILE_Start(void);
+bool SCI_FILE_Start(SCI_FILE_Class_t *SciFile);
 
 
 /******************************************************************************
@@ -176,7 +710,7 @@ bool SCI_FILE_Start(void);
 **   None
 **
 */
-bool SCI_FILE_Stop(char *EventStr, uint16 MaxStrLen);
+bool SCI_FILE_Stop(SCI_FILE_Class_t *SciFile, char *EventStr, uint16 MaxStrLen);
 
 
 #endif /* _sci_file_ */
@@ -0,0 +1,336 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the memory mapped science file sink
+**
+**  Notes:
+**    1. posix_fallocate() is used to reserve the file's storage so the file
+**       doesn't fragment as it's filled. If the file system doesn't support
+**       it (EOPNOTSUPP or EINVAL) ftruncate() is used to size the file. Any
+**       other error, such as ENOSPC, fails the open. posix_fallocate()
+**       returns its error rather than setting errno.
+**    2. msync() requires a page aligned address so the sync region starts
+**       on the page containing the first unsynced byte.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+
+#include "app_cfg.h"
+#include "sci_mmap.h"
+
+#if (PL_MGR_SCI_FILE_MMAP != 0)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool MapFile(SCI_MMAP_Class_t *Sink, const char *Filename, uint32 MapLen, int OpenFlags);
+
+
+/******************************************************************************
+** Function: SCI_MMAP_Open
+**
+*/
+bool SCI_MMAP_Open(SCI_MMAP_Class_t *Sink, const char *Filename, uint32 MapLen)
+{
+
+   return MapFile(Sink, Filename, MapLen, O_RDWR | O_CREAT | O_TRUNC);
+
+} /* End SCI_MMAP_Open() */
+
+
+/******************************************************************************
+** Function: SCI_MMAP_Resume
+**
+*/
+bool SCI_MMAP_Resume(SCI_MMAP_Class_t *Sink, const char *Filename, uint32 MapLen, uint32 Offset)
+{
+
+   bool RetStatus = false;
+
+   if (Offset <= MapLen)
+   {
+      if (MapFile(Sink, Filename, MapLen, O_RDWR))
+      {
+         Sink->Offset     = Offset;
+         Sink->SyncOffset = Offset;
+         RetStatus = true;
+      }
+   }
+   else
+   {
+      CFE_EVS_SendEvent (SCI_MMAP_OPEN_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "Memory mapped file resume offset %d exceeds the %d byte allocation for %s",
+                         Offset, MapLen, Filename);
+   }
+
+   return RetStatus;
+
+} /* End SCI_MMAP_Resume() */
+
+
+/******************************************************************************
+** Function: SCI_MMAP_Write
+**
+*/
+bool SCI_MMAP_Write(SCI_MMAP_Class_t *Sink, const void *Data, uint32 DataLen)
+{
+
+   bool RetStatus = false;
+
+   if (Sink->IsOpen)
+   {
+      if ((Sink->Offset + DataLen) <= Sink->MapLen)
+      {
+         memcpy(&Sink->Addr[Sink->Offset], Data, DataLen);
+         Sink->Offset += DataLen;
+         RetStatus = true;
+      }
+      else
+      {
+         CFE_EVS_SendEvent (SCI_MMAP_WRITE_ERR_EID, CFE_EVS_EventType_ERROR,
+                            "Memory mapped file write of %d bytes exceeds the %d byte allocation",
+                            DataLen, Sink->MapLen);
+      }
+   }
+
+   return RetStatus;
+
+} /* End SCI_MMAP_Write() */
+
+
+/******************************************************************************
+** Function: SCI_MMAP_Sync
+**
+*/
+bool SCI_MMAP_Sync(SCI_MMAP_Class_t *Sink)
+{
+
+   bool   RetStatus = true;
+   uint32 PageMask  = (uint32)sysconf(_SC_PAGESIZE) - 1;
+   uint32 SyncStart;
+
+   if (Sink->IsOpen && Sink->Addr != NULL && (Sink->Offset > Sink->SyncOffset))
+   {
+
+      SyncStart = Sink->SyncOffset & ~PageMask;
+
+      if (msync(&Sink->Addr[SyncStart], Sink->Offset - SyncStart, MS_ASYNC) == 0)
+      {
+         Sink->SyncOffset = Sink->Offset;
+      }
+      else
+      {
+         CFE_EVS_SendEvent (SCI_MMAP_SYNC_ERR_EID, CFE_EVS_EventType_ERROR,
+                            "Memory mapped file sync failed, %s", strerror(errno));
+         RetStatus = false;
+      }
+   }
+
+   return RetStatus;
+
+} /* End SCI_MMAP_Sync() */
+
+
+/******************************************************************************
+** Function: SCI_MMAP_Unmap
+**
+*/
+void SCI_MMAP_Unmap(SCI_MMAP_Class_t *Sink)
+{
+
+   if (Sink->IsOpen && Sink->Addr != NULL)
+   {
+
+      munmap(Sink->Addr, Sink->MapLen);
+
+      if (ftruncate(Sink->Fd, Sink->Offset) != 0)
+      {
+         CFE_EVS_SendEvent (SCI_MMAP_CLOSE_ERR_EID, CFE_EVS_EventType_ERROR,
+                            "Memory mapped file truncate to %d bytes failed, %s",
+                            Sink->Offset, strerror(errno));
+      }
+
+      Sink->Addr   = NULL;
+      Sink->MapLen = 0;
+
+   }
+
+} /* End SCI_MMAP_Unmap() */
+
+
+/******************************************************************************
+** Function: SCI_MMAP_Close
+**
+*/
+void SCI_MMAP_Close(SCI_MMAP_Class_t *Sink)
+{
+
+   if (Sink->IsOpen)
+   {
+
+      SCI_MMAP_Unmap(Sink);
+      close(Sink->Fd);
+
+      Sink->IsOpen = false;
+      Sink->Fd     = -1;
+
+   }
+
+} /* End SCI_MMAP_Close() */
+
+
+/******************************************************************************
+** Function: MapFile
+**
+** Open, preallocate and map a file using the open() flags.
+**
+*/
+static bool MapFile(SCI_MMAP_Class_t *Sink, const char *Filename, uint32 MapLen, int OpenFlags)
+{
+
+   char  LocalPath[OS_MAX_LOCAL_PATH_LEN];
+   int   SysStatus;
+   void *Addr;
+
+   memset(Sink, 0, sizeof(SCI_MMAP_Class_t));
+   Sink->Fd = -1;
+
+   if (OS_TranslatePath(Filename, LocalPath) == OS_SUCCESS)
+   {
+   
+      Sink->Fd = open(LocalPath, OpenFlags, 0644);
+      
+      if (Sink->Fd >= 0)
+      {
+      
+         SysStatus = posix_fallocate(Sink->Fd, 0, MapLen);
+         if (SysStatus == EOPNOTSUPP || SysStatus == EINVAL)
+         {
+            SysStatus = (ftruncate(Sink->Fd, MapLen) == 0) ? 0 : errno;
+         }
+
+         if (SysStatus == 0)
+         {
+
+            Addr = mmap(NULL, MapLen, PROT_READ | PROT_WRITE, MAP_SHARED, Sink->Fd, 0);
+
+            if (Addr != MAP_FAILED)
+            {
+               Sink->Addr   = (uint8 *)Addr;
+               Sink->MapLen = MapLen;
+               Sink->IsOpen = true;
+            }
+            else
+            {
+               SysStatus = errno;
+            }
+         }
+
+         if (!Sink->IsOpen)
+         {
+            CFE_EVS_SendEvent (SCI_MMAP_OPEN_ERR_EID, CFE_EVS_EventType_ERROR,
+                               "Memory mapped file allocation of %d bytes failed for %s, %s",
+                               MapLen, LocalPath, strerror(SysStatus));
+            close(Sink->Fd);
+            Sink->Fd = -1;
+         }
+      }
+      else
+      {
+         CFE_EVS_SendEvent (SCI_MMAP_OPEN_ERR_EID, CFE_EVS_EventType_ERROR,
+                            "Memory mapped file open failed for %s, %s", LocalPath, strerror(errno));
+      }
+   }
+   else
+   {
+      CFE_EVS_SendEvent (SCI_MMAP_OPEN_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "Memory mapped file open failed, can't translate %s", Filename);
+   }
+
+   return Sink->IsOpen;
+
+} /* End MapFile() */
+
+
+#else /* Memory mapped sink not supported */
+
+
+/******************************************************************************
+** Function: SCI_MMAP_Open
+**
+*/
+bool SCI_MMAP_Open(SCI_MMAP_Class_t *Sink, const char *Filename, uint32 MapLen)
+{
+
+   memset(Sink, 0, sizeof(SCI_MMAP_Class_t));
+
+   CFE_EVS_SendEvent (SCI_MMAP_OPEN_ERR_EID, CFE_EVS_EventType_ERROR,
+                      "Memory mapped files are not supported on this platform");
+
+   return false;
+
+} /* End SCI_MMAP_Open() */
+
+
+/******************************************************************************
+** Functions: SCI_MMAP_Resume, SCI_MMAP_Write, SCI_MMAP_Sync, SCI_MMAP_Unmap,
+**            SCI_MMAP_Close
+**
+** Notes:
+**   1. A sink can't be opened so these have nothing to do.
+**
+*/
+bool SCI_MMAP_Resume(SCI_MMAP_Class_t *Sink, const char *Filename, uint32 MapLen, uint32 Offset)
+{
+   memset(Sink, 0, sizeof(SCI_MMAP_Class_t));
+   return false;
+}
+
+bool SCI_MMAP_Write(SCI_MMAP_Class_t *Sink, const void *Data, uint32 DataLen)
+{
+   return false;
+}
+
+bool SCI_MMAP_Sync(SCI_MMAP_Class_t *Sink)
+{
+   return false;
+}
+
+void SCI_MMAP_Unmap(SCI_MMAP_Class_t *Sink)
+{
+}
+
+void SCI_MMAP_Close(SCI_MMAP_Class_t *Sink)
+{
+}
+
+
+#endif /* PL_MGR_SCI_FILE_MMAP */
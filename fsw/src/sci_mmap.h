@@ -0,0 +1,161 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the memory mapped science file sink
+**
+**  Notes:
+**    1. A sink file is preallocated to its maximum size when it's opened
+**       and data is copied into the mapped region so no system call is
+**       made for each write. When the file is closed it's truncated to the
+**       number of bytes written.
+**    2. Unlike the other PL_MGR objects a sink isn't a singleton. The owner
+**       passes the sink instance to each function.
+**    3. This is only supported when PL_MGR_SCI_FILE_MMAP is defined as
+**       non-zero in the platform configuration file. Otherwise
+**       SCI_MMAP_Open() always fails.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _sci_mmap_
+#define _sci_mmap_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+/*
+** Event Message IDs
+*/
+
+#define SCI_MMAP_OPEN_ERR_EID   (SCI_MMAP_BASE_EID + 0)
+#define SCI_MMAP_WRITE_ERR_EID  (SCI_MMAP_BASE_EID + 1)
+#define SCI_MMAP_SYNC_ERR_EID   (SCI_MMAP_BASE_EID + 2)
+#define SCI_MMAP_CLOSE_ERR_EID  (SCI_MMAP_BASE_EID + 3)
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** SCI_MMAP_Class
+*/
+
+typedef struct
+{
+
+   bool    IsOpen;
+   int     Fd;
+   uint8  *Addr;
+   uint32  MapLen;
+   uint32  Offset;       /* Number of bytes written */
+   uint32  SyncOffset;   /* Bytes prior to this offset have been synced */
+
+} SCI_MMAP_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SCI_MMAP_Open
+**
+** Create, preallocate and map a file.
+**
+** Notes:
+**   1. Filename is an OSAL virtual path.
+**   2. An existing file is truncated.
+**
+*/
+bool SCI_MMAP_Open(SCI_MMAP_Class_t *Sink, const char *Filename, uint32 MapLen);
+
+
+/******************************************************************************
+** Function: SCI_MMAP_Resume
+**
+** Preallocate and map an existing file and continue writing it at Offset.
+**
+** Notes:
+**   1. Filename is an OSAL virtual path.
+**   2. Data after Offset is overwritten by the following writes and
+**      discarded when the file is closed.
+**
+*/
+bool SCI_MMAP_Resume(SCI_MMAP_Class_t *Sink, const char *Filename, uint32 MapLen, uint32 Offset);
+
+
+/******************************************************************************
+** Function: SCI_MMAP_Write
+**
+** Copy data into the mapped file.
+**
+** Notes:
+**   1. Returns false and nothing is written if the data doesn't fit in the
+**      remaining preallocated space.
+**
+*/
+bool SCI_MMAP_Write(SCI_MMAP_Class_t *Sink, const void *Data, uint32 DataLen);
+
+
+/******************************************************************************
+** Function: SCI_MMAP_Sync
+**
+** Schedule the data written since the last sync to be written to storage.
+**
+** Notes:
+**   1. This doesn't wait for the write to complete.
+**
+*/
+bool SCI_MMAP_Sync(SCI_MMAP_Class_t *Sink);
+
+
+/******************************************************************************
+** Function: SCI_MMAP_Unmap
+**
+** Unmap the file and truncate it to the number of bytes written.
+**
+** Notes:
+**   1. The file stays open so it can be synced through the sink's
+**      descriptor before it's closed. Nothing can be written after it's
+**      unmapped.
+**
+*/
+void SCI_MMAP_Unmap(SCI_MMAP_Class_t *Sink);
+
+
+/******************************************************************************
+** Function: SCI_MMAP_Close
+**
+** Unmap the file, truncate it to the number of bytes written and close it.
+**
+** Notes:
+**   1. The file isn't unmapped again if SCI_MMAP_Unmap() was called.
+**
+*/
+void SCI_MMAP_Close(SCI_MMAP_Class_t *Sink);
+
+
+#endif /* _sci_mmap_ */
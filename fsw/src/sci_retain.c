@@ -0,0 +1,742 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the science file retention object
+**
+**  Notes:
+**    1. Files are deleted after the mutex is released so the file system
+**       operations don't block the other SCI_WRITER tasks.
+**    2. Table entry i is retention file slot i. An unused entry is written
+**       with a zero sequence number so it isn't restored.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+
+#include "app_cfg.h"
+#include "sci_retain.h"
+#include "sci_catalog.h"
+#include "sci_crc.h"
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static SCI_RETAIN_Class_t *SciRetain = NULL;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static bool AddRecord(const PL_MGR_CatalogEntry_t *Entry);
+static bool CreateRetainFile(void);
+static void DeleteFile(const SCI_RETAIN_File_t *File);
+static bool EvictBefore(const SCI_RETAIN_File_t *File, const SCI_RETAIN_File_t *Candidate);
+static int32 FindFile(const char *Filename);
+static bool LoadRetainFile(void);
+static bool OverQuota(void);
+static uint32 RecordOffset(uint16 Idx);
+static void RemoveRecord(uint16 Idx, SCI_RETAIN_File_t *File);
+static uint16 SelectEvictFile(void);
+static bool ValidFileQuota(uint16 FileQuota);
+static bool ValidPolicy(uint16 Policy);
+static bool ValidRecord(const SCI_RETAIN_FileRecord_t *Record);
+static void WriteRecord(uint16 Idx);
+
+
+/******************************************************************************
+** Function: SCI_RETAIN_Constructor
+**
+*/
+void SCI_RETAIN_Constructor(SCI_RETAIN_Class_t *SciRetainPtr, INITBL_Class_t *IniTbl)
+{
+
+   uint16 Slot;
+   const char *Source = "retention file";
+   PL_MGR_CatalogEntry_t Entry;
+
+   SciRetain = SciRetainPtr;
+
+   CFE_PSP_MemSet((void*)SciRetain, 0, sizeof(SCI_RETAIN_Class_t));
+
+   SCI_CRC_InitTables();
+
+   strncpy(SciRetain->Filename, INITBL_GetStrConfig(IniTbl, CFG_SCI_RETAIN_FILE), OS_MAX_PATH_LEN);
+   SciRetain->Filename[OS_MAX_PATH_LEN-1] = '\0';
+
+   SciRetain->ByteQuota = INITBL_GetIntConfig(IniTbl, CFG_SCI_RETAIN_BYTE_QUOTA);
+
+   SciRetain->FileQuota = INITBL_GetIntConfig(IniTbl, CFG_SCI_RETAIN_FILE_QUOTA);
+   if (!ValidFileQuota(SciRetain->FileQuota))
+   {
+      CFE_EVS_SendEvent (SCI_RETAIN_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR,
+                         "Invalid science file retention file quota %d, must be between 1 and %d. Using %d.",
+                         SciRetain->FileQuota, SCI_RETAIN_FILE_MAX, SCI_RETAIN_FILE_MAX);
+      SciRetain->FileQuota = SCI_RETAIN_FILE_MAX;
+   }
+
+   SciRetain->Policy = INITBL_GetIntConfig(IniTbl, CFG_SCI_RETAIN_POLICY);
+   if (!ValidPolicy(SciRetain->Policy))
+   {
+      CFE_EVS_SendEvent (SCI_RETAIN_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR,
+                         "Invalid science file retention policy %d. Deleting the oldest files first.",
+                         SciRetain->Policy);
+      SciRetain->Policy = PL_MGR_RetainPolicy_OLDEST;
+   }
+
+   if (OS_MutSemCreate(&SciRetain->MutexId, "PL_MGR_RETAIN", 0) != OS_SUCCESS)
+   {
+      CFE_EVS_SendEvent (SCI_RETAIN_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR,
+                         "Science file retention mutex creation failed");
+   }
+
+   if (!LoadRetainFile())
+   {
+
+      Source = "catalog";
+      for (Slot=0; Slot < SCI_CATALOG_ENTRY_CNT; Slot++)
+      {
+         if (SCI_CATALOG_GetEntry(Slot, &Entry))
+         {
+            AddRecord(&Entry);
+         }
+      }
+
+   }
+
+   CFE_EVS_SendEvent (SCI_RETAIN_CONSTRUCTOR_EID, CFE_EVS_EventType_INFORMATION,
+                      "Science file retention restored %d files with %u bytes from the %s",
+                      SciRetain->FileCnt, (unsigned int)SciRetain->ByteCnt, Source);
+
+} /* End SCI_RETAIN_Constructor() */
+
+
+/******************************************************************************
+** Function: SCI_RETAIN_AddFile
+**
+*/
+void SCI_RETAIN_AddFile(const PL_MGR_CatalogEntry_t *Entry)
+{
+
+   bool EvictFile = false;
+   SCI_RETAIN_File_t File;
+
+   OS_MutSemTake(SciRetain->MutexId);
+
+   if (!AddRecord(Entry))
+   {
+      RemoveRecord(SelectEvictFile(), &File);
+      AddRecord(Entry);
+      EvictFile = true;
+   }
+
+   OS_MutSemGive(SciRetain->MutexId);
+
+   if (EvictFile)
+   {
+      DeleteFile(&File);
+   }
+
+} /* End SCI_RETAIN_AddFile() */
+
+
+/******************************************************************************
+** Function: SCI_RETAIN_ConfigCmd
+**
+*/
+bool SCI_RETAIN_ConfigCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   const PL_MGR_ConfigRetain_Payload_t *ConfigCmd = CMDMGR_PAYLOAD_PTR(MsgPtr, PL_MGR_ConfigRetain_t);
+   bool RetStatus = false;
+
+   if (ValidFileQuota(ConfigCmd->FileQuota) && ValidPolicy(ConfigCmd->Policy))
+   {
+
+      OS_MutSemTake(SciRetain->MutexId);
+
+      SciRetain->ByteQuota = ConfigCmd->ByteQuota;
+      SciRetain->FileQuota = ConfigCmd->FileQuota;
+      SciRetain->Policy    = ConfigCmd->Policy;
+
+      OS_MutSemGive(SciRetain->MutexId);
+
+      CFE_EVS_SendEvent (SCI_RETAIN_CONFIG_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                         "Science file retention set to %u bytes, %d files and policy %d",
+                         (unsigned int)ConfigCmd->ByteQuota, ConfigCmd->FileQuota, ConfigCmd->Policy);
+      RetStatus = true;
+
+   }
+   else
+   {
+
+      CFE_EVS_SendEvent (SCI_RETAIN_CONFIG_CMD_EID, CFE_EVS_EventType_ERROR,
+                         "Config science file retention command rejected, invalid file quota %d or policy %d. "
+                         "File quota must be between 1 and %d.",
+                         ConfigCmd->FileQuota, ConfigCmd->Policy, SCI_RETAIN_FILE_MAX);
+
+   }
+
+   return RetStatus;
+
+} /* End SCI_RETAIN_ConfigCmd() */
+
+
+/******************************************************************************
+** Function: SCI_RETAIN_ManageFiles
+**
+*/
+void SCI_RETAIN_ManageFiles(void)
+{
+
+   bool   EvictFile = true;
+   uint16 EvictCnt  = 0;
+   SCI_RETAIN_File_t File;
+
+   while (EvictFile && EvictCnt < SCI_RETAIN_EVICT_LIM)
+   {
+
+      OS_MutSemTake(SciRetain->MutexId);
+
+      EvictFile = OverQuota();
+      if (EvictFile)
+      {
+         RemoveRecord(SelectEvictFile(), &File);
+      }
+
+      OS_MutSemGive(SciRetain->MutexId);
+
+      if (EvictFile)
+      {
+         DeleteFile(&File);
+         EvictCnt++;
+      }
+
+   } /* End evict loop */
+
+} /* End SCI_RETAIN_ManageFiles() */
+
+
+/******************************************************************************
+** Function: SCI_RETAIN_SetFileCmd
+**
+*/
+bool SCI_RETAIN_SetFileCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   const PL_MGR_SetFileRetain_Payload_t *SetFileCmd = CMDMGR_PAYLOAD_PTR(MsgPtr, PL_MGR_SetFileRetain_t);
+   bool   RetStatus = false;
+   bool   Downlinked = (SetFileCmd->Downlinked == APP_C_FW_BooleanUint8_TRUE);
+   bool   Cataloged;
+   int32  Idx;
+   uint32 Seq = 0;
+   char   Filename[OS_MAX_PATH_LEN];
+
+   strncpy(Filename, SetFileCmd->Filename, OS_MAX_PATH_LEN);
+   Filename[OS_MAX_PATH_LEN-1] = '\0';
+
+   OS_MutSemTake(SciRetain->MutexId);
+
+   Idx = FindFile(Filename);
+   if (Idx >= 0)
+   {
+      SciRetain->File[Idx].Priority   = SetFileCmd->Priority;
+      SciRetain->File[Idx].Downlinked = Downlinked;
+      Seq = SciRetain->File[Idx].Seq;
+      WriteRecord(Idx);
+   }
+
+   OS_MutSemGive(SciRetain->MutexId);
+
+   if (Idx >= 0)
+   {
+
+      Cataloged = SCI_CATALOG_SetRetain(Seq, SetFileCmd->Priority, Downlinked);
+
+      CFE_EVS_SendEvent (SCI_RETAIN_SET_FILE_CMD_EID, CFE_EVS_EventType_INFORMATION,
+                         "Science file %s retention priority set to %d and downlinked to %d%s",
+                         Filename, SetFileCmd->Priority, Downlinked,
+                         Cataloged ? "" : ". The file is no longer in the catalog.");
+      RetStatus = true;
+
+   }
+   else
+   {
+
+      CFE_EVS_SendEvent (SCI_RETAIN_SET_FILE_CMD_EID, CFE_EVS_EventType_ERROR,
+                         "Set science file retention command rejected, %s is not a retained file",
+                         Filename);
+
+   }
+
+   return RetStatus;
+
+} /* End SCI_RETAIN_SetFileCmd() */
+
+
+/******************************************************************************
+** Function: AddRecord
+**
+** Add a file to the file table
+**
+** Notes:
+**   1. The caller must hold the mutex.
+**   2. Returns false if the table is full.
+**
+*/
+static bool AddRecord(const PL_MGR_CatalogEntry_t *Entry)
+{
+
+   bool   RetStatus = false;
+   uint16 Idx = 0;
+   SCI_RETAIN_File_t *File;
+
+   while (Idx < SCI_RETAIN_FILE_MAX && !RetStatus)
+   {
+
+      File = &SciRetain->File[Idx];
+
+      if (File->Seq == 0)
+      {
+
+         File->Seq        = Entry->Seq;
+         File->FileLen    = Entry->FileLen;
+         File->Priority   = Entry->Priority;
+         File->Downlinked = ((Entry->Flags & SCI_CATALOG_FILE_DOWNLINKED) != 0);
+         strncpy(File->Filename, Entry->Filename, OS_MAX_PATH_LEN);
+         File->Filename[OS_MAX_PATH_LEN-1] = '\0';
+
+         SciRetain->FileCnt++;
+         SciRetain->ByteCnt += File->FileLen;
+         WriteRecord(Idx);
+         RetStatus = true;
+
+      }
+      else
+      {
+         Idx++;
+      }
+
+   } /* End table loop */
+
+   return RetStatus;
+
+} /* End AddRecord() */
+
+
+/******************************************************************************
+** Function: CreateRetainFile
+**
+** Create a retention file with unused slots
+**
+** Notes:
+**   1. Unwritten slots read as zero so they're unused. See prologue notes.
+**
+*/
+static bool CreateRetainFile(void)
+{
+
+   int32 SysStatus;
+   SCI_RETAIN_FileHeader_t Header;
+
+   if (SciRetain->FileOpen)
+   {
+      OS_close(SciRetain->FileHandle);
+   }
+
+   SysStatus = OS_OpenCreate(&SciRetain->FileHandle, SciRetain->Filename,
+                             OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_READ_WRITE);
+   SciRetain->FileOpen = (SysStatus == OS_SUCCESS);
+
+   if (SciRetain->FileOpen)
+   {
+
+      memset(&Header, 0, sizeof(Header));
+      Header.Sync      = SCI_RETAIN_FILE_SYNC;
+      Header.Version   = SCI_RETAIN_FILE_VERSION;
+      Header.RecordCnt = SCI_RETAIN_FILE_MAX;
+      Header.RecordLen = sizeof(SCI_RETAIN_FileRecord_t);
+
+      if (OS_write(SciRetain->FileHandle, &Header, sizeof(Header)) != sizeof(Header))
+      {
+         SysStatus = OS_ERROR;
+      }
+
+   }
+
+   if (SysStatus != OS_SUCCESS)
+   {
+      CFE_EVS_SendEvent (SCI_RETAIN_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR,
+                         "Error creating science file retention file %s. Status = %d. Retained files won't be saved.",
+                         SciRetain->Filename, SysStatus);
+   }
+
+   return (SysStatus == OS_SUCCESS);
+
+} /* End CreateRetainFile() */
+
+
+/******************************************************************************
+** Function: DeleteFile
+**
+** Delete an evicted file and remove its catalog entry
+**
+*/
+static void DeleteFile(const SCI_RETAIN_File_t *File)
+{
+
+   int32 SysStatus = OS_remove(File->Filename);
+
+   SCI_CATALOG_RemoveFile(File->Seq);
+
+   OS_MutSemTake(SciRetain->MutexId);
+   if (SysStatus == OS_SUCCESS)
+   {
+      SciRetain->EvictCnt++;
+   }
+   else
+   {
+      SciRetain->EvictErrCnt++;
+   }
+   OS_MutSemGive(SciRetain->MutexId);
+
+   if (SysStatus == OS_SUCCESS)
+   {
+      CFE_EVS_SendEvent (SCI_RETAIN_EVICT_EID, CFE_EVS_EventType_INFORMATION,
+                         "Deleted science file %s with %u bytes to stay within the retention quotas",
+                         File->Filename, (unsigned int)File->FileLen);
+   }
+   else
+   {
+      CFE_EVS_SendEvent (SCI_RETAIN_EVICT_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "Error deleting science file %s. Status = %d",
+                         File->Filename, SysStatus);
+   }
+
+} /* End DeleteFile() */
+
+
+/******************************************************************************
+** Function: EvictBefore
+**
+** Return true if File should be deleted before Candidate
+**
+** Notes:
+**   1. The older file is deleted first when the policy's attribute is the
+**      same.
+**
+*/
+static bool EvictBefore(const SCI_RETAIN_File_t *File, const SCI_RETAIN_File_t *Candidate)
+{
+
+   bool RetStatus = (File->Seq < Candidate->Seq);
+
+   if (SciRetain->Policy == PL_MGR_RetainPolicy_DOWNLINKED)
+   {
+      if (File->Downlinked != Candidate->Downlinked)
+      {
+         RetStatus = File->Downlinked;
+      }
+   }
+   else if (SciRetain->Policy == PL_MGR_RetainPolicy_PRIORITY)
+   {
+      if (File->Priority != Candidate->Priority)
+      {
+         RetStatus = (File->Priority < Candidate->Priority);
+      }
+   }
+
+   return RetStatus;
+
+} /* End EvictBefore() */
+
+
+/******************************************************************************
+** Function: FindFile
+**
+** Return a retained file's table index or -1 if it isn't retained
+**
+** Notes:
+**   1. The caller must hold the mutex.
+**
+*/
+static int32 FindFile(const char *Filename)
+{
+
+   int32  RetIdx = -1;
+   uint16 Idx;
+
+   for (Idx=0; Idx < SCI_RETAIN_FILE_MAX && RetIdx < 0; Idx++)
+   {
+      if (SciRetain->File[Idx].Seq != 0 && strcmp(SciRetain->File[Idx].Filename, Filename) == 0)
+      {
+         RetIdx = Idx;
+      }
+   }
+
+   return RetIdx;
+
+} /* End FindFile() */
+
+
+/******************************************************************************
+** Function: LoadRetainFile
+**
+** Open the retention file and load its valid records into the table
+**
+** Notes:
+**   1. Returns false if the file didn't have a valid header. An empty
+**      retention file is created so the table can be restored from the
+**      catalog.
+**   2. If the file can't be opened the table is only kept in memory.
+**
+*/
+static bool LoadRetainFile(void)
+{
+
+   int32  SysStatus;
+   bool   FileValid = false;
+   uint16 Idx;
+   SCI_RETAIN_FileHeader_t Header;
+   SCI_RETAIN_FileRecord_t Record;
+
+   SysStatus = OS_OpenCreate(&SciRetain->FileHandle, SciRetain->Filename, OS_FILE_FLAG_CREATE, OS_READ_WRITE);
+   SciRetain->FileOpen = (SysStatus == OS_SUCCESS);
+
+   if (SciRetain->FileOpen)
+   {
+
+      if (OS_read(SciRetain->FileHandle, &Header, sizeof(Header)) == sizeof(Header))
+      {
+         FileValid = (Header.Sync      == SCI_RETAIN_FILE_SYNC    &&
+                      Header.Version   == SCI_RETAIN_FILE_VERSION &&
+                      Header.RecordCnt == SCI_RETAIN_FILE_MAX     &&
+                      Header.RecordLen == sizeof(SCI_RETAIN_FileRecord_t));
+      }
+
+      if (FileValid)
+      {
+
+         for (Idx=0; Idx < SCI_RETAIN_FILE_MAX; Idx++)
+         {
+            if (OS_read(SciRetain->FileHandle, &Record, sizeof(Record)) == sizeof(Record))
+            {
+               if (ValidRecord(&Record))
+               {
+                  SciRetain->File[Idx] = Record.File;
+                  SciRetain->FileCnt++;
+                  SciRetain->ByteCnt += Record.File.FileLen;
+               }
+            }
+         } /* End record loop */
+
+      }
+      else
+      {
+
+         CreateRetainFile();
+
+      }
+
+   }
+   else
+   {
+
+      CFE_EVS_SendEvent (SCI_RETAIN_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR,
+                         "Error opening science file retention file %s. Status = %d. Retained files won't be saved.",
+                         SciRetain->Filename, SysStatus);
+
+   }
+
+   return FileValid;
+
+} /* End LoadRetainFile() */
+
+
+/******************************************************************************
+** Function: OverQuota
+**
+** Notes:
+**   1. The caller must hold the mutex.
+**
+*/
+static bool OverQuota(void)
+{
+
+   return (SciRetain->FileCnt > 0 &&
+           (SciRetain->FileCnt > SciRetain->FileQuota ||
+            (SciRetain->ByteQuota > 0 && SciRetain->ByteCnt > SciRetain->ByteQuota)));
+
+} /* End OverQuota() */
+
+
+/******************************************************************************
+** Function: RecordOffset
+**
+** Return a table entry's retention file byte offset
+**
+*/
+static uint32 RecordOffset(uint16 Idx)
+{
+
+   return sizeof(SCI_RETAIN_FileHeader_t) + Idx * sizeof(SCI_RETAIN_FileRecord_t);
+
+} /* End RecordOffset() */
+
+
+/******************************************************************************
+** Function: RemoveRecord
+**
+** Remove a file from the file table and return a copy of it
+**
+** Notes:
+**   1. The caller must hold the mutex.
+**
+*/
+static void RemoveRecord(uint16 Idx, SCI_RETAIN_File_t *File)
+{
+
+   *File = SciRetain->File[Idx];
+
+   SciRetain->FileCnt--;
+   SciRetain->ByteCnt -= File->FileLen;
+
+   SciRetain->File[Idx].Seq = 0;
+   WriteRecord(Idx);
+
+} /* End RemoveRecord() */
+
+
+/******************************************************************************
+** Function: SelectEvictFile
+**
+** Return the table index of the next file to be deleted
+**
+** Notes:
+**   1. The caller must hold the mutex and the table must have a file.
+**
+*/
+static uint16 SelectEvictFile(void)
+{
+
+   uint16 EvictIdx = SCI_RETAIN_FILE_MAX;
+   uint16 Idx;
+
+   for (Idx=0; Idx < SCI_RETAIN_FILE_MAX; Idx++)
+   {
+      if (SciRetain->File[Idx].Seq != 0)
+      {
+         if (EvictIdx == SCI_RETAIN_FILE_MAX ||
+             EvictBefore(&SciRetain->File[Idx], &SciRetain->File[EvictIdx]))
+         {
+            EvictIdx = Idx;
+         }
+      }
+   }
+
+   return EvictIdx;
+
+} /* End SelectEvictFile() */
+
+
+/******************************************************************************
+** Function: ValidFileQuota
+**
+*/
+static bool ValidFileQuota(uint16 FileQuota)
+{
+
+   return (FileQuota > 0 && FileQuota <= SCI_RETAIN_FILE_MAX);
+
+} /* End ValidFileQuota() */
+
+
+/******************************************************************************
+** Function: ValidPolicy
+**
+*/
+static bool ValidPolicy(uint16 Policy)
+{
+
+   return (Policy == PL_MGR_RetainPolicy_OLDEST     ||
+           Policy == PL_MGR_RetainPolicy_DOWNLINKED ||
+           Policy == PL_MGR_RetainPolicy_PRIORITY);
+
+} /* End ValidPolicy() */
+
+
+/******************************************************************************
+** Function: ValidRecord
+**
+** Return true if a retention file slot has a retained file
+**
+*/
+static bool ValidRecord(const SCI_RETAIN_FileRecord_t *Record)
+{
+
+   return (Record->File.Seq != 0 &&
+           Record->File.Filename[OS_MAX_PATH_LEN-1] == '\0' &&
+           Record->Crc == SCI_CRC_Update(SCI_CRC_INIT, &Record->File, sizeof(SCI_RETAIN_File_t)));
+
+} /* End ValidRecord() */
+
+
+/******************************************************************************
+** Function: WriteRecord
+**
+** Write a table entry to its retention file slot
+**
+** Notes:
+**   1. The caller must hold the mutex.
+**
+*/
+static void WriteRecord(uint16 Idx)
+{
+
+   bool RetStatus = false;
+   SCI_RETAIN_FileRecord_t Record;
+
+   if (SciRetain->FileOpen)
+   {
+
+      Record.File = SciRetain->File[Idx];
+      Record.Crc  = SCI_CRC_Update(SCI_CRC_INIT, &Record.File, sizeof(SCI_RETAIN_File_t));
+
+      if (OS_lseek(SciRetain->FileHandle, RecordOffset(Idx), OS_SEEK_SET) == (int32)RecordOffset(Idx))
+      {
+         RetStatus = (OS_write(SciRetain->FileHandle, &Record, sizeof(Record)) == sizeof(Record));
+      }
+
+      if (!RetStatus)
+      {
+         SciRetain->WriteErrCnt++;
+         CFE_EVS_SendEvent (SCI_RETAIN_WRITE_ERR_EID, CFE_EVS_EventType_ERROR,
+                            "Error writing science file retention file %s record %d for %s",
+                            SciRetain->Filename, Idx, Record.File.Filename);
+      }
+
+   }
+
+} /* End WriteRecord() */
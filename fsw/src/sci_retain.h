@@ -0,0 +1,222 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the science file retention object
+**
+**  Notes:
+**    1. Closed science files are kept within a byte quota and a file count
+**       quota. Each closed file is added to an in-memory file table when
+**       it's added to the SCI_CATALOG so the file system is never scanned.
+**       Open files aren't retained files so they're never deleted.
+**    2. When a quota is exceeded files are deleted using the eviction
+**       policy. The oldest file is deleted first, the oldest downlinked
+**       file is deleted first, or the oldest file with the lowest priority
+**       is deleted first. A deleted file's catalog entry is removed.
+**    3. Eviction is performed by SCI_RETAIN_ManageFiles() which is called
+**       by the SCI_WRITER child tasks when their queues are empty. At most
+**       SCI_RETAIN_EVICT_LIM files are deleted per call so a large quota
+**       reduction is spread over several calls.
+**    4. Science filenames repeat when the image ID wraps or restarts.
+**       SCI_FILE gives a closed file a unique name so a retained file is
+**       never replaced and files are only deleted by eviction.
+**    5. The table is saved in the SCI_RETAIN_FILE retention file so every
+**       retained file is restored at startup, including files that have
+**       been dropped from the SCI_CATALOG. The retention file has a header
+**       followed by a fixed length record slot for each table entry. A
+**       slot is written whenever its entry changes and each slot has a
+**       CRC32C so a partially written slot is ignored at startup. If the
+**       retention file isn't valid the table is restored from the catalog
+**       along with each file's priority and downlinked flag.
+**    6. Files are added by the SCI_WRITER child tasks and commands are
+**       processed by the PL_MGR main task. The exported functions use a
+**       mutex to serialize access to the object's data.
+**    7. This object is a singleton owned by the payload object.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _sci_retain_
+#define _sci_retain_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+/*
+** Event Message IDs
+*/
+
+#define SCI_RETAIN_CONSTRUCTOR_EID   (SCI_RETAIN_BASE_EID + 0)
+#define SCI_RETAIN_EVICT_EID         (SCI_RETAIN_BASE_EID + 1)
+#define SCI_RETAIN_EVICT_ERR_EID     (SCI_RETAIN_BASE_EID + 2)
+#define SCI_RETAIN_CONFIG_CMD_EID    (SCI_RETAIN_BASE_EID + 3)
+#define SCI_RETAIN_SET_FILE_CMD_EID  (SCI_RETAIN_BASE_EID + 4)
+#define SCI_RETAIN_WRITE_ERR_EID     (SCI_RETAIN_BASE_EID + 5)
+
+/*
+** Retention file format definitions. See prologue notes.
+*/
+
+#define SCI_RETAIN_FILE_VERSION   1
+#define SCI_RETAIN_FILE_SYNC      0x504C534E  /* "PLSN" */
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+/*
+** A retained file. The table entry is unused if Seq is 0.
+*/
+
+typedef struct
+{
+
+   uint32  Seq;        /* SCI_CATALOG sequence number, orders files by age */
+   uint32  FileLen;
+   uint16  Priority;
+   bool    Downlinked;
+   char    Filename[OS_MAX_PATH_LEN];
+
+} SCI_RETAIN_File_t;
+
+typedef struct
+{
+
+   uint32  Sync;
+   uint16  Version;
+   uint16  RecordCnt;
+   uint32  RecordLen;
+
+} SCI_RETAIN_FileHeader_t;
+
+typedef struct
+{
+
+   SCI_RETAIN_File_t  File;
+   uint32             Crc;
+
+} SCI_RETAIN_FileRecord_t;
+
+
+/******************************************************************************
+** SCI_RETAIN_Class
+*/
+
+typedef struct
+{
+
+   osal_id_t  MutexId;
+
+   bool       FileOpen;
+   osal_id_t  FileHandle;
+   char       Filename[OS_MAX_PATH_LEN];
+   uint16     WriteErrCnt;
+
+   uint32  ByteQuota;   /* 0 is unlimited */
+   uint16  FileQuota;
+   uint16  Policy;
+
+   uint32  ByteCnt;
+   uint16  FileCnt;
+   uint16  EvictCnt;
+   uint16  EvictErrCnt;
+
+   SCI_RETAIN_File_t  File[SCI_RETAIN_FILE_MAX];
+
+} SCI_RETAIN_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+/******************************************************************************
+** Function: SCI_RETAIN_Constructor
+**
+** Initialize the retention object to a known state and restore the
+** retained files from the retention file or the catalog
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**   2. The SCI_CATALOG must be constructed prior to this call.
+**
+*/
+void SCI_RETAIN_Constructor(SCI_RETAIN_Class_t *SciRetainPtr, INITBL_Class_t *IniTbl);
+
+
+/******************************************************************************
+** Function: SCI_RETAIN_AddFile
+**
+** Retain a closed science file
+**
+** Notes:
+**   1. Entry is the file's catalog entry after it's been added to the
+**      catalog.
+**   2. If the file table is full a file is deleted in the caller's context.
+**
+*/
+void SCI_RETAIN_AddFile(const PL_MGR_CatalogEntry_t *Entry);
+
+
+/******************************************************************************
+** Function: SCI_RETAIN_ConfigCmd
+**
+** Set the retention quotas and eviction policy
+**
+** Notes:
+**  1. This function must comply with the CMDMGR_CmdFuncPtr definition
+**  2. Files are deleted by SCI_RETAIN_ManageFiles() if a new quota is
+**     exceeded.
+**
+*/
+bool SCI_RETAIN_ConfigCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: SCI_RETAIN_ManageFiles
+**
+** Delete files until the quotas are met or SCI_RETAIN_EVICT_LIM files have
+** been deleted
+**
+** Notes:
+**   1. This should be called when there's no detector data waiting to be
+**      written. See prologue notes.
+**
+*/
+void SCI_RETAIN_ManageFiles(void);
+
+
+/******************************************************************************
+** Function: SCI_RETAIN_SetFileCmd
+**
+** Set a retained file's priority and downlinked flag
+**
+** Notes:
+**  1. This function must comply with the CMDMGR_CmdFuncPtr definition
+**
+*/
+bool SCI_RETAIN_SetFileCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+#endif /* _sci_retain_ */
@@ -0,0 +1,233 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the science data region of interest utility
+**
+**  Notes:
+**    1. Binned pixels are rounded to the nearest integer average of the
+**       bin's pixel values. Bytes that aren't pixel values, such as a fault
+**       or the row's string terminator, aren't averaged. A bin without any
+**       pixel values keeps its first byte.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+
+#include "app_cfg.h"
+#include "sci_roi.h"
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static uint32 WindowEnd(uint16 First, uint16 Cnt, uint32 Len);
+
+
+/******************************************************************************
+** Function: SCI_ROI_CropRow
+**
+*/
+uint32 SCI_ROI_CropRow(const PL_MGR_SciRoi_t *Roi, const uint8 *Pixel, uint32 PixelCnt,
+                       uint8 *RoiPixel)
+{
+
+   uint32 RoiPixelCnt = 0;
+   uint32 ColEnd = WindowEnd(Roi->FirstCol, Roi->ColCnt, PixelCnt);
+   uint32 BinEnd;
+   uint32 BinSum;
+   uint32 BinCnt;
+   uint32 Value;
+   uint32 Col;
+   uint32 i;
+
+   if (Roi->ColStep == 1)
+   {
+      if (ColEnd > Roi->FirstCol)
+      {
+         RoiPixelCnt = ColEnd - Roi->FirstCol;
+         memcpy(RoiPixel, &Pixel[Roi->FirstCol], RoiPixelCnt);
+      }
+   }
+   else if (Roi->ColBin)
+   {
+      for (Col = Roi->FirstCol; Col < ColEnd; Col += Roi->ColStep)
+      {
+         BinEnd = (Col + Roi->ColStep < ColEnd) ? (Col + Roi->ColStep) : ColEnd;
+         BinSum = 0;
+         BinCnt = 0;
+         for (i = Col; i < BinEnd; i++)
+         {
+            Value = (uint8)(Pixel[i] - DETECTOR_PIXEL_ZERO);
+            if (Value <= DETECTOR_PIXEL_MAX)
+            {
+               BinSum += Value;
+               BinCnt++;
+            }
+         }
+         if (BinCnt > 0)
+         {
+            RoiPixel[RoiPixelCnt++] = (uint8)(DETECTOR_PIXEL_ZERO + (BinSum + BinCnt/2) / BinCnt);
+         }
+         else
+         {
+            RoiPixel[RoiPixelCnt++] = Pixel[Col];
+         }
+      }
+   }
+   else
+   {
+      for (Col = Roi->FirstCol; Col < ColEnd; Col += Roi->ColStep)
+      {
+         RoiPixel[RoiPixelCnt++] = Pixel[Col];
+      }
+   }
+
+   return RoiPixelCnt;
+
+} /* End SCI_ROI_CropRow() */
+
+
+/******************************************************************************
+** Function: SCI_ROI_CropLen
+**
+*/
+uint32 SCI_ROI_CropLen(const PL_MGR_SciRoi_t *Roi, uint32 PixelCnt)
+{
+
+   uint32 RoiPixelCnt = 0;
+   uint32 ColEnd = WindowEnd(Roi->FirstCol, Roi->ColCnt, PixelCnt);
+
+   if (ColEnd > Roi->FirstCol)
+   {
+      RoiPixelCnt = (ColEnd - Roi->FirstCol + Roi->ColStep - 1) / Roi->ColStep;
+   }
+
+   return RoiPixelCnt;
+
+} /* End SCI_ROI_CropLen() */
+
+
+/******************************************************************************
+** Function: SCI_ROI_Full
+**
+*/
+bool SCI_ROI_Full(const PL_MGR_SciRoi_t *Roi)
+{
+
+   return (SCI_ROI_FullRow(Roi) && Roi->FirstRow == 0 && Roi->RowCnt == 0 && Roi->RowStep == 1);
+
+} /* End SCI_ROI_Full() */
+
+
+/******************************************************************************
+** Function: SCI_ROI_FullRow
+**
+*/
+bool SCI_ROI_FullRow(const PL_MGR_SciRoi_t *Roi)
+{
+
+   return (Roi->FirstCol == 0 && Roi->ColCnt == 0 && Roi->ColStep == 1);
+
+} /* End SCI_ROI_FullRow() */
+
+
+/******************************************************************************
+** Function: SCI_ROI_SelectRow
+**
+*/
+bool SCI_ROI_SelectRow(const PL_MGR_SciRoi_t *Roi, uint16 RowIdx, bool *FirstRow, bool *LastRow)
+{
+
+   bool   RetStatus = false;
+   uint32 RowEnd = WindowEnd(Roi->FirstRow, Roi->RowCnt, PL_SIM_LIB_DETECTOR_ROWS_PER_IMAGE);
+   uint32 RowOffset;
+
+   *FirstRow = false;
+   *LastRow  = false;
+
+   if (RowIdx >= Roi->FirstRow && (RowIdx < RowEnd || Roi->RowCnt == 0))
+   {
+      RowOffset = RowIdx - Roi->FirstRow;
+      if ((RowOffset % Roi->RowStep) == 0)
+      {
+         *FirstRow = (RowOffset == 0);
+         *LastRow  = ((RowIdx + Roi->RowStep) >= RowEnd);
+         RetStatus = true;
+      }
+   }
+
+   return RetStatus;
+
+} /* End SCI_ROI_SelectRow() */
+
+
+/******************************************************************************
+** Function: SCI_ROI_SetFull
+**
+*/
+void SCI_ROI_SetFull(PL_MGR_SciRoi_t *Roi)
+{
+
+   memset(Roi, 0, sizeof(PL_MGR_SciRoi_t));
+   Roi->RowStep = 1;
+   Roi->ColStep = 1;
+
+} /* End SCI_ROI_SetFull() */
+
+
+/******************************************************************************
+** Function: SCI_ROI_Valid
+**
+*/
+bool SCI_ROI_Valid(const PL_MGR_SciRoi_t *Roi, uint32 RowLen)
+{
+
+   return (Roi->FirstRow < PL_SIM_LIB_DETECTOR_ROWS_PER_IMAGE && Roi->RowStep > 0 &&
+           Roi->FirstCol < RowLen && Roi->ColStep > 0);
+
+} /* End SCI_ROI_Valid() */
+
+
+/******************************************************************************
+** Function: WindowEnd
+**
+** Return the index that follows the last index of a window
+**
+** Notes:
+**   1. A count of zero or a window that extends beyond Len ends at Len.
+**
+*/
+static uint32 WindowEnd(uint16 First, uint16 Cnt, uint32 Len)
+{
+
+   uint32 End = Len;
+
+   if (Cnt > 0 && ((uint32)First + Cnt) < Len)
+   {
+      End = (uint32)First + Cnt;
+   }
+
+   return End;
+
+} /* End WindowEnd() */
@@ -0,0 +1,134 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the science data region of interest utility
+**
+**  Notes:
+**    1. A region of interest (ROI) selects the part of each image that's
+**       stored. Rows are selected from the window that starts at FirstRow
+**       and contains RowCnt rows and every RowStep'th row of the window is
+**       kept. A RowCnt of 0 extends the window to the image's last row.
+**    2. Columns are selected the same way with FirstCol, ColCnt and
+**       ColStep. When ColBin is true each stored pixel is the average of
+**       the ColStep pixels that it replaces instead of the first of them.
+**       The last bin of a row may contain fewer pixels. Pixels are decoded
+**       to their values before they're averaged and the average is stored
+**       using the detector's encoding, see app_cfg.h.
+**    3. Binning is limited to columns because rows are stored as they're
+**       read and a row can't be held for the rows that follow it.
+**    4. A full ROI stores every pixel of every row. It's the default and
+**       callers can skip cropping when SCI_ROI_FullRow() is true and skip
+**       recording the ROI when SCI_ROI_Full() is true.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _sci_roi_
+#define _sci_roi_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "pl_sim_lib.h"
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SCI_ROI_CropRow
+**
+** Copy a row's selected pixels to RoiPixel and return the number of pixels
+** copied
+**
+** Notes:
+**   1. PixelCnt is the row's length and RoiPixel must be at least that
+**      long.
+**
+*/
+uint32 SCI_ROI_CropRow(const PL_MGR_SciRoi_t *Roi, const uint8 *Pixel, uint32 PixelCnt,
+                       uint8 *RoiPixel);
+
+
+/******************************************************************************
+** Function: SCI_ROI_CropLen
+**
+** Return the number of pixels SCI_ROI_CropRow() copies from a row
+**
+*/
+uint32 SCI_ROI_CropLen(const PL_MGR_SciRoi_t *Roi, uint32 PixelCnt);
+
+
+/******************************************************************************
+** Function: SCI_ROI_Full
+**
+** Return true if the ROI keeps every pixel of every row
+**
+*/
+bool SCI_ROI_Full(const PL_MGR_SciRoi_t *Roi);
+
+
+/******************************************************************************
+** Function: SCI_ROI_FullRow
+**
+** Return true if the ROI keeps every pixel of the rows that it selects
+**
+*/
+bool SCI_ROI_FullRow(const PL_MGR_SciRoi_t *Roi);
+
+
+/******************************************************************************
+** Function: SCI_ROI_SelectRow
+**
+** Return true if a row is kept by the ROI
+**
+** Notes:
+**   1. FirstRow and LastRow are set to whether the row is the first or last
+**      row of an image that's kept. They're both true if the ROI keeps a
+**      single row.
+**   2. A window without a RowCnt also keeps rows beyond the image's last
+**      row so a full ROI keeps every row that's read.
+**
+*/
+bool SCI_ROI_SelectRow(const PL_MGR_SciRoi_t *Roi, uint16 RowIdx, bool *FirstRow, bool *LastRow);
+
+
+/******************************************************************************
+** Function: SCI_ROI_SetFull
+**
+** Set an ROI that keeps every pixel of every row
+**
+*/
+void SCI_ROI_SetFull(PL_MGR_SciRoi_t *Roi);
+
+
+/******************************************************************************
+** Function: SCI_ROI_Valid
+**
+** Notes:
+**   1. The first row and column must be within the image and the steps must
+**      be non-zero. Counts that extend beyond the image are limited to it.
+**
+*/
+bool SCI_ROI_Valid(const PL_MGR_SciRoi_t *Roi, uint32 RowLen);
+
+
+#endif /* _sci_roi_ */
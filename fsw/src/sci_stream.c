@@ -0,0 +1,343 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the science data stream object
+**
+**  Notes:
+**    1. A packet's size is set to the number of data bytes it contains
+**       before it's sent so partially filled packets don't send unused
+**       bytes.
+**    2. A software bus buffer that isn't transmitted must be released.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "app_cfg.h"
+#include "sci_stream.h"
+
+
+/**********************/
+/** Global File Data **/
+/**********************/
+
+static SCI_STREAM_Class_t *SciStream = NULL;
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static void SendPkt(void);
+static bool StartPkt(const PL_SIM_LIB_Detector_t *Detector);
+static bool ValidConfig(uint16 Channel, uint16 RowsPerPkt, uint16 Decimation);
+
+
+/******************************************************************************
+** Function: SCI_STREAM_Constructor
+**
+*/
+void SCI_STREAM_Constructor(SCI_STREAM_Class_t *SciStreamPtr, INITBL_Class_t *IniTbl, uint16 ChannelCnt)
+{
+
+   SciStream = SciStreamPtr;
+
+   CFE_PSP_MemSet((void*)SciStream, 0, sizeof(SCI_STREAM_Class_t));
+
+   SciStream->MsgId        = CFE_SB_ValueToMsgId(INITBL_GetIntConfig(IniTbl, CFG_PL_MGR_SCI_DATA_PKT_TOPICID));
+   SciStream->ChannelCnt   = ChannelCnt;
+   SciStream->Enabled      = (INITBL_GetIntConfig(IniTbl, CFG_SCI_STREAM_ENABLE) != 0);
+   SciStream->Channel      = INITBL_GetIntConfig(IniTbl, CFG_SCI_STREAM_CHANNEL);
+   SciStream->RowsPerPkt   = INITBL_GetIntConfig(IniTbl, CFG_SCI_STREAM_ROWS_PER_PKT);
+   SciStream->Decimation   = INITBL_GetIntConfig(IniTbl, CFG_SCI_STREAM_DECIMATION);
+   SciStream->CycleByteLim = INITBL_GetIntConfig(IniTbl, CFG_SCI_STREAM_CYCLE_BYTE_LIM);
+   
+   if (!ValidConfig(SciStream->Channel, SciStream->RowsPerPkt, SciStream->Decimation))
+   {
+      CFE_EVS_SendEvent (SCI_STREAM_CONFIG_CMD_EID, CFE_EVS_EventType_ERROR, 
+                         "Invalid science stream channel %d, rows per packet %d or decimation %d. Streaming disabled.",
+                         SciStream->Channel, SciStream->RowsPerPkt, SciStream->Decimation);
+      SciStream->Enabled    = false;
+      SciStream->Channel    = 0;
+      SciStream->RowsPerPkt = 1;
+      SciStream->Decimation = 1;
+   }
+   
+   if (OS_MutSemCreate(&SciStream->MutexId, "PL_MGR_SCI_STREAM", 0) != OS_SUCCESS)
+   {
+      CFE_EVS_SendEvent (SCI_STREAM_CONFIG_CMD_EID, CFE_EVS_EventType_ERROR, 
+                         "Science stream mutex creation failed");
+   }
+
+} /* End SCI_STREAM_Constructor() */
+
+
+/******************************************************************************
+** Function: SCI_STREAM_AddRow
+**
+** Notes:
+**   1. A packet is sent before the row is added if the row doesn't follow
+**      the packet's last row.
+**   2. A dropped row sends the packet so a packet's rows are always evenly
+**      spaced.
+**   3. Rows from channels other than the streamed channel are ignored.
+**
+*/
+void SCI_STREAM_AddRow(uint16 Channel, const PL_SIM_LIB_Detector_t *Detector, bool LastRow)
+{
+
+   PL_MGR_SciDataPkt_Payload_t *Payload;
+   
+   OS_MutSemTake(SciStream->MutexId);
+   
+   if (Channel == SciStream->Channel)
+   {
+
+      if (SciStream->Enabled && (Detector->ReadoutRow % SciStream->Decimation) == 0)
+      {
+      
+         if (SciStream->Pkt != NULL)
+         {
+            Payload = &SciStream->Pkt->Payload;
+            if (Payload->ImageId != Detector->ImageCnt ||
+                (Payload->FirstRowIdx + SciStream->PktRowCnt * Payload->RowStride) != Detector->ReadoutRow)
+            {
+               SendPkt();
+            }
+         }
+      
+         if (SciStream->CycleByteLim > 0 &&
+             (SciStream->CycleByteCnt + SCI_STREAM_ROW_LEN) > SciStream->CycleByteLim)
+         {
+            SciStream->BudgetDropCnt++;
+            SendPkt();
+         }
+         else if (SciStream->Pkt != NULL || StartPkt(Detector))
+         {
+         
+            memcpy(&SciStream->Pkt->Payload.Data[SciStream->PktRowCnt * SCI_STREAM_ROW_LEN],
+                   Detector->Row.Data, SCI_STREAM_ROW_LEN);
+            SciStream->PktRowCnt++;
+            SciStream->CycleByteCnt += SCI_STREAM_ROW_LEN;
+         
+            if (SciStream->PktRowCnt >= SciStream->PktRowLim)
+            {
+               SendPkt();
+            }
+         }
+      
+      } /* End if row streamed */
+   
+      if (LastRow)
+      {
+         SendPkt();
+      }
+
+   } /* End if streamed channel */
+   
+   OS_MutSemGive(SciStream->MutexId);
+   
+} /* End SCI_STREAM_AddRow() */
+
+
+/******************************************************************************
+** Function: SCI_STREAM_ConfigCmd
+**
+*/
+bool SCI_STREAM_ConfigCmd(void *DataObjPtr, const CFE_MSG_Message_t *MsgPtr)
+{
+
+   const PL_MGR_ConfigSciStream_Payload_t *ConfigCmd = CMDMGR_PAYLOAD_PTR(MsgPtr, PL_MGR_ConfigSciStream_t);
+   bool RetStatus = false;
+   
+   if (ValidConfig(ConfigCmd->Channel, ConfigCmd->RowsPerPkt, ConfigCmd->Decimation))
+   {
+      
+      OS_MutSemTake(SciStream->MutexId);
+      
+      SendPkt();
+      
+      SciStream->Enabled      = (ConfigCmd->Enabled == APP_C_FW_BooleanUint8_TRUE);
+      SciStream->Channel      = ConfigCmd->Channel;
+      SciStream->RowsPerPkt   = ConfigCmd->RowsPerPkt;
+      SciStream->Decimation   = ConfigCmd->Decimation;
+      SciStream->CycleByteLim = ConfigCmd->CycleByteLim;
+      
+      OS_MutSemGive(SciStream->MutexId);
+      
+      CFE_EVS_SendEvent (SCI_STREAM_CONFIG_CMD_EID, CFE_EVS_EventType_INFORMATION, 
+                         "Science stream %s for channel %d with %d rows per packet, decimation %d and a %d byte cycle limit",
+                         (SciStream->Enabled ? "enabled" : "disabled"), SciStream->Channel, SciStream->RowsPerPkt,
+                         SciStream->Decimation, SciStream->CycleByteLim);
+      RetStatus = true;
+   
+   }
+   else
+   {
+   
+      CFE_EVS_SendEvent (SCI_STREAM_CONFIG_CMD_EID, CFE_EVS_EventType_ERROR, 
+                         "Config science stream command rejected, channel %d must be less than %d, "
+                         "rows per packet %d must be between 1 and %d and decimation %d must be at least 1",
+                         ConfigCmd->Channel, SciStream->ChannelCnt, ConfigCmd->RowsPerPkt,
+                         (int)SCI_STREAM_MAX_ROWS_PER_PKT, ConfigCmd->Decimation);
+   }
+   
+   return RetStatus;
+   
+} /* End SCI_STREAM_ConfigCmd() */
+
+
+/******************************************************************************
+** Function: SCI_STREAM_EndCycle
+**
+*/
+void SCI_STREAM_EndCycle(void)
+{
+
+   OS_MutSemTake(SciStream->MutexId);
+   
+   SendPkt();
+   SciStream->CycleByteCnt = 0;
+   
+   OS_MutSemGive(SciStream->MutexId);
+
+} /* End SCI_STREAM_EndCycle() */
+
+
+/******************************************************************************
+** Function: SCI_STREAM_ResetStatus
+**
+*/
+void SCI_STREAM_ResetStatus(void)
+{
+
+   SciStream->PktCnt         = 0;
+   SciStream->BudgetDropCnt  = 0;
+   SciStream->TransmitErrCnt = 0;
+
+} /* End SCI_STREAM_ResetStatus() */
+
+
+/******************************************************************************
+** Function: SendPkt
+**
+** Send the packet being filled if there is one
+**
+*/
+static void SendPkt(void)
+{
+
+   int32 SysStatus;
+   
+   if (SciStream->Pkt != NULL)
+   {
+      
+      SciStream->Pkt->Payload.RowCnt = SciStream->PktRowCnt;
+      CFE_MSG_SetSize(&SciStream->SbBuf->Msg,
+                      offsetof(PL_MGR_SciDataPkt_t, Payload.Data) + SciStream->PktRowCnt * SCI_STREAM_ROW_LEN);
+      CFE_SB_TimeStampMsg(&SciStream->SbBuf->Msg);
+      
+      SysStatus = CFE_SB_TransmitBuffer(SciStream->SbBuf, true);
+      
+      if (SysStatus == CFE_SUCCESS)
+      {
+         SciStream->PktCnt++;
+      }
+      else
+      {
+         CFE_SB_ReleaseMessageBuffer(SciStream->SbBuf);
+         if (SciStream->TransmitErrCnt == 0)
+         {
+            CFE_EVS_SendEvent (SCI_STREAM_TRANSMIT_ERR_EID, CFE_EVS_EventType_ERROR, 
+                               "Science stream packet transmit failed, status 0x%08X", SysStatus);
+         }
+         SciStream->TransmitErrCnt++;
+      }
+      
+      SciStream->SbBuf = NULL;
+      SciStream->Pkt   = NULL;
+      SciStream->PktRowCnt = 0;
+   
+   }
+
+} /* End SendPkt() */
+
+
+/******************************************************************************
+** Function: StartPkt
+**
+** Allocate a software bus buffer and initialize a packet that starts with
+** the detector's row.
+**
+*/
+static bool StartPkt(const PL_SIM_LIB_Detector_t *Detector)
+{
+
+   PL_MGR_SciDataPkt_Payload_t *Payload;
+   
+   SciStream->SbBuf = CFE_SB_AllocateMessageBuffer(sizeof(PL_MGR_SciDataPkt_t));
+   
+   if (SciStream->SbBuf != NULL)
+   {
+      
+      CFE_MSG_Init(&SciStream->SbBuf->Msg, SciStream->MsgId, sizeof(PL_MGR_SciDataPkt_t));
+      SciStream->Pkt = (PL_MGR_SciDataPkt_t *)SciStream->SbBuf;
+      
+      Payload = &SciStream->Pkt->Payload;
+      Payload->ImageId     = Detector->ImageCnt;
+      Payload->Channel     = SciStream->Channel;
+      Payload->FirstRowIdx = Detector->ReadoutRow;
+      Payload->RowStride   = SciStream->Decimation;
+      Payload->RowCnt      = 0;
+      Payload->RowLen      = SCI_STREAM_ROW_LEN;
+      
+      SciStream->PktRowCnt = 0;
+      SciStream->PktRowLim = SciStream->RowsPerPkt;
+   
+   }
+   else
+   {
+      if (SciStream->TransmitErrCnt == 0)
+      {
+         CFE_EVS_SendEvent (SCI_STREAM_TRANSMIT_ERR_EID, CFE_EVS_EventType_ERROR, 
+                            "Science stream packet buffer allocation failed");
+      }
+      SciStream->TransmitErrCnt++;
+   }
+
+   return (SciStream->Pkt != NULL);
+   
+} /* End StartPkt() */
+
+
+/******************************************************************************
+** Function: ValidConfig
+**
+*/
+static bool ValidConfig(uint16 Channel, uint16 RowsPerPkt, uint16 Decimation)
+{
+
+   return (Channel < SciStream->ChannelCnt && RowsPerPkt >= 1 && RowsPerPkt <= SCI_STREAM_MAX_ROWS_PER_PKT && Decimation >= 1);
+   
+} /* End ValidConfig() */
@@ -0,0 +1,188 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the science data stream object
+**
+**  Notes:
+**    1. When enabled, detector rows are sent in SciDataPkt telemetry
+**       packets for quick-look displays. Streaming is independent of
+**       science file collection.
+**    2. A packet is built directly in a software bus buffer so a row is
+**       copied once, from the detector data into the packet, and the
+**       buffer is transmitted without another copy.
+**    3. Each packet holds up to RowsPerPkt rows of one image. A row is
+**       streamed if its readout row index is a multiple of the decimation
+**       factor so a packet's rows are RowStride apart.
+**    4. The rows streamed during an acquisition cycle are limited by a
+**       byte budget. Rows over the budget are dropped and counted. A
+**       partially filled packet is sent at the end of each acquisition
+**       cycle so a row's latency is never more than one cycle.
+**    5. Rows are streamed by the payload's acquisition child task and the
+**       configuration command is processed by the PL_MGR main task. The
+**       exported functions use a mutex to serialize access to the
+**       object's data.
+**    6. One detector channel is streamed at a time. The streamed channel
+**       is selected by the SCI_STREAM_CHANNEL init file parameter and the
+**       configuration command.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _sci_stream_
+#define _sci_stream_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "pl_sim_lib.h"  /* See prologue notes */
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+/*
+** Event Message IDs
+*/
+
+#define SCI_STREAM_CONFIG_CMD_EID   (SCI_STREAM_BASE_EID + 0)
+#define SCI_STREAM_TRANSMIT_ERR_EID (SCI_STREAM_BASE_EID + 1)
+
+#define SCI_STREAM_ROW_LEN         (sizeof(((PL_SIM_LIB_DetectorRow_t *)0)->Data))
+#define SCI_STREAM_MAX_ROWS_PER_PKT  (SCI_STREAM_MAX_DATA_LEN / SCI_STREAM_ROW_LEN)
+
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+
+/******************************************************************************
+** SCI_STREAM_Class
+*/
+
+typedef struct
+{
+
+   osal_id_t  MutexId;
+   CFE_SB_MsgId_t MsgId;
+   
+   /*
+   ** Configuration
+   */
+   
+   bool    Enabled;
+   uint16  ChannelCnt;
+   uint16  Channel;
+   uint16  RowsPerPkt;
+   uint16  Decimation;
+   uint32  CycleByteLim;
+   
+   /*
+   ** Status
+   */
+   
+   uint32  CycleByteCnt;
+   uint16  PktCnt;
+   uint16  BudgetDropCnt;
+   uint16  TransmitErrCnt;
+   
+   /*
+   ** Packet being filled
+   */
+   
+   CFE_SB_Buffer_t        *SbBuf;
+   PL_MGR_SciDataPkt_t    *Pkt;
+   uint16                  PktRowCnt;
+   uint16                  PktRowLim;
+
+} SCI_STREAM_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SCI_STREAM_Constructor
+**
+** Initialize the science data stream to a known state
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**
+*/
+void SCI_STREAM_Constructor(SCI_STREAM_Class_t *SciStreamPtr, INITBL_Class_t *IniTbl, uint16 ChannelCnt);
+
+
+/******************************************************************************
+** Function: SCI_STREAM_AddRow
+**
+** Add a detector row to the stream
+**
+** Notes:
+**   1. LastRow sends the packet because a packet only contains rows from
+**      one image.
+**   2. Called for every channel's rows. Only the streamed channel's rows
+**      are added.
+**
+*/
+void SCI_STREAM_AddRow(uint16 Channel, const PL_SIM_LIB_Detector_t *Detector, bool LastRow);
+
+
+/******************************************************************************
+** Function: SCI_STREAM_ConfigCmd
+**
+** Enable or disable streaming and set the stream parameters
+**
+** Notes:
+**  1. This function must comply with the CMDMGR_CmdFuncPtr definition
+**  2. A partially filled packet is sent before the new configuration is
+**     applied.
+**
+*/
+bool SCI_STREAM_ConfigCmd(void* DataObjPtr, const CFE_MSG_Message_t *MsgPtr);
+
+
+/******************************************************************************
+** Function: SCI_STREAM_EndCycle
+**
+** Send a partially filled packet and reset the cycle byte budget.
+**
+** Notes:
+**   1. Called at the end of each acquisition cycle.
+**
+*/
+void SCI_STREAM_EndCycle(void);
+
+
+/******************************************************************************
+** Function: SCI_STREAM_ResetStatus
+**
+** Reset counters and status flags to a known reset state.
+**
+** Notes:
+**   1. Any counter or variable that is reported in HK telemetry that doesn't
+**      change the functional behavior should be reset.
+**
+*/
+void SCI_STREAM_ResetStatus(void);
+
+
+#endif /* _sci_stream_ */
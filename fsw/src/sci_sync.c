@@ -0,0 +1,306 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the science file durability services
+**
+**  Notes:
+**    1. Sync descriptors are opened read-only because fsync() doesn't
+**       require write access on the platforms that provide it.
+**    2. A directory is synced by opening it read-only with O_DIRECTORY.
+**    3. truncate() is used so the file doesn't need to be opened.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include <string.h>
+
+#include "app_cfg.h"
+#include "sci_sync.h"
+
+#if (PL_MGR_SCI_FILE_FSYNC != 0)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+/******************************************************************************
+** Function: SCI_SYNC_Close
+**
+*/
+void SCI_SYNC_Close(int Fd)
+{
+
+   if (Fd != SCI_SYNC_NO_FD)
+   {
+      close(Fd);
+   }
+
+} /* End SCI_SYNC_Close() */
+
+
+/******************************************************************************
+** Function: SCI_SYNC_Descriptor
+**
+*/
+bool SCI_SYNC_Descriptor(int Fd)
+{
+
+   bool RetStatus = false;
+
+   if (fsync(Fd) == 0)
+   {
+      RetStatus = true;
+   }
+   else
+   {
+      CFE_EVS_SendEvent (SCI_SYNC_FILE_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "Science file sync failed, %s", strerror(errno));
+   }
+
+   return RetStatus;
+
+} /* End SCI_SYNC_Descriptor() */
+
+
+/******************************************************************************
+** Function: SCI_SYNC_Dir
+**
+*/
+bool SCI_SYNC_Dir(const char *Filename)
+{
+
+   bool  RetStatus = false;
+   char  LocalPath[OS_MAX_LOCAL_PATH_LEN];
+   char *Separator;
+   int   Fd;
+
+   if (OS_TranslatePath(Filename, LocalPath) == OS_SUCCESS)
+   {
+
+      Separator = strrchr(LocalPath, '/');
+      if (Separator == NULL)
+      {
+         strcpy(LocalPath, ".");
+      }
+      else if (Separator == LocalPath)
+      {
+         LocalPath[1] = '\0';
+      }
+      else
+      {
+         *Separator = '\0';
+      }
+
+      Fd = open(LocalPath, O_RDONLY | O_DIRECTORY);
+
+      if (Fd >= 0)
+      {
+
+         if (fsync(Fd) == 0)
+         {
+            RetStatus = true;
+         }
+         else
+         {
+            CFE_EVS_SendEvent (SCI_SYNC_DIR_ERR_EID, CFE_EVS_EventType_ERROR,
+                               "Science directory sync failed for %s, %s", LocalPath, strerror(errno));
+         }
+
+         close(Fd);
+      }
+      else
+      {
+         CFE_EVS_SendEvent (SCI_SYNC_DIR_ERR_EID, CFE_EVS_EventType_ERROR,
+                            "Science directory sync open failed for %s, %s", LocalPath, strerror(errno));
+      }
+   }
+   else
+   {
+      CFE_EVS_SendEvent (SCI_SYNC_DIR_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "Science directory sync failed, can't translate %s", Filename);
+   }
+
+   return RetStatus;
+
+} /* End SCI_SYNC_Dir() */
+
+
+/******************************************************************************
+** Function: SCI_SYNC_File
+**
+*/
+bool SCI_SYNC_File(const char *Filename)
+{
+
+   bool RetStatus = false;
+   int  Fd;
+
+   Fd = SCI_SYNC_Open(Filename);
+
+   if (Fd != SCI_SYNC_NO_FD)
+   {
+      RetStatus = SCI_SYNC_Descriptor(Fd);
+      SCI_SYNC_Close(Fd);
+   }
+
+   return RetStatus;
+
+} /* End SCI_SYNC_File() */
+
+
+/******************************************************************************
+** Function: SCI_SYNC_Open
+**
+*/
+int SCI_SYNC_Open(const char *Filename)
+{
+
+   char  LocalPath[OS_MAX_LOCAL_PATH_LEN];
+   int   Fd = SCI_SYNC_NO_FD;
+
+   if (OS_TranslatePath(Filename, LocalPath) == OS_SUCCESS)
+   {
+
+      Fd = open(LocalPath, O_RDONLY);
+
+      if (Fd < 0)
+      {
+         CFE_EVS_SendEvent (SCI_SYNC_FILE_ERR_EID, CFE_EVS_EventType_ERROR,
+                            "Science file sync open failed for %s, %s", LocalPath, strerror(errno));
+         Fd = SCI_SYNC_NO_FD;
+      }
+   }
+   else
+   {
+      CFE_EVS_SendEvent (SCI_SYNC_FILE_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "Science file sync failed, can't translate %s", Filename);
+   }
+
+   return Fd;
+
+} /* End SCI_SYNC_Open() */
+
+
+/******************************************************************************
+** Function: SCI_SYNC_Truncate
+**
+*/
+bool SCI_SYNC_Truncate(const char *Filename, uint32 Length)
+{
+
+   bool  RetStatus = false;
+   char  LocalPath[OS_MAX_LOCAL_PATH_LEN];
+
+   if (OS_TranslatePath(Filename, LocalPath) == OS_SUCCESS)
+   {
+
+      if (truncate(LocalPath, Length) == 0)
+      {
+         RetStatus = true;
+      }
+      else
+      {
+         CFE_EVS_SendEvent (SCI_SYNC_TRUNCATE_ERR_EID, CFE_EVS_EventType_ERROR,
+                            "Science file truncate to %d bytes failed for %s, %s",
+                            Length, LocalPath, strerror(errno));
+      }
+   }
+   else
+   {
+      CFE_EVS_SendEvent (SCI_SYNC_TRUNCATE_ERR_EID, CFE_EVS_EventType_ERROR,
+                         "Science file truncate failed, can't translate %s", Filename);
+   }
+
+   return RetStatus;
+
+} /* End SCI_SYNC_Truncate() */
+
+
+#else /* File sync not supported */
+
+
+/******************************************************************************
+** Functions: SCI_SYNC_Close, SCI_SYNC_Open
+**
+** Notes:
+**   1. A sync descriptor can't be opened so these have nothing to do.
+**
+*/
+void SCI_SYNC_Close(int Fd)
+{
+}
+
+int SCI_SYNC_Open(const char *Filename)
+{
+   return SCI_SYNC_NO_FD;
+}
+
+
+/******************************************************************************
+** Functions: SCI_SYNC_Descriptor, SCI_SYNC_Dir, SCI_SYNC_File
+**
+*/
+bool SCI_SYNC_Descriptor(int Fd)
+{
+
+   CFE_EVS_SendEvent (SCI_SYNC_FILE_ERR_EID, CFE_EVS_EventType_ERROR,
+                      "Science file syncs are not supported on this platform");
+
+   return false;
+
+} /* End SCI_SYNC_Descriptor() */
+
+bool SCI_SYNC_Dir(const char *Filename)
+{
+
+   CFE_EVS_SendEvent (SCI_SYNC_DIR_ERR_EID, CFE_EVS_EventType_ERROR,
+                      "Science directory syncs are not supported on this platform");
+
+   return false;
+
+} /* End SCI_SYNC_Dir() */
+
+bool SCI_SYNC_File(const char *Filename)
+{
+
+   return SCI_SYNC_Descriptor(SCI_SYNC_NO_FD);
+
+} /* End SCI_SYNC_File() */
+
+
+/******************************************************************************
+** Function: SCI_SYNC_Truncate
+**
+*/
+bool SCI_SYNC_Truncate(const char *Filename, uint32 Length)
+{
+
+   CFE_EVS_SendEvent (SCI_SYNC_TRUNCATE_ERR_EID, CFE_EVS_EventType_ERROR,
+                      "Science file truncation is not supported on this platform");
+
+   return false;
+
+} /* End SCI_SYNC_Truncate() */
+
+
+#endif /* PL_MGR_SCI_FILE_FSYNC */
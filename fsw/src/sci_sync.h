@@ -0,0 +1,149 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the science file durability services
+**
+**  Notes:
+**    1. OSAL doesn't provide a service that waits for a file's data to be
+**       written to storage or a way to get an OSAL file's native descriptor.
+**       An open file is synced through a native descriptor that's opened
+**       with SCI_SYNC_Open() when the file is opened and kept until it's
+**       closed so no path lookup is made for each sync. fsync() writes all
+**       of the file's modified data regardless of the descriptor used to
+**       write it. SCI_SYNC_File() is only used for files that aren't open.
+**    2. A rename isn't in storage until the directory that contains the
+**       file is synced with SCI_SYNC_Dir().
+**    3. OSAL also doesn't provide a service that shortens a file. A file
+**       that's resumed after a restart is truncated to the length that
+**       was checkpointed with SCI_SYNC_Truncate().
+**    4. This is only supported when PL_MGR_SCI_FILE_FSYNC is defined as
+**       non-zero in the platform configuration file. Otherwise the
+**       functions always fail and SCI_SYNC_Open() returns SCI_SYNC_NO_FD.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _sci_sync_
+#define _sci_sync_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+/*
+** Event Message IDs
+*/
+
+#define SCI_SYNC_FILE_ERR_EID      (SCI_SYNC_BASE_EID + 0)
+#define SCI_SYNC_TRUNCATE_ERR_EID  (SCI_SYNC_BASE_EID + 1)
+#define SCI_SYNC_DIR_ERR_EID       (SCI_SYNC_BASE_EID + 2)
+
+/*
+** Descriptor value when a file doesn't have a sync descriptor
+*/
+
+#define SCI_SYNC_NO_FD  (-1)
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+
+/******************************************************************************
+** Function: SCI_SYNC_Close
+**
+** Close a sync descriptor
+**
+** Notes:
+**   1. Nothing is done if Fd is SCI_SYNC_NO_FD.
+**
+*/
+void SCI_SYNC_Close(int Fd);
+
+
+/******************************************************************************
+** Function: SCI_SYNC_Descriptor
+**
+** Write an open file's modified data to storage using its sync descriptor
+** and wait for it to complete.
+**
+*/
+bool SCI_SYNC_Descriptor(int Fd);
+
+
+/******************************************************************************
+** Function: SCI_SYNC_Dir
+**
+** Write the directory entries of the directory that contains a file to
+** storage and wait for it to complete.
+**
+** Notes:
+**   1. Filename is an OSAL virtual path to the file, not the directory.
+**
+*/
+bool SCI_SYNC_Dir(const char *Filename);
+
+
+/******************************************************************************
+** Function: SCI_SYNC_File
+**
+** Write a closed file's modified data to storage and wait for it to complete.
+**
+** Notes:
+**   1. Filename is an OSAL virtual path.
+**   2. The file is opened by name so open files should be synced with
+**      SCI_SYNC_Descriptor().
+**
+*/
+bool SCI_SYNC_File(const char *Filename);
+
+
+/******************************************************************************
+** Function: SCI_SYNC_Open
+**
+** Open a sync descriptor for an open file and return it
+**
+** Notes:
+**   1. Filename is an OSAL virtual path.
+**   2. SCI_SYNC_NO_FD is returned if the descriptor can't be opened. Syncs
+**      using it fail.
+**
+*/
+int SCI_SYNC_Open(const char *Filename);
+
+
+/******************************************************************************
+** Function: SCI_SYNC_Truncate
+**
+** Discard a file's data after its first Length bytes.
+**
+** Notes:
+**   1. Filename is an OSAL virtual path.
+**   2. The file must not be open.
+**
+*/
+bool SCI_SYNC_Truncate(const char *Filename, uint32 Length);
+
+
+#endif /* _sci_sync_ */
@@ -0,0 +1,505 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Implement the science file writer object
+**
+**  Notes:
+**    1. The queue indices are free running counters. The number of queued
+**       entries is (Head - Tail) and an entry's location is the index
+**       masked by the queue length.
+**    2. The GCC atomic builtins provide the memory ordering between the
+**       producer's entry copy and its head update, and between the
+**       consumer's entry processing and its tail update. The request ring
+**       uses the same scheme.
+**    3. A request is added to the request ring before the session is
+**       advanced so an entry tagged with a session is always preceded by
+**       the session's request.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+
+/*
+** Include Files:
+*/
+
+#include "app_cfg.h"
+#include "sci_writer.h"
+#include "sci_retain.h"
+#include "perf_hist.h"
+
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+#define QUEUE_MASK    (SCI_WRITER_QUEUE_LEN - 1)
+#define REQUEST_MASK  (SCI_WRITER_REQUEST_QUEUE_LEN - 1)
+
+#define SHUTDOWN_RESERVE  1   /* Queue entries only used by a shutdown */
+
+#if ((SCI_WRITER_QUEUE_LEN & QUEUE_MASK) != 0)
+   #error SCI_WRITER_QUEUE_LEN must be a power of 2
+#endif
+
+#if ((SCI_WRITER_REQUEST_QUEUE_LEN & REQUEST_MASK) != 0)
+   #error SCI_WRITER_REQUEST_QUEUE_LEN must be a power of 2
+#endif
+
+
+/*******************************/
+/** Local Function Prototypes **/
+/*******************************/
+
+static SCI_WRITER_Entry_t *GetFreeEntry(SCI_WRITER_Class_t *SciWriter, uint32 Reserve);
+static void ProcessQueue(SCI_WRITER_Class_t *SciWriter);
+static void ProcessRequests(SCI_WRITER_Class_t *SciWriter, uint32 Session);
+static void PutEntry(SCI_WRITER_Class_t *SciWriter);
+
+
+/******************************************************************************
+** Function: SCI_WRITER_Constructor
+**
+*/
+void SCI_WRITER_Constructor(SCI_WRITER_Class_t *SciWriter, INITBL_Class_t *IniTbl,
+                            SCI_FILE_Class_t *SciFile, DETCTOR_MON_Class_t *DetectorMon,
+                            IMG_STATS_Class_t *ImgStats, uint16 Channel)
+{
+
+   int32 SysStatus;
+   char  SemName[OS_MAX_API_NAME];
+   CHILDMGR_TaskInit_t ChildTaskInit;
+
+   CFE_PSP_MemSet((void*)SciWriter, 0, sizeof(SCI_WRITER_Class_t));
+
+   SciWriter->SciFile     = SciFile;
+   SciWriter->DetectorMon = DetectorMon;
+   SciWriter->ImgStats    = ImgStats;
+   SciWriter->Channel     = Channel;
+   
+   if (Channel == 0)
+   {
+      snprintf(SciWriter->TaskName, OS_MAX_API_NAME, "%s", INITBL_GetStrConfig(IniTbl, CFG_SCI_WRITER_CHILD_NAME));
+   }
+   else
+   {
+      snprintf(SciWriter->TaskName, OS_MAX_API_NAME, "%s%d", INITBL_GetStrConfig(IniTbl, CFG_SCI_WRITER_CHILD_NAME), Channel);
+   }
+   snprintf(SemName, OS_MAX_API_NAME, "PL_MGR_SCIWAKE%d", Channel);
+   
+   SysStatus = OS_BinSemCreate(&SciWriter->WakeSemId, SemName, OS_SEM_EMPTY, 0);
+
+   if (SysStatus == OS_SUCCESS)
+   {
+
+      ChildTaskInit.TaskName  = SciWriter->TaskName;
+      ChildTaskInit.PerfId    = INITBL_GetIntConfig(IniTbl, CFG_SCI_WRITER_CHILD_PERF_ID);
+      ChildTaskInit.StackSize = INITBL_GetIntConfig(IniTbl, CFG_SCI_WRITER_CHILD_STACK_SIZE);
+      ChildTaskInit.Priority  = INITBL_GetIntConfig(IniTbl, CFG_SCI_WRITER_CHILD_PRIORITY);
+
+      SysStatus = CHILDMGR_Constructor(&SciWriter->ChildMgr, ChildMgr_TaskMainCallback,
+                                       SCI_WRITER_ChildTask, &ChildTaskInit);
+
+   }
+
+   if (SysStatus != CFE_SUCCESS)
+   {
+
+      CFE_EVS_SendEvent (SCI_WRITER_CONSTRUCTOR_EID, CFE_EVS_EventType_ERROR,
+                         "Science file writer %d child task initialization failed. Status = 0x%08X",
+                         Channel, SysStatus);
+   }
+
+} /* End SCI_WRITER_Constructor() */
+
+
+/******************************************************************************
+** Function: SCI_WRITER_ChildTask
+**
+** Notes:
+**   1. Returning false terminates the child task.
+**   2. A binary semaphore is used so multiple wakeups while the queue is
+**      being processed result in one more pass.
+**   3. ChildMgr is the first member of SCI_WRITER_Class_t so it's also a
+**      pointer to the writer instance that owns the task.
+**
+*/
+bool SCI_WRITER_ChildTask(CHILDMGR_Class_t *ChildMgr)
+{
+
+   SCI_WRITER_Class_t *SciWriter = (SCI_WRITER_Class_t *)ChildMgr;
+   bool RetStatus = false;
+
+   if (OS_BinSemTake(SciWriter->WakeSemId) == OS_SUCCESS)
+   {
+
+      ProcessQueue(SciWriter);
+      SCI_FILE_ManageFiles(SciWriter->SciFile);
+      SCI_RETAIN_ManageFiles();
+      RetStatus = true;
+
+   }
+
+   return RetStatus;
+
+} /* End SCI_WRITER_ChildTask() */
+
+
+/******************************************************************************
+** Function: SCI_WRITER_Enqueue
+**
+** Notes:
+**   1. A shutdown can't be dropped because it would leave a science file
+**      open. Rows can't use the reserved entries so a shutdown is only
+**      rejected when another shutdown is waiting. The caller retries it.
+**
+*/
+bool SCI_WRITER_Enqueue(SCI_WRITER_Class_t *SciWriter, const PL_SIM_LIB_Detector_t *Detector, SCI_FILE_Control_t Control,
+                        bool RowFault)
+{
+
+   bool   RetStatus = false;
+   SCI_WRITER_Entry_t *Entry = GetFreeEntry(SciWriter, (Control == SCI_FILE_SHUTDOWN) ? 0 : SHUTDOWN_RESERVE);
+
+   if (Entry != NULL)
+   {
+
+      Entry->Control  = Control;
+      Entry->RowFault = RowFault;
+      Entry->Detector = *Detector;
+      Entry->Image    = NULL;
+      PutEntry(SciWriter);
+
+      RetStatus = true;
+
+   }
+
+   return RetStatus;
+
+} /* End SCI_WRITER_Enqueue() */
+
+
+/******************************************************************************
+** Function: SCI_WRITER_EnqueueImage
+**
+*/
+bool SCI_WRITER_EnqueueImage(SCI_WRITER_Class_t *SciWriter, IMG_POOL_Image_t *Image)
+{
+
+   bool   RetStatus = false;
+   SCI_WRITER_Entry_t *Entry = GetFreeEntry(SciWriter, SHUTDOWN_RESERVE);
+
+   if (Entry != NULL)
+   {
+
+      Entry->Control = SCI_FILE_ROW;
+      Entry->Image   = Image;
+      PutEntry(SciWriter);
+
+      RetStatus = true;
+
+   }
+
+   return RetStatus;
+
+} /* End SCI_WRITER_EnqueueImage() */
+
+
+/******************************************************************************
+** Function: SCI_WRITER_Request
+**
+** Notes:
+**   1. See the file prologue for the order of the request and session
+**      updates.
+**
+*/
+bool SCI_WRITER_Request(SCI_WRITER_Class_t *SciWriter, SCI_WRITER_RequestType_t Type,
+                        const PL_MGR_ConfigSciFile_Payload_t *Config)
+{
+
+   bool   RetStatus = false;
+   uint32 Head    = SciWriter->RequestHead;
+   uint32 Session = SciWriter->Session;
+   SCI_WRITER_Request_t *Request;
+
+   if ((Head - __atomic_load_n(&SciWriter->RequestTail, __ATOMIC_ACQUIRE)) < SCI_WRITER_REQUEST_QUEUE_LEN)
+   {
+      
+      if (Type == SCI_WRITER_REQUEST_START || Type == SCI_WRITER_REQUEST_STOP)
+      {
+         Session++;
+      }
+      
+      Request = &SciWriter->Request[Head & REQUEST_MASK];
+      Request->Type    = Type;
+      Request->Session = Session;
+      if (Config != NULL)
+      {
+         Request->Config = *Config;
+      }
+      
+      __atomic_store_n(&SciWriter->RequestHead, Head + 1, __ATOMIC_RELEASE);
+      __atomic_store_n(&SciWriter->Session, Session, __ATOMIC_RELEASE);
+      OS_BinSemGive(SciWriter->WakeSemId);
+      
+      RetStatus = true;
+   
+   }
+   else
+   {
+      
+      CFE_EVS_SendEvent (SCI_WRITER_REQUEST_FULL_EID, CFE_EVS_EventType_ERROR,
+                         "Channel %d science file writer request queue full, %d requests are waiting",
+                         SciWriter->Channel, SCI_WRITER_REQUEST_QUEUE_LEN);
+   
+   }
+
+   return RetStatus;
+
+} /* End SCI_WRITER_Request() */
+
+
+/******************************************************************************
+** Function: SCI_WRITER_GetQueueCnt
+**
+*/
+uint16 SCI_WRITER_GetQueueCnt(SCI_WRITER_Class_t *SciWriter)
+{
+
+   return (uint16)(__atomic_load_n(&SciWriter->Head, __ATOMIC_ACQUIRE) -
+                   __atomic_load_n(&SciWriter->Tail, __ATOMIC_ACQUIRE));
+
+} /* End SCI_WRITER_GetQueueCnt() */
+
+
+/******************************************************************************
+** Function: SCI_WRITER_ResetStatus
+**
+*/
+void SCI_WRITER_ResetStatus(SCI_WRITER_Class_t *SciWriter)
+{
+
+   SciWriter->QueueHwm    = 0;
+   SciWriter->OverflowCnt = 0;
+
+} /* End SCI_WRITER_ResetStatus() */
+
+
+/******************************************************************************
+** Function: GetFreeEntry
+**
+** Return a pointer to the next free queue entry or NULL if the queue is full
+**
+** Notes:
+**   1. Only called by the producer. The entry is added to the queue by
+**      PutEntry().
+**   2. Reserve is the number of free entries that must be left for a
+**      shutdown.
+**   3. The entry is tagged with the current session. See prologue notes.
+**   4. An overflow event is only sent for the first overflow after a
+**      status reset.
+**
+*/
+static SCI_WRITER_Entry_t *GetFreeEntry(SCI_WRITER_Class_t *SciWriter, uint32 Reserve)
+{
+
+   SCI_WRITER_Entry_t *Entry = NULL;
+   uint32 Head = SciWriter->Head;
+   uint32 Tail = __atomic_load_n(&SciWriter->Tail, __ATOMIC_ACQUIRE);
+
+   if ((Head - Tail) < (SCI_WRITER_QUEUE_LEN - Reserve))
+   {
+
+      Entry = &SciWriter->Queue[Head & QUEUE_MASK];
+      Entry->Session = __atomic_load_n(&SciWriter->Session, __ATOMIC_ACQUIRE);
+
+   }
+   else
+   {
+
+      if (SciWriter->OverflowCnt == 0)
+      {
+         CFE_EVS_SendEvent (SCI_WRITER_QUEUE_FULL_EID, CFE_EVS_EventType_ERROR,
+                            "Science file writer queue full, detector data is being dropped");
+      }
+      SciWriter->OverflowCnt++;
+
+   }
+
+   return Entry;
+
+} /* End GetFreeEntry() */
+
+
+/******************************************************************************
+** Function: ProcessQueue
+**
+** Write the entries that are in the queue when the function is called
+**
+** Notes:
+**   1. Entries added while the queue is being processed are left for the
+**      next call so deferred file management runs between batches.
+**   2. Processing stops at an image that hasn't been processed by its
+**      worker. The worker wakes the child task when it's done.
+**   3. The requests that precede each entry's session are processed
+**      before the entry and an entry from an earlier session is discarded.
+**      An image is discarded after its worker is done with it. Requests
+**      that are still waiting are processed when the queue is empty. See
+**      prologue notes.
+**
+*/
+static void ProcessQueue(SCI_WRITER_Class_t *SciWriter)
+{
+
+   uint32 Head = __atomic_load_n(&SciWriter->Head, __ATOMIC_ACQUIRE);
+   uint32 Tail = SciWriter->Tail;
+   bool   ImagePending = false;
+   SCI_WRITER_Entry_t *Entry;
+   OS_time_t StageTime;
+
+   while (Tail != Head && !ImagePending)
+   {
+
+      Entry = &SciWriter->Queue[Tail & QUEUE_MASK];
+      
+      ProcessRequests(SciWriter, Entry->Session);
+      
+      if (Entry->Image == NULL)
+      {
+         if (Entry->Session == SciWriter->WriteSession)
+         {
+            PERF_HIST_Start(&StageTime);
+            SCI_FILE_WriteDetectorData(SciWriter->SciFile, &Entry->Detector, Entry->Control, Entry->RowFault);
+            PERF_HIST_Stop(PERF_HIST_WRITE_DATA, &StageTime);
+         }
+      }
+      else if (IMG_POOL_ImageDone(Entry->Image))
+      {
+         if (Entry->Session == SciWriter->WriteSession)
+         {
+            PERF_HIST_Start(&StageTime);
+            IMG_POOL_CommitImage(Entry->Image);
+            PERF_HIST_Stop(PERF_HIST_WRITE_DATA, &StageTime);
+         }
+         else
+         {
+            IMG_POOL_FreeImage(Entry->Image);
+         }
+      }
+      else
+      {
+         ImagePending = true;
+      }
+
+      if (!ImagePending)
+      {
+         Tail++;
+         __atomic_store_n(&SciWriter->Tail, Tail, __ATOMIC_RELEASE);
+      }
+
+   } /* End while queue not empty */
+
+   if (!ImagePending)
+   {
+      ProcessRequests(SciWriter, __atomic_load_n(&SciWriter->Session, __ATOMIC_ACQUIRE));
+   }
+   
+} /* End ProcessQueue() */
+
+
+/******************************************************************************
+** Function: ProcessRequests
+**
+** Perform the queued requests that precede an entry from Session
+**
+** Notes:
+**   1. Sessions are free running counters so they're compared using their
+**      difference.
+**
+*/
+static void ProcessRequests(SCI_WRITER_Class_t *SciWriter, uint32 Session)
+{
+
+   uint32 Head = __atomic_load_n(&SciWriter->RequestHead, __ATOMIC_ACQUIRE);
+   uint32 Tail = SciWriter->RequestTail;
+   SCI_WRITER_Request_t *Request;
+   char   EventStr[132];
+
+   while (Tail != Head && (int32)(SciWriter->Request[Tail & REQUEST_MASK].Session - Session) <= 0)
+   {
+
+      Request = &SciWriter->Request[Tail & REQUEST_MASK];
+      
+      switch (Request->Type)
+      {
+         case SCI_WRITER_REQUEST_START:
+            SCI_FILE_Start(SciWriter->SciFile);
+            break;
+         
+         case SCI_WRITER_REQUEST_STOP:
+            SCI_FILE_Stop(SciWriter->SciFile, EventStr, sizeof(EventStr));
+            CFE_EVS_SendEvent (SCI_WRITER_STOP_SCI_EID, CFE_EVS_EventType_INFORMATION, 
+                               "Channel %d: %s", SciWriter->Channel, EventStr);
+            break;
+         
+         case SCI_WRITER_REQUEST_CONFIG:
+            SCI_FILE_Config(SciWriter->SciFile, &Request->Config);
+            break;
+         
+         case SCI_WRITER_REQUEST_RESET:
+            SCI_FILE_ResetStatus(SciWriter->SciFile);
+            if (IMG_POOL_Enabled())
+            {
+               DETECTOR_MON_ResetStatus(SciWriter->DetectorMon);
+               IMG_STATS_ResetStatus(SciWriter->ImgStats);
+            }
+            break;
+      
+      } /* End request switch */
+      
+      SciWriter->WriteSession = Request->Session;
+      
+      Tail++;
+      __atomic_store_n(&SciWriter->RequestTail, Tail, __ATOMIC_RELEASE);
+
+   } /* End while requests */
+
+} /* End ProcessRequests() */
+
+
+/******************************************************************************
+** Function: PutEntry
+**
+** Add the entry returned by GetFreeEntry() to the queue and wake the child
+** task
+**
+*/
+static void PutEntry(SCI_WRITER_Class_t *SciWriter)
+{
+
+   uint32 Head = SciWriter->Head + 1;
+   uint32 QueueCnt = Head - __atomic_load_n(&SciWriter->Tail, __ATOMIC_ACQUIRE);
+
+   __atomic_store_n(&SciWriter->Head, Head, __ATOMIC_RELEASE);
+   OS_BinSemGive(SciWriter->WakeSemId);
+
+   if (QueueCnt > SciWriter->QueueHwm)
+   {
+      SciWriter->QueueHwm = QueueCnt;
+   }
+
+} /* End PutEntry() */
@@ -0,0 +1,262 @@
+/*
+**  Copyright 2022 bitValence, Inc.
+**  All Rights Reserved.
+**
+**  This program is free software; you can modify and/or redistribute it
+**  under the terms of the GNU Affero General Public License
+**  as published by the Free Software Foundation; version 3 with
+**  attribution addendums as found in the LICENSE.txt
+**
+**  This program is distributed in the hope that it will be useful,
+**  but WITHOUT ANY WARRANTY; without even the implied warranty of
+**  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+**  GNU Affero General Public License for more details.
+**
+**  Purpose:
+**    Define the science file writer object
+**
+**  Notes:
+**    1. The writer owns a child task that performs all of the science file
+**       creates, writes and closes so file system latencies don't delay
+**       the PL_MGR main task's command and telemetry processing.
+**    2. Detector rows are passed to the child task using a single-producer/
+**       single-consumer ring. The payload object's acquisition task is the
+**       only producer and the child task is the only consumer so no mutex
+**       is needed for the queue. The head index is only written by the
+**       producer and the tail index is only written by the consumer.
+**    3. If the queue is full the row is dropped and the overflow counter is
+**       incremented. The last queue entry is reserved for a shutdown so a
+**       shutdown is only rejected when a shutdown is already waiting, see
+**       SCI_WRITER_Enqueue().
+**    4. There is one writer and child task per detector channel so the
+**       channels' file writes and encoding can run concurrently. Each
+**       writer only writes to its channel's SCI_FILE instance.
+**    5. When the IMG_POOL worker pool is used the queue holds whole images
+**       in the order they were read. An image is committed when it reaches
+**       the front of the queue and its worker has finished so images are
+**       always written in order. The worker wakes the writer when it
+**       finishes an image.
+**    6. Deferred science file management and SCI_RETAIN file eviction are
+**       performed each time the child task empties its queue.
+**    7. Commands that start, stop, configure or reset the science file are
+**       passed from the PL_MGR main task to the child task using a second
+**       single-producer/single-consumer request ring so the main task never
+**       waits for file I/O. Start and stop requests begin a new collection
+**       session. Each queued entry is tagged with the session that was
+**       current when it was queued and a request is processed before the
+**       first entry that's tagged with its session. Entries from an earlier
+**       session are discarded so rows read before a stop are never written
+**       after the next start.
+**
+**  References:
+**    1. OpenSatKit Object-based Application Developer's Guide
+**    2. cFS Application Developer's Guide
+**
+*/
+#ifndef _sci_writer_
+#define _sci_writer_
+
+/*
+** Includes
+*/
+
+#include "app_cfg.h"
+#include "sci_file.h"
+#include "img_pool.h"
+
+/***********************/
+/** Macro Definitions **/
+/***********************/
+
+/*
+** Event Message IDs
+*/
+
+#define SCI_WRITER_CONSTRUCTOR_EID    (SCI_WRITER_BASE_EID + 0)
+#define SCI_WRITER_QUEUE_FULL_EID     (SCI_WRITER_BASE_EID + 1)
+#define SCI_WRITER_STOP_SCI_EID       (SCI_WRITER_BASE_EID + 2)
+#define SCI_WRITER_REQUEST_FULL_EID   (SCI_WRITER_BASE_EID + 3)
+
+/**********************/
+/** Type Definitions **/
+/**********************/
+
+typedef enum
+{
+
+   SCI_WRITER_REQUEST_START  = 1,
+   SCI_WRITER_REQUEST_STOP   = 2,
+   SCI_WRITER_REQUEST_CONFIG = 3,
+   SCI_WRITER_REQUEST_RESET  = 4
+
+} SCI_WRITER_RequestType_t;
+
+
+typedef struct
+{
+
+   SCI_FILE_Control_t     Control;
+   bool                   RowFault;
+   uint32                 Session;    /* See prologue notes */
+   PL_SIM_LIB_Detector_t  Detector;
+   IMG_POOL_Image_t      *Image;      /* Detector row entry if NULL */
+
+} SCI_WRITER_Entry_t;
+
+
+typedef struct
+{
+
+   SCI_WRITER_RequestType_t        Type;
+   uint32                          Session;
+   PL_MGR_ConfigSciFile_Payload_t  Config;    /* Only used by a config request */
+
+} SCI_WRITER_Request_t;
+
+
+/******************************************************************************
+** SCI_WRITER_Class
+*/
+
+typedef struct
+{
+
+   CHILDMGR_Class_t     ChildMgr;    /* Must be first, see SCI_WRITER_ChildTask() */
+   osal_id_t            WakeSemId;
+   SCI_FILE_Class_t     *SciFile;
+   DETCTOR_MON_Class_t  *DetectorMon;
+   IMG_STATS_Class_t    *ImgStats;
+   uint16               Channel;
+   char                 TaskName[OS_MAX_API_NAME];
+
+   uint32  Head;   /* Next entry to be written, only modified by the producer */
+   uint32  Tail;   /* Next entry to be read, only modified by the consumer    */
+
+   uint16  QueueHwm;
+   uint16  OverflowCnt;
+
+   SCI_WRITER_Entry_t Queue[SCI_WRITER_QUEUE_LEN];
+
+   /*
+   ** Collection requests. See prologue notes.
+   */
+   
+   uint32  Session;        /* Current session, only modified by the requester       */
+   uint32  WriteSession;   /* Session being written, only modified by the consumer  */
+   uint32  RequestHead;    /* Only modified by the requester */
+   uint32  RequestTail;    /* Only modified by the consumer  */
+
+   SCI_WRITER_Request_t Request[SCI_WRITER_REQUEST_QUEUE_LEN];
+
+} SCI_WRITER_Class_t;
+
+
+/************************/
+/** Exported Functions **/
+/************************/
+
+/******************************************************************************
+** Function: SCI_WRITER_Constructor
+**
+** Initialize the science file writer to a known state and start its child
+** task.
+**
+** Notes:
+**   1. This must be called prior to any other function.
+**   2. The SCI_FILE object must be constructed prior to this call because
+**      the child task may start running immediately.
+**   3. Channel 0's task uses the SCI_WRITER_CHILD_NAME init file parameter
+**      and other channels append the channel number to it.
+**   4. When IMG_POOL is enabled the writer commits the channel's images so
+**      a reset request also resets DetectorMon's and ImgStats' status.
+**
+*/
+void SCI_WRITER_Constructor(SCI_WRITER_Class_t *SciWriter, INITBL_Class_t *IniTbl,
+                            SCI_FILE_Class_t *SciFile, DETCTOR_MON_Class_t *DetectorMon,
+                            IMG_STATS_Class_t *ImgStats, uint16 Channel);
+
+
+/******************************************************************************
+** Function: SCI_WRITER_ChildTask
+**
+** Pend for queued detector data and write it to the science file.
+**
+** Notes:
+**   1. This function must comply with the CHILDMGR callback definition.
+**
+*/
+bool SCI_WRITER_ChildTask(CHILDMGR_Class_t *ChildMgr);
+
+
+/******************************************************************************
+** Function: SCI_WRITER_Enqueue
+**
+** Queue detector data to be written to the science file by the child task.
+**
+** Notes:
+**   1. Must only be called from one task. See prologue notes.
+**   2. Returns false if the queue was full and the data was dropped. A
+**      SCI_FILE_SHUTDOWN can use the queue's reserved entry so the caller
+**      only needs to retry it if a shutdown is already waiting.
+**   3. RowFault is passed to SCI_FILE_WriteDetectorData().
+**
+*/
+bool SCI_WRITER_Enqueue(SCI_WRITER_Class_t *SciWriter, const PL_SIM_LIB_Detector_t *Detector, SCI_FILE_Control_t Control,
+                        bool RowFault);
+
+
+/******************************************************************************
+** Function: SCI_WRITER_EnqueueImage
+**
+** Queue an image to be committed by the child task.
+**
+** Notes:
+**   1. Must only be called from the task that calls SCI_WRITER_Enqueue().
+**   2. The image can be queued before its worker finishes. See prologue
+**      notes.
+**   3. Returns false if the queue was full. The caller owns the image.
+**
+*/
+bool SCI_WRITER_EnqueueImage(SCI_WRITER_Class_t *SciWriter, IMG_POOL_Image_t *Image);
+
+
+/******************************************************************************
+** Function: SCI_WRITER_Request
+**
+** Queue a collection command to be performed by the child task.
+**
+** Notes:
+**   1. Must only be called from the PL_MGR main task. See prologue notes.
+**   2. Config is only used by a SCI_WRITER_REQUEST_CONFIG request and it
+**      must have been validated with SCI_FILE_ValidConfig().
+**   3. Returns false and sends an error event if the request queue is full.
+**   4. The stop result is reported in an event by the child task.
+**
+*/
+bool SCI_WRITER_Request(SCI_WRITER_Class_t *SciWriter, SCI_WRITER_RequestType_t Type,
+                        const PL_MGR_ConfigSciFile_Payload_t *Config);
+
+
+/******************************************************************************
+** Function: SCI_WRITER_GetQueueCnt
+**
+** Return the number of entries currently in the queue.
+**
+*/
+uint16 SCI_WRITER_GetQueueCnt(SCI_WRITER_Class_t *SciWriter);
+
+
+/******************************************************************************
+** Function: SCI_WRITER_ResetStatus
+**
+** Reset counters and status flags to a known reset state.
+**
+** Notes:
+**   1. Any counter or variable that is reported in HK telemetry that doesn't
+**      change the functional behavior should be reset.
+**
+*/
+void SCI_WRITER_ResetStatus(SCI_WRITER_Class_t *SciWriter);
+
+
+#endif /* _sci_writer_ */